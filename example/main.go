@@ -149,13 +149,12 @@ func main() {
 		jolt.Vec3{X: 10, Y: 0.5, Z: 10}, // half-extents (creates 20x1x20 box)
 	)
 	defer box.Destroy()
-	platform := bi.CreateBody(
+	bi.CreateBody(
 		box,
 		jolt.Vec3{X: 0, Y: 0, Z: 0}, // position
 		jolt.MotionTypeStatic,
 		false, // not a sensor
 	)
-	defer platform.Destroy()
 
 	// Create player character above the platform at Y=5 (will fall to ground)
 	// Create a capsule shape for the character (half-height 0.9m, radius 0.5m = ~1.8m tall human)
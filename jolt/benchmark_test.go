@@ -0,0 +1,336 @@
+package jolt
+
+import (
+	"math"
+	"math/rand"
+	"runtime"
+	"sync"
+	"testing"
+)
+
+// Standard scenes for the hot-path benchmarks. Run with
+//
+//	go test ./jolt -run '^$' -bench . -benchmem
+//
+// Besides ns/op and allocs/op every benchmark reports cgocalls/op, the number of Go -> C transitions per
+// operation, since the fixed cost of a cgo call dominates the cheap queries.
+
+const benchDeltaTime = 1.0 / 60.0
+
+var benchGravity = Vec3{X: 0, Y: -9.81, Z: 0}
+
+// reportCgoCalls reports the cgo calls per operation made since start (a runtime.NumCgoCall value)
+func reportCgoCalls(b *testing.B, start int64) {
+	b.ReportMetric(float64(runtime.NumCgoCall()-start)/float64(b.N), "cgocalls/op")
+}
+
+// newPileScene creates a 10k body pile: boxes in 25x25 columns of 16, a little apart so they fall and
+// settle onto each other. Sleeping is off so every update simulates the whole pile.
+func newPileScene(b *testing.B) *PhysicsSystem {
+	b.Helper()
+
+	const columns, layers = 25, 16
+
+	settings := NewPhysicsSystemSettings()
+	settings.MaxBodies = columns*columns*layers + 1
+	settings.MaxContactConstraints = 65536
+	settings.AllowSleeping = false
+	ps, err := NewPhysicsSystemWithSettings(settings)
+	if err != nil {
+		b.Fatal(err)
+	}
+	b.Cleanup(ps.Destroy)
+	bi := ps.GetBodyInterface()
+
+	floor := CreateBox(Vec3{X: 100, Y: 0.5, Z: 100})
+	defer floor.Destroy()
+	bi.CreateBody(floor, Vec3{X: 0, Y: -0.5, Z: 0}, MotionTypeStatic, false)
+
+	box := CreateBox(Vec3{X: 0.5, Y: 0.5, Z: 0.5})
+	defer box.Destroy()
+	bodies := make([]BodyCreationSettings, 0, columns*columns*layers)
+	for y := 0; y < layers; y++ {
+		for z := 0; z < columns; z++ {
+			for x := 0; x < columns; x++ {
+				position := Vec3{X: float32(x-columns/2) * 1.1, Y: 0.5 + float32(y)*1.05, Z: float32(z-columns/2) * 1.1}
+				bodies = append(bodies, NewBodyCreationSettings(box, position, MotionTypeDynamic))
+			}
+		}
+	}
+	bi.CreateBodies(bodies, true)
+	ps.OptimizeBroadPhase()
+
+	// Let the pile come into contact so the benchmark measures a loaded solver, not free fall
+	for i := 0; i < 30; i++ {
+		ps.Update(benchDeltaTime)
+	}
+	return ps
+}
+
+var (
+	sparseSceneOnce sync.Once
+	sparseScene     *PhysicsSystem
+	sparseSceneErr  error // Reported by every benchmark, since the scene is only built once
+)
+
+// getSparseScene returns a world with 50k small static boxes scattered over 1km x 1km and a ground plane.
+// Queries don't change it, so it is built once and shared by all query benchmarks.
+func getSparseScene(b *testing.B) *PhysicsSystem {
+	b.Helper()
+
+	sparseSceneOnce.Do(func() {
+		const numBodies = 50000
+
+		settings := NewPhysicsSystemSettings()
+		settings.MaxBodies = numBodies + 1
+		ps, err := NewPhysicsSystemWithSettings(settings)
+		if err != nil {
+			sparseSceneErr = err
+			return
+		}
+		bi := ps.GetBodyInterface()
+
+		ground := CreateBox(Vec3{X: 500, Y: 0.5, Z: 500})
+		defer ground.Destroy()
+		bi.CreateBody(ground, Vec3{X: 0, Y: -0.5, Z: 0}, MotionTypeStatic, false)
+
+		box := CreateBox(Vec3{X: 1, Y: 1, Z: 1})
+		defer box.Destroy()
+		rng := rand.New(rand.NewSource(1))
+		bodies := make([]BodyCreationSettings, numBodies)
+		for i := range bodies {
+			position := Vec3{X: rng.Float32()*1000 - 500, Y: 1 + rng.Float32()*20, Z: rng.Float32()*1000 - 500}
+			bodies[i] = NewBodyCreationSettings(box, position, MotionTypeStatic)
+		}
+		bi.CreateBodies(bodies, false)
+		ps.OptimizeBroadPhase()
+		sparseScene = ps
+	})
+	if sparseSceneErr != nil {
+		b.Fatal(sparseSceneErr)
+	}
+	return sparseScene
+}
+
+// benchRays returns n reproducible downward rays over the sparse scene, long enough to reach the ground
+func benchRays(n int) (origins, directions []Vec3) {
+	rng := rand.New(rand.NewSource(2))
+	origins = make([]Vec3, n)
+	directions = make([]Vec3, n)
+	for i := range origins {
+		origins[i] = Vec3{X: rng.Float32()*1000 - 500, Y: 50, Z: rng.Float32()*1000 - 500}
+		directions[i] = Vec3{X: rng.Float32()*20 - 10, Y: -60, Z: rng.Float32()*20 - 10}
+	}
+	return origins, directions
+}
+
+// newTerrainMesh creates a 200m x 200m rolling terrain mesh with 1m cells
+func newTerrainMesh() *Shape {
+	const cells = 200
+
+	vertices := make([]Vec3, 0, (cells+1)*(cells+1))
+	for z := 0; z <= cells; z++ {
+		for x := 0; x <= cells; x++ {
+			height := 2*math.Sin(float64(x)*0.1) + 1.5*math.Cos(float64(z)*0.13)
+			vertices = append(vertices, Vec3{X: float32(x - cells/2), Y: float32(height), Z: float32(z - cells/2)})
+		}
+	}
+
+	indices := make([]int32, 0, cells*cells*6)
+	for z := 0; z < cells; z++ {
+		for x := 0; x < cells; x++ {
+			i := int32(z*(cells+1) + x)
+			next := i + cells + 1
+			indices = append(indices, i, next, i+1, i+1, next, next+1)
+		}
+	}
+	return CreateMesh(vertices, indices)
+}
+
+// newCharacterScene creates 500 characters spread over a terrain mesh and returns the world, the group
+// and the walk velocity of each character
+func newCharacterScene(b *testing.B) (*PhysicsSystem, *CharacterGroup, []Vec3) {
+	b.Helper()
+
+	const numCharacters = 500
+
+	ps := NewPhysicsSystem()
+	terrain := newTerrainMesh()
+	ps.GetBodyInterface().CreateBody(terrain, Vec3{}, MotionTypeStatic, false)
+	terrain.Destroy()
+
+	capsule := CreateCapsule(0.5, 0.3)
+	settings := NewCharacterVirtualSettings(capsule)
+	settings.ShapeOffset = Vec3{X: 0, Y: 0.8, Z: 0}
+
+	group := ps.CreateCharacterGroup()
+	velocities := make([]Vec3, numCharacters)
+	for i := range velocities {
+		// 25x20 grid with 6m spacing, each character walking in its own direction
+		angle := float64(i) * 2.39996
+		group.CreateCharacter(settings, Vec3{X: float32(i%25)*6 - 75, Y: 5, Z: float32(i/25)*6 - 60})
+		velocities[i] = Vec3{X: float32(3 * math.Cos(angle)), Y: 0, Z: float32(3 * math.Sin(angle))}
+	}
+
+	b.Cleanup(func() {
+		group.Destroy()
+		capsule.Destroy()
+		ps.Destroy()
+	})
+
+	// Drop everyone onto the terrain first
+	states := make([]CharacterState, numCharacters)
+	desired := make([]Vec3, numCharacters)
+	for i := 0; i < 60; i++ {
+		walkVelocities(desired, velocities, states)
+		group.ExtendedUpdate(benchDeltaTime, benchGravity, desired, states)
+	}
+	return ps, group, velocities
+}
+
+// walkVelocities sets dst to the walk velocities plus gravity applied to the vertical velocity of the last update
+func walkVelocities(dst, walk []Vec3, states []CharacterState) {
+	for i := range dst {
+		dst[i] = Vec3{X: walk[i].X, Y: states[i].Velocity.Y + benchGravity.Y*benchDeltaTime, Z: walk[i].Z}
+	}
+}
+
+func BenchmarkUpdatePile10k(b *testing.B) {
+	ps := newPileScene(b)
+
+	b.ReportAllocs()
+	b.ResetTimer()
+	start := runtime.NumCgoCall()
+	for i := 0; i < b.N; i++ {
+		ps.Update(benchDeltaTime)
+	}
+	reportCgoCalls(b, start)
+}
+
+func BenchmarkCastRaySparse50k(b *testing.B) {
+	ps := getSparseScene(b)
+	origins, directions := benchRays(1024)
+
+	b.ReportAllocs()
+	b.ResetTimer()
+	start := runtime.NumCgoCall()
+	for i := 0; i < b.N; i++ {
+		j := i % len(origins)
+		ps.CastRay(origins[j], directions[j])
+	}
+	reportCgoCalls(b, start)
+}
+
+func BenchmarkCastRayBatchSparse50k(b *testing.B) {
+	ps := getSparseScene(b)
+	origins, directions := benchRays(1024)
+	out := make([]RaycastHit, len(origins))
+
+	// One op is one ray, to compare with BenchmarkCastRaySparse50k
+	b.ReportAllocs()
+	b.ResetTimer()
+	start := runtime.NumCgoCall()
+	for i := 0; i < b.N; i += len(origins) {
+		n := min(len(origins), b.N-i)
+		ps.CastRayBatch(origins[:n], directions[:n], out[:n])
+	}
+	reportCgoCalls(b, start)
+}
+
+func BenchmarkCastRayGetHitsSparse50k(b *testing.B) {
+	ps := getSparseScene(b)
+	origins, directions := benchRays(1024)
+
+	b.ReportAllocs()
+	b.ResetTimer()
+	start := runtime.NumCgoCall()
+	for i := 0; i < b.N; i++ {
+		j := i % len(origins)
+		ps.CastRayGetHits(origins[j], directions[j], 16)
+	}
+	reportCgoCalls(b, start)
+}
+
+func BenchmarkCastRayGetHitsIntoSparse50k(b *testing.B) {
+	ps := getSparseScene(b)
+	origins, directions := benchRays(1024)
+	hits := make([]RaycastHit, 16)
+
+	b.ReportAllocs()
+	b.ResetTimer()
+	start := runtime.NumCgoCall()
+	for i := 0; i < b.N; i++ {
+		j := i % len(origins)
+		ps.CastRayGetHitsInto(origins[j], directions[j], hits)
+	}
+	reportCgoCalls(b, start)
+}
+
+func BenchmarkCollideShapeGetHitsSparse50k(b *testing.B) {
+	ps := getSparseScene(b)
+	origins, _ := benchRays(1024)
+	sphere := CreateSphere(5)
+	defer sphere.Destroy()
+
+	b.ReportAllocs()
+	b.ResetTimer()
+	start := runtime.NumCgoCall()
+	for i := 0; i < b.N; i++ {
+		position := origins[i%len(origins)]
+		position.Y = 5
+		ps.CollideShapeGetHits(sphere, position, 16, 0)
+	}
+	reportCgoCalls(b, start)
+}
+
+func BenchmarkCollideShapeGetHitsIntoSparse50k(b *testing.B) {
+	ps := getSparseScene(b)
+	origins, _ := benchRays(1024)
+	sphere := CreateSphere(5)
+	defer sphere.Destroy()
+	hits := make([]CollisionHit, 16)
+
+	b.ReportAllocs()
+	b.ResetTimer()
+	start := runtime.NumCgoCall()
+	for i := 0; i < b.N; i++ {
+		position := origins[i%len(origins)]
+		position.Y = 5
+		ps.CollideShapeGetHitsInto(sphere, position, hits, 0)
+	}
+	reportCgoCalls(b, start)
+}
+
+// One op is one tick of all 500 characters, each with its own call
+func BenchmarkCharacterExtendedUpdate500(b *testing.B) {
+	_, group, velocities := newCharacterScene(b)
+	characters := group.Characters()
+
+	b.ReportAllocs()
+	b.ResetTimer()
+	start := runtime.NumCgoCall()
+	for i := 0; i < b.N; i++ {
+		for j, cv := range characters {
+			v := cv.GetLinearVelocity()
+			cv.SetLinearVelocity(Vec3{X: velocities[j].X, Y: v.Y + benchGravity.Y*benchDeltaTime, Z: velocities[j].Z})
+			cv.ExtendedUpdate(benchDeltaTime, benchGravity)
+		}
+	}
+	reportCgoCalls(b, start)
+}
+
+// One op is one tick of all 500 characters through CharacterGroup, to compare with BenchmarkCharacterExtendedUpdate500
+func BenchmarkCharacterGroupExtendedUpdate500(b *testing.B) {
+	_, group, walk := newCharacterScene(b)
+	velocities := make([]Vec3, group.Len())
+	results := make([]CharacterState, group.Len())
+
+	b.ReportAllocs()
+	b.ResetTimer()
+	start := runtime.NumCgoCall()
+	for i := 0; i < b.N; i++ {
+		walkVelocities(velocities, walk, results)
+		group.ExtendedUpdate(benchDeltaTime, benchGravity, velocities, results)
+	}
+	reportCgoCalls(b, start)
+}
@@ -2,6 +2,7 @@ package jolt
 
 // #include "wrapper/body.h"
 import "C"
+import "unsafe"
 
 // MotionType determines how a body responds to forces
 type MotionType int
@@ -23,28 +24,47 @@ func (ps *PhysicsSystem) GetBodyInterface() *BodyInterface {
 	return &BodyInterface{handle: handle}
 }
 
-// BodyID uniquely identifies a physics body
-type BodyID struct {
-	handle C.JoltBodyID
+// BodyID uniquely identifies a physics body.
+// It is a plain value (Jolt's packed index and sequence number) and can be copied and compared freely.
+type BodyID uint32
+
+// InvalidBodyID is the BodyID returned when no body is referenced (e.g. a raycast miss)
+const InvalidBodyID BodyID = C.JOLT_INVALID_BODY_ID
+
+// IsInvalid returns true if the ID doesn't refer to a body
+func (b BodyID) IsInvalid() bool {
+	return b == InvalidBodyID
+}
+
+// Index returns the index of the body in the body manager
+func (b BodyID) Index() uint32 {
+	return uint32(b) & 0x007fffff
 }
 
-// Destroy frees the body ID
-func (b *BodyID) Destroy() {
-	C.JoltDestroyBodyID(b.handle)
+// SequenceNumber returns the sequence number used to detect reuse of a body index
+func (b BodyID) SequenceNumber() uint8 {
+	return uint8(uint32(b) >> 24)
 }
 
+// Destroy is a no-op kept for compatibility: body IDs used to be heap-allocated handles.
+//
+// Deprecated: BodyID is a value type and needs no cleanup.
+func (b BodyID) Destroy() {}
+
 // GetPosition returns the current position of a body
-func (bi *BodyInterface) GetPosition(bodyID *BodyID) Vec3 {
-	var x, y, z C.float
-	C.JoltGetBodyPosition(bi.handle, bodyID.handle, &x, &y, &z)
-	return Vec3{
-		X: float32(x),
-		Y: float32(y),
-		Z: float32(z),
-	}
+func (bi *BodyInterface) GetPosition(bodyID BodyID) Vec3 {
+	return bi.GetPosition64(bodyID).Vec3()
+}
+
+// GetPosition64 returns the current position of a body in double precision (see RVec3)
+func (bi *BodyInterface) GetPosition64(bodyID BodyID) RVec3 {
+	var x, y, z C.double
+	C.JoltGetBodyPosition(bi.handle, C.JoltBodyID(bodyID), &x, &y, &z)
+	return RVec3{X: float64(x), Y: float64(y), Z: float64(z)}
 }
 
 // CreateBody creates a body with specific motion type and sensor flag.
+// Returns InvalidBodyID if the body could not be created (e.g. the body limit was reached).
 //
 // Parameters:
 //   - shape: The collision shape
@@ -67,7 +87,7 @@ func (bi *BodyInterface) GetPosition(bodyID *BodyID) Vec3 {
 //	capsule := jolt.CreateCapsule(0.5, 1.8)
 //	sensor := bi.CreateBody(capsule, jolt.Vec3{X: 0, Y: 1, Z: 0}, jolt.MotionTypeKinematic, true)
 //	bi.ActivateBody(sensor)
-func (bi *BodyInterface) CreateBody(shape *Shape, position Vec3, motionType MotionType, isSensor bool) *BodyID {
+func (bi *BodyInterface) CreateBody(shape *Shape, position Vec3, motionType MotionType, isSensor bool) BodyID {
 	sensor := C.int(0)
 	if isSensor {
 		sensor = C.int(1)
@@ -76,35 +96,516 @@ func (bi *BodyInterface) CreateBody(shape *Shape, position Vec3, motionType Moti
 	handle := C.JoltCreateBody(
 		bi.handle,
 		shape.handle,
-		C.float(position.X),
-		C.float(position.Y),
-		C.float(position.Z),
+		C.double(position.X),
+		C.double(position.Y),
+		C.double(position.Z),
 		C.JoltMotionType(motionType),
 		sensor,
+		cObjectLayer(ObjectLayerFromMotionType),
+	)
+
+	return BodyID(handle)
+}
+
+// CreateBodyInLayer is like CreateBody but puts the body in the given object layer instead of the
+// default layer for its motion type. Returns InvalidBodyID if the body could not be created.
+// Bodies in layers outside the world's layer table collide with nothing.
+//
+// Example usage:
+//
+//	// Debris only collides with the level, not with players or other debris
+//	chunk := bi.CreateBodyInLayer(box, pos, jolt.MotionTypeDynamic, false, LayerDebris)
+//	bi.ActivateBody(chunk)
+func (bi *BodyInterface) CreateBodyInLayer(shape *Shape, position Vec3, motionType MotionType, isSensor bool, layer ObjectLayer) BodyID {
+	return bi.CreateBody64(shape, position.RVec3(), motionType, isSensor, layer)
+}
+
+// CreateBody64 is CreateBodyInLayer with a double-precision position (see RVec3).
+// Returns InvalidBodyID if the body could not be created.
+//
+// Example usage:
+//
+//	// A station 40km from the origin, built with -tags jolt_double
+//	station := bi.CreateBody64(hull, jolt.RVec3{X: 40000, Y: 0, Z: 12000}, jolt.MotionTypeStatic, false, jolt.ObjectLayerFromMotionType)
+func (bi *BodyInterface) CreateBody64(shape *Shape, position RVec3, motionType MotionType, isSensor bool, layer ObjectLayer) BodyID {
+	handle := C.JoltCreateBody(
+		bi.handle,
+		shape.handle,
+		C.double(position.X),
+		C.double(position.Y),
+		C.double(position.Z),
+		C.JoltMotionType(motionType),
+		C.int(boolToInt(isSensor)),
+		cObjectLayer(layer),
 	)
 
-	return &BodyID{handle: handle}
+	return BodyID(handle)
+}
+
+// BodyCreationSettings describes one body for CreateBodies
+type BodyCreationSettings struct {
+	Shape      *Shape     // The collision shape
+	Position   Vec3       // Initial position
+	Position64 RVec3      // Initial position in double precision, used instead of Position when non-zero
+	Rotation   Quat       // Initial rotation (the zero value is treated as identity)
+	MotionType MotionType // MotionTypeStatic, MotionTypeKinematic, or MotionTypeDynamic
+	IsSensor   bool       // If true, body is detected by queries but doesn't generate contact forces
+
+	// ObjectLayer is the collision layer of the body. The zero value picks the default layer for the motion
+	// type like ObjectLayerFromMotionType, so hand-built settings behave like NewBodyCreationSettings; set
+	// HasObjectLayer to put a body in layer 0 itself.
+	ObjectLayer ObjectLayer
+
+	// HasObjectLayer makes a zero ObjectLayer mean layer 0 instead of the default layer for the motion type
+	HasObjectLayer bool
+}
+
+// objectLayer returns the layer to create the body in, resolving the zero value
+func (s *BodyCreationSettings) objectLayer() ObjectLayer {
+	if s.ObjectLayer == 0 && !s.HasObjectLayer {
+		return ObjectLayerFromMotionType
+	}
+	return s.ObjectLayer
+}
+
+// NewBodyCreationSettings returns settings for a body with identity rotation that is not a sensor,
+// in the default object layer for its motion type.
+// It returns a value rather than a pointer so it can be appended straight to a slice for CreateBodies.
+func NewBodyCreationSettings(shape *Shape, position Vec3, motionType MotionType) BodyCreationSettings {
+	return BodyCreationSettings{
+		Shape:       shape,
+		Position:    position,
+		Rotation:    QuatIdentity(),
+		MotionType:  motionType,
+		ObjectLayer: ObjectLayerFromMotionType,
+	}
+}
+
+// NewBodyCreationSettings64 is NewBodyCreationSettings with a double-precision position (see RVec3)
+func NewBodyCreationSettings64(shape *Shape, position RVec3, motionType MotionType) BodyCreationSettings {
+	settings := NewBodyCreationSettings(shape, Vec3{}, motionType)
+	settings.Position64 = position
+	return settings
+}
+
+// cBodyCreationSettings converts body settings for the wrapper
+func cBodyCreationSettings(settings []BodyCreationSettings) []C.JoltBodyCreationSettings {
+	cSettings := make([]C.JoltBodyCreationSettings, len(settings))
+	for i := range settings {
+		s := &settings[i]
+		rot := s.Rotation
+		if rot == (Quat{}) {
+			rot = QuatIdentity()
+		}
+		pos := s.Position64
+		if pos == (RVec3{}) {
+			pos = s.Position.RVec3()
+		}
+		cSettings[i] = C.JoltBodyCreationSettings{
+			shape:       s.Shape.handle,
+			positionX:   C.double(pos.X),
+			positionY:   C.double(pos.Y),
+			positionZ:   C.double(pos.Z),
+			rotationX:   C.float(rot.X),
+			rotationY:   C.float(rot.Y),
+			rotationZ:   C.float(rot.Z),
+			rotationW:   C.float(rot.W),
+			motionType:  C.JoltMotionType(s.MotionType),
+			isSensor:    C.int(boolToInt(s.IsSensor)),
+			objectLayer: cObjectLayer(s.objectLayer()),
+		}
+	}
+	return cSettings
+}
+
+// CreateBodies creates many bodies and adds them to the physics system as a single batch.
+// The broadphase is updated once for the whole batch instead of once per body, which makes loading
+// large levels much faster and leaves the broadphase tree better balanced. Call
+// PhysicsSystem.OptimizeBroadPhase afterwards when loading a full level.
+//
+// Parameters:
+//   - settings: One entry per body to create
+//   - activate: If true, the kinematic and dynamic bodies start active
+//
+// Returns the IDs of the new bodies in the same order as settings
+// (InvalidBodyID for bodies that could not be created, e.g. because the body limit was reached).
+//
+// Example usage:
+//
+//	box := jolt.CreateBox(jolt.Vec3{X: 0.5, Y: 0.5, Z: 0.5})
+//	settings := make([]jolt.BodyCreationSettings, 0, len(props))
+//	for _, p := range props {
+//	    settings = append(settings, jolt.NewBodyCreationSettings(box, p.Position, jolt.MotionTypeStatic))
+//	}
+//	ids := bi.CreateBodies(settings, false)
+//	ps.OptimizeBroadPhase()
+func (bi *BodyInterface) CreateBodies(settings []BodyCreationSettings, activate bool) []BodyID {
+	if len(settings) == 0 {
+		return []BodyID{}
+	}
+
+	cSettings := cBodyCreationSettings(settings)
+
+	ids := make([]BodyID, len(settings))
+	C.JoltCreateBodies(
+		bi.handle,
+		&cSettings[0],
+		C.int(len(cSettings)),
+		(*C.JoltBodyID)(unsafe.Pointer(&ids[0])),
+		C.int(boolToInt(activate)),
+	)
+
+	return ids
+}
+
+// RemoveBodies removes many bodies from the physics system in one call.
+// The bodies are not destroyed and can be added again; use DestroyBodies to free them.
+func (bi *BodyInterface) RemoveBodies(ids []BodyID) {
+	if len(ids) == 0 {
+		return
+	}
+	C.JoltRemoveBodies(bi.handle, (*C.JoltBodyID)(unsafe.Pointer(&ids[0])), C.int(len(ids)))
+}
+
+// DestroyBodies frees many bodies in one call. The bodies must have been removed with RemoveBodies first.
+// The IDs must not be used afterwards.
+//
+// Example usage:
+//
+//	bi.RemoveBodies(levelBodies)
+//	bi.DestroyBodies(levelBodies)
+func (bi *BodyInterface) DestroyBodies(ids []BodyID) {
+	if len(ids) == 0 {
+		return
+	}
+	C.JoltDestroyBodies(bi.handle, (*C.JoltBodyID)(unsafe.Pointer(&ids[0])), C.int(len(ids)))
 }
 
 // SetPosition updates the position of a body
-func (bi *BodyInterface) SetPosition(bodyID *BodyID, position Vec3) {
+func (bi *BodyInterface) SetPosition(bodyID BodyID, position Vec3) {
+	bi.SetPosition64(bodyID, position.RVec3())
+}
+
+// SetPosition64 updates the position of a body in double precision (see RVec3)
+func (bi *BodyInterface) SetPosition64(bodyID BodyID, position RVec3) {
 	C.JoltSetBodyPosition(
 		bi.handle,
-		bodyID.handle,
-		C.float(position.X),
-		C.float(position.Y),
-		C.float(position.Z),
+		C.JoltBodyID(bodyID),
+		C.double(position.X),
+		C.double(position.Y),
+		C.double(position.Z),
+	)
+}
+
+// GetRotation returns the current rotation of a body
+func (bi *BodyInterface) GetRotation(bodyID BodyID) Quat {
+	var x, y, z, w C.float
+	C.JoltGetBodyRotation(bi.handle, C.JoltBodyID(bodyID), &x, &y, &z, &w)
+	return Quat{X: float32(x), Y: float32(y), Z: float32(z), W: float32(w)}
+}
+
+// SetRotation changes the rotation of a body. The zero Quat is treated as identity.
+// If activate is true the body is woken up.
+func (bi *BodyInterface) SetRotation(bodyID BodyID, rotation Quat, activate bool) {
+	C.JoltSetBodyRotation(
+		bi.handle,
+		C.JoltBodyID(bodyID),
+		C.float(rotation.X),
+		C.float(rotation.Y),
+		C.float(rotation.Z),
+		C.float(rotation.W),
+		C.int(boolToInt(activate)),
+	)
+}
+
+// SetPositionAndRotation teleports a body to a new transform. The zero Quat is treated as identity.
+// If activate is true the body is woken up.
+//
+// Teleporting does not give the body a velocity, so dynamic bodies it is moved into are pushed out rather than
+// carried along. Use MoveKinematic for kinematic bodies that are animated every frame.
+func (bi *BodyInterface) SetPositionAndRotation(bodyID BodyID, position Vec3, rotation Quat, activate bool) {
+	bi.SetPositionAndRotation64(bodyID, position.RVec3(), rotation, activate)
+}
+
+// SetPositionAndRotation64 is SetPositionAndRotation with a double-precision position (see RVec3)
+func (bi *BodyInterface) SetPositionAndRotation64(bodyID BodyID, position RVec3, rotation Quat, activate bool) {
+	C.JoltSetBodyPositionAndRotation(
+		bi.handle,
+		C.JoltBodyID(bodyID),
+		C.double(position.X),
+		C.double(position.Y),
+		C.double(position.Z),
+		C.float(rotation.X),
+		C.float(rotation.Y),
+		C.float(rotation.Z),
+		C.float(rotation.W),
+		C.int(boolToInt(activate)),
+	)
+}
+
+// SetPositionAndRotationWhenChanged is like SetPositionAndRotation, but leaves the body alone (and asleep) if
+// the transform didn't change. Use it when syncing transforms from game state that mostly stands still.
+func (bi *BodyInterface) SetPositionAndRotationWhenChanged(bodyID BodyID, position Vec3, rotation Quat, activate bool) {
+	bi.SetPositionAndRotationWhenChanged64(bodyID, position.RVec3(), rotation, activate)
+}
+
+// SetPositionAndRotationWhenChanged64 is SetPositionAndRotationWhenChanged with a double-precision position
+func (bi *BodyInterface) SetPositionAndRotationWhenChanged64(bodyID BodyID, position RVec3, rotation Quat, activate bool) {
+	C.JoltSetBodyPositionAndRotationWhenChanged(
+		bi.handle,
+		C.JoltBodyID(bodyID),
+		C.double(position.X),
+		C.double(position.Y),
+		C.double(position.Z),
+		C.float(rotation.X),
+		C.float(rotation.Y),
+		C.float(rotation.Z),
+		C.float(rotation.W),
+		C.int(boolToInt(activate)),
 	)
 }
 
+// MoveKinematic moves a kinematic body so it reaches the target transform after deltaTime seconds.
+// Jolt gives the body the velocity needed to get there, so dynamic bodies riding on or pushed by it react
+// correctly and contact caching keeps working, unlike teleporting with SetPositionAndRotation.
+// The body is woken up if needed. The zero Quat is treated as identity.
+//
+// Parameters:
+//   - bodyID: A kinematic body
+//   - targetPosition, targetRotation: Where the body should be at the end of the next update
+//   - deltaTime: The time step of the next Update call
+//
+// Example usage:
+//
+//	// Elevator following an animation curve
+//	bi.MoveKinematic(elevator, path.Sample(t+dt), jolt.QuatIdentity(), dt)
+//	ps.Update(dt)
+func (bi *BodyInterface) MoveKinematic(bodyID BodyID, targetPosition Vec3, targetRotation Quat, deltaTime float32) {
+	bi.MoveKinematic64(bodyID, targetPosition.RVec3(), targetRotation, deltaTime)
+}
+
+// MoveKinematic64 is MoveKinematic with a double-precision target position (see RVec3)
+func (bi *BodyInterface) MoveKinematic64(bodyID BodyID, targetPosition RVec3, targetRotation Quat, deltaTime float32) {
+	C.JoltMoveKinematic(
+		bi.handle,
+		C.JoltBodyID(bodyID),
+		C.double(targetPosition.X),
+		C.double(targetPosition.Y),
+		C.double(targetPosition.Z),
+		C.float(targetRotation.X),
+		C.float(targetRotation.Y),
+		C.float(targetRotation.Z),
+		C.float(targetRotation.W),
+		C.float(deltaTime),
+	)
+}
+
+// GetLinearVelocity returns the linear velocity of a body in m/s
+func (bi *BodyInterface) GetLinearVelocity(bodyID BodyID) Vec3 {
+	var x, y, z C.float
+	C.JoltGetBodyLinearVelocity(bi.handle, C.JoltBodyID(bodyID), &x, &y, &z)
+	return Vec3{X: float32(x), Y: float32(y), Z: float32(z)}
+}
+
+// SetLinearVelocity sets the linear velocity of a body in m/s (ignored for static bodies).
+// A non-zero velocity wakes the body.
+func (bi *BodyInterface) SetLinearVelocity(bodyID BodyID, velocity Vec3) {
+	C.JoltSetBodyLinearVelocity(bi.handle, C.JoltBodyID(bodyID), C.float(velocity.X), C.float(velocity.Y), C.float(velocity.Z))
+}
+
+// GetAngularVelocity returns the angular velocity of a body in rad/s
+func (bi *BodyInterface) GetAngularVelocity(bodyID BodyID) Vec3 {
+	var x, y, z C.float
+	C.JoltGetBodyAngularVelocity(bi.handle, C.JoltBodyID(bodyID), &x, &y, &z)
+	return Vec3{X: float32(x), Y: float32(y), Z: float32(z)}
+}
+
+// SetAngularVelocity sets the angular velocity of a body in rad/s (ignored for static bodies).
+// A non-zero velocity wakes the body.
+func (bi *BodyInterface) SetAngularVelocity(bodyID BodyID, velocity Vec3) {
+	C.JoltSetBodyAngularVelocity(bi.handle, C.JoltBodyID(bodyID), C.float(velocity.X), C.float(velocity.Y), C.float(velocity.Z))
+}
+
+// AddForce adds a force in Newtons at the center of mass of a dynamic body. Forces are accumulated and applied
+// during the next Update, then cleared. The body is woken up.
+func (bi *BodyInterface) AddForce(bodyID BodyID, force Vec3) {
+	C.JoltAddBodyForce(bi.handle, C.JoltBodyID(bodyID), C.float(force.X), C.float(force.Y), C.float(force.Z))
+}
+
+// AddImpulse applies an impulse in kg m/s at the center of mass of a dynamic body, changing its velocity
+// immediately (e.g. an explosion or a jump pad). The body is woken up.
+func (bi *BodyInterface) AddImpulse(bodyID BodyID, impulse Vec3) {
+	C.JoltAddBodyImpulse(bi.handle, C.JoltBodyID(bodyID), C.float(impulse.X), C.float(impulse.Y), C.float(impulse.Z))
+}
+
+// SetPositionsAndRotations teleports many bodies in a single call: body ids[i] is moved to positions[i] and
+// rotations[i]. Pass nil rotations to only set the positions. Extra entries in the longer slices are ignored.
+// If activate is true the bodies are woken up.
+func (bi *BodyInterface) SetPositionsAndRotations(ids []BodyID, positions []Vec3, rotations []Quat, activate bool) {
+	bi.setTransforms(ids, positions, rotations, activate, false)
+}
+
+// SetPositionsAndRotationsWhenChanged is the batched form of SetPositionAndRotationWhenChanged: bodies whose
+// transform didn't change are left alone, so syncing a mostly idle set of bodies doesn't wake them all.
+func (bi *BodyInterface) SetPositionsAndRotationsWhenChanged(ids []BodyID, positions []Vec3, rotations []Quat, activate bool) {
+	bi.setTransforms(ids, positions, rotations, activate, true)
+}
+
+func (bi *BodyInterface) setTransforms(ids []BodyID, positions []Vec3, rotations []Quat, activate, onlyWhenChanged bool) {
+	n := min(len(ids), len(positions))
+	if rotations != nil {
+		n = min(n, len(rotations))
+	}
+	if n == 0 {
+		return
+	}
+
+	var cRotations *C.float
+	if rotations != nil {
+		cRotations = (*C.float)(unsafe.Pointer(&rotations[0]))
+	}
+
+	C.JoltSetBodyTransforms(
+		bi.handle,
+		(*C.JoltBodyID)(unsafe.Pointer(&ids[0])),
+		C.int(n),
+		(*C.float)(unsafe.Pointer(&positions[0])),
+		cRotations,
+		C.int(boolToInt(activate)),
+		C.int(boolToInt(onlyWhenChanged)),
+	)
+}
+
+// MoveKinematicBodies is the batched form of MoveKinematic: every kinematic target of a tick is applied in one
+// call. Body ids[i] moves towards positions[i] and rotations[i]; extra entries in the longer slices are ignored.
+//
+// Example usage:
+//
+//	// Reused every tick
+//	for i, door := range doors {
+//	    targets[i], rotations[i] = door.Transform(t + dt)
+//	}
+//	bi.MoveKinematicBodies(doorIDs, targets, rotations, dt)
+//	ps.Update(dt)
+func (bi *BodyInterface) MoveKinematicBodies(ids []BodyID, positions []Vec3, rotations []Quat, deltaTime float32) {
+	n := min(len(ids), len(positions), len(rotations))
+	if n == 0 {
+		return
+	}
+
+	C.JoltMoveKinematicBodies(
+		bi.handle,
+		(*C.JoltBodyID)(unsafe.Pointer(&ids[0])),
+		C.int(n),
+		(*C.float)(unsafe.Pointer(&positions[0])),
+		(*C.float)(unsafe.Pointer(&rotations[0])),
+		C.float(deltaTime),
+	)
+}
+
+// SetPositionsAndRotations64 is SetPositionsAndRotations with double-precision positions (see RVec3)
+func (bi *BodyInterface) SetPositionsAndRotations64(ids []BodyID, positions []RVec3, rotations []Quat, activate bool) {
+	bi.setTransforms64(ids, positions, rotations, activate, false)
+}
+
+// SetPositionsAndRotationsWhenChanged64 is SetPositionsAndRotationsWhenChanged with double-precision positions
+// (see RVec3)
+func (bi *BodyInterface) SetPositionsAndRotationsWhenChanged64(ids []BodyID, positions []RVec3, rotations []Quat, activate bool) {
+	bi.setTransforms64(ids, positions, rotations, activate, true)
+}
+
+func (bi *BodyInterface) setTransforms64(ids []BodyID, positions []RVec3, rotations []Quat, activate, onlyWhenChanged bool) {
+	n := min(len(ids), len(positions))
+	if rotations != nil {
+		n = min(n, len(rotations))
+	}
+	if n == 0 {
+		return
+	}
+
+	var cRotations *C.float
+	if rotations != nil {
+		cRotations = (*C.float)(unsafe.Pointer(&rotations[0]))
+	}
+
+	C.JoltSetBodyTransforms64(
+		bi.handle,
+		(*C.JoltBodyID)(unsafe.Pointer(&ids[0])),
+		C.int(n),
+		(*C.double)(unsafe.Pointer(&positions[0])),
+		cRotations,
+		C.int(boolToInt(activate)),
+		C.int(boolToInt(onlyWhenChanged)),
+	)
+}
+
+// MoveKinematicBodies64 is MoveKinematicBodies with double-precision target positions (see RVec3)
+func (bi *BodyInterface) MoveKinematicBodies64(ids []BodyID, positions []RVec3, rotations []Quat, deltaTime float32) {
+	n := min(len(ids), len(positions), len(rotations))
+	if n == 0 {
+		return
+	}
+
+	C.JoltMoveKinematicBodies64(
+		bi.handle,
+		(*C.JoltBodyID)(unsafe.Pointer(&ids[0])),
+		C.int(n),
+		(*C.double)(unsafe.Pointer(&positions[0])),
+		(*C.float)(unsafe.Pointer(&rotations[0])),
+		C.float(deltaTime),
+	)
+}
+
+// SetVelocities sets the velocities of many bodies in one call. Either slice may be nil to leave that velocity
+// unchanged; extra entries in the longer slices are ignored.
+func (bi *BodyInterface) SetVelocities(ids []BodyID, linearVelocities, angularVelocities []Vec3) {
+	n := len(ids)
+	var cLinear, cAngular *C.float
+	if linearVelocities != nil {
+		n = min(n, len(linearVelocities))
+	}
+	if angularVelocities != nil {
+		n = min(n, len(angularVelocities))
+	}
+	if n == 0 || (linearVelocities == nil && angularVelocities == nil) {
+		return
+	}
+	if linearVelocities != nil {
+		cLinear = (*C.float)(unsafe.Pointer(&linearVelocities[0]))
+	}
+	if angularVelocities != nil {
+		cAngular = (*C.float)(unsafe.Pointer(&angularVelocities[0]))
+	}
+
+	C.JoltSetBodyVelocities(bi.handle, (*C.JoltBodyID)(unsafe.Pointer(&ids[0])), C.int(n), cLinear, cAngular)
+}
+
+// AddForces adds forces[i] to body ids[i] for many bodies in one call (see AddForce)
+func (bi *BodyInterface) AddForces(ids []BodyID, forces []Vec3) {
+	n := min(len(ids), len(forces))
+	if n == 0 {
+		return
+	}
+	C.JoltAddBodyForces(bi.handle, (*C.JoltBodyID)(unsafe.Pointer(&ids[0])), C.int(n), (*C.float)(unsafe.Pointer(&forces[0])))
+}
+
+// AddImpulses applies impulses[i] to body ids[i] for many bodies in one call (see AddImpulse)
+func (bi *BodyInterface) AddImpulses(ids []BodyID, impulses []Vec3) {
+	n := min(len(ids), len(impulses))
+	if n == 0 {
+		return
+	}
+	C.JoltAddBodyImpulses(bi.handle, (*C.JoltBodyID)(unsafe.Pointer(&ids[0])), C.int(n), (*C.float)(unsafe.Pointer(&impulses[0])))
+}
+
 // ActivateBody makes a body participate in the simulation
-func (bi *BodyInterface) ActivateBody(bodyID *BodyID) {
-	C.JoltActivateBody(bi.handle, bodyID.handle)
+func (bi *BodyInterface) ActivateBody(bodyID BodyID) {
+	C.JoltActivateBody(bi.handle, C.JoltBodyID(bodyID))
 }
 
 // DeactivateBody removes a body from active simulation
-func (bi *BodyInterface) DeactivateBody(bodyID *BodyID) {
-	C.JoltDeactivateBody(bi.handle, bodyID.handle)
+func (bi *BodyInterface) DeactivateBody(bodyID BodyID) {
+	C.JoltDeactivateBody(bi.handle, C.JoltBodyID(bodyID))
 }
 
 // SetShape changes the collision shape of a body
@@ -115,10 +616,178 @@ func (bi *BodyInterface) DeactivateBody(bodyID *BodyID) {
 //   - updateMassProperties: If true, recalculates mass/inertia from the new shape
 //
 // Note: This automatically activates the body
-func (bi *BodyInterface) SetShape(bodyID *BodyID, shape *Shape, updateMassProperties bool) {
+func (bi *BodyInterface) SetShape(bodyID BodyID, shape *Shape, updateMassProperties bool) {
 	update := C.int(0)
 	if updateMassProperties {
 		update = C.int(1)
 	}
-	C.JoltSetBodyShape(bi.handle, bodyID.handle, shape.handle, update)
+	C.JoltSetBodyShape(bi.handle, C.JoltBodyID(bodyID), shape.handle, update)
+}
+
+// BodyStateBuffer holds the state of many bodies as parallel arrays: entry i of each slice belongs to IDs[i].
+// The buffer is meant to be reused across frames; its slices are resized in place and only reallocated
+// when they need to grow.
+type BodyStateBuffer struct {
+	IDs               []BodyID
+	Positions         []Vec3
+	Rotations         []Quat
+	LinearVelocities  []Vec3
+	AngularVelocities []Vec3
+}
+
+// Vec3 and Quat slices are passed to the wrapper as packed float arrays
+var (
+	_ [unsafe.Sizeof(Vec3{}) - 3*unsafe.Sizeof(float32(0))]struct{}
+	_ [3*unsafe.Sizeof(float32(0)) - unsafe.Sizeof(Vec3{})]struct{}
+	_ [unsafe.Sizeof(Quat{}) - 4*unsafe.Sizeof(float32(0))]struct{}
+	_ [4*unsafe.Sizeof(float32(0)) - unsafe.Sizeof(Quat{})]struct{}
+
+	// RVec3 slices are passed as packed double arrays
+	_ [unsafe.Sizeof(RVec3{}) - 3*unsafe.Sizeof(float64(0))]struct{}
+	_ [3*unsafe.Sizeof(float64(0)) - unsafe.Sizeof(RVec3{})]struct{}
+)
+
+// NewBodyStateBuffer creates a buffer with room for capacity bodies
+func NewBodyStateBuffer(capacity int) *BodyStateBuffer {
+	return &BodyStateBuffer{
+		IDs:               make([]BodyID, 0, capacity),
+		Positions:         make([]Vec3, 0, capacity),
+		Rotations:         make([]Quat, 0, capacity),
+		LinearVelocities:  make([]Vec3, 0, capacity),
+		AngularVelocities: make([]Vec3, 0, capacity),
+	}
+}
+
+// Len returns the number of bodies in the buffer
+func (b *BodyStateBuffer) Len() int {
+	return len(b.IDs)
+}
+
+// resize sets the length of all slices to n, reallocating only the ones that are too small
+func (b *BodyStateBuffer) resize(n int) {
+	b.IDs = resizeSlice(b.IDs, n)
+	b.Positions = resizeSlice(b.Positions, n)
+	b.Rotations = resizeSlice(b.Rotations, n)
+	b.LinearVelocities = resizeSlice(b.LinearVelocities, n)
+	b.AngularVelocities = resizeSlice(b.AngularVelocities, n)
+}
+
+// minCap is the number of bodies all slices can hold without reallocating
+func (b *BodyStateBuffer) minCap() int {
+	return min(cap(b.IDs), cap(b.Positions), cap(b.Rotations), cap(b.LinearVelocities), cap(b.AngularVelocities))
+}
+
+func resizeSlice[T any](s []T, n int) []T {
+	if cap(s) < n {
+		return make([]T, n)
+	}
+	return s[:n]
+}
+
+// ReadBodyStates reads the position, rotation and velocities of many bodies in a single call.
+// All bodies are read under one lock pass, which is much cheaper than calling GetPosition per body.
+//
+// Parameters:
+//   - ids: The bodies to read
+//   - dst: Buffer receiving the state; it is resized to len(ids) and dst.IDs is set to a copy of ids
+//
+// Bodies that no longer exist read as zero position/velocity and identity rotation.
+// Returns the number of bodies that were found.
+//
+// Example usage:
+//
+//	states := jolt.NewBodyStateBuffer(len(ids)) // allocated once
+//	for {
+//	    ps.Update(1.0 / 60.0)
+//	    ps.ReadBodyStates(ids, states)
+//	    for i, id := range states.IDs {
+//	        replicate(id, states.Positions[i], states.Rotations[i])
+//	    }
+//	}
+func (ps *PhysicsSystem) ReadBodyStates(ids []BodyID, dst *BodyStateBuffer) int {
+	dst.resize(len(ids))
+	if len(ids) == 0 {
+		return 0
+	}
+	copy(dst.IDs, ids)
+
+	numFound := C.JoltReadBodyStates(
+		ps.handle,
+		(*C.JoltBodyID)(unsafe.Pointer(&dst.IDs[0])),
+		C.int(len(ids)),
+		(*C.float)(unsafe.Pointer(&dst.Positions[0])),
+		(*C.float)(unsafe.Pointer(&dst.Rotations[0])),
+		(*C.float)(unsafe.Pointer(&dst.LinearVelocities[0])),
+		(*C.float)(unsafe.Pointer(&dst.AngularVelocities[0])),
+	)
+
+	return int(numFound)
+}
+
+// ReadPositions64 reads the double-precision positions of many bodies in a single call: dst[i] receives the
+// position of ids[i]. Only min(len(ids), len(dst)) bodies are read; bodies that no longer exist read as zero.
+// Returns the number of bodies that were found.
+func (ps *PhysicsSystem) ReadPositions64(ids []BodyID, dst []RVec3) int {
+	n := min(len(ids), len(dst))
+	if n == 0 {
+		return 0
+	}
+
+	return int(C.JoltReadBodyPositions64(
+		ps.handle,
+		(*C.JoltBodyID)(unsafe.Pointer(&ids[0])),
+		C.int(n),
+		(*C.double)(unsafe.Pointer(&dst[0])),
+	))
+}
+
+// ReadActiveBodyStates reads the state of all active (awake) rigid bodies, skipping sleeping and
+// static bodies entirely. This is the cheapest way to replicate only what moved during the last update.
+// Must not be called concurrently with Update.
+//
+// Parameters:
+//   - dst: Buffer receiving the state; it is resized to the number of active bodies and dst.IDs lists them
+//
+// Returns the number of active bodies.
+//
+// Example usage:
+//
+//	states := jolt.NewBodyStateBuffer(1024) // allocated once, grows if needed
+//	for {
+//	    ps.Update(1.0 / 60.0)
+//	    n := ps.ReadActiveBodyStates(states)
+//	    for i := 0; i < n; i++ {
+//	        replicate(states.IDs[i], states.Positions[i], states.Rotations[i])
+//	    }
+//	}
+func (ps *PhysicsSystem) ReadActiveBodyStates(dst *BodyStateBuffer) int {
+	dst.resize(dst.minCap())
+	for {
+		var ids *C.JoltBodyID
+		var positions, rotations, linVels, angVels *C.float
+		if dst.Len() > 0 {
+			ids = (*C.JoltBodyID)(unsafe.Pointer(&dst.IDs[0]))
+			positions = (*C.float)(unsafe.Pointer(&dst.Positions[0]))
+			rotations = (*C.float)(unsafe.Pointer(&dst.Rotations[0]))
+			linVels = (*C.float)(unsafe.Pointer(&dst.LinearVelocities[0]))
+			angVels = (*C.float)(unsafe.Pointer(&dst.AngularVelocities[0]))
+		}
+
+		numActive := int(C.JoltReadActiveBodyStates(
+			ps.handle,
+			ids,
+			C.int(dst.Len()),
+			positions,
+			rotations,
+			linVels,
+			angVels,
+		))
+
+		// Grow and read again if the buffer was too small
+		grow := numActive > dst.Len()
+		dst.resize(numActive)
+		if !grow {
+			return numActive
+		}
+	}
 }
@@ -0,0 +1,94 @@
+package jolt
+
+// #include "wrapper/body_group.h"
+import "C"
+import "unsafe"
+
+// BodyGroup is a set of bodies, such as one streamed map chunk, that enters and leaves the world as a whole.
+//
+// PrepareBodyGroup creates the bodies and builds their broadphase subtree without touching the live world, so
+// it can run on a loader goroutine while the simulation keeps going. Commit then links the prepared subtree
+// into the broadphase in one step, and Remove takes all bodies out again in one call. Swapping chunks
+// therefore costs one cheap call on the tick goroutine instead of a broadphase insert per body.
+//
+// There is no need to call PhysicsSystem.OptimizeBroadPhase after streaming groups in: each group arrives
+// as a balanced subtree, and Jolt rebuilds the broadphase trees incrementally during Update, one layer per
+// step, which spreads the optimization over several ticks.
+//
+// A BodyGroup itself is not safe for concurrent use: hand it from the loader to the tick goroutine.
+//
+// Example usage:
+//
+//	// Loader goroutine
+//	go func() {
+//	    group := bi.PrepareBodyGroup(chunk.BodySettings())
+//	    ready <- group
+//	}()
+//
+//	// Tick goroutine, between updates
+//	select {
+//	case group := <-ready:
+//	    group.Commit(true)
+//	default:
+//	}
+//	ps.Update(dt)
+//
+//	// Later, when the player has left the chunk
+//	group.Destroy() // removes and destroys all of its bodies
+type BodyGroup struct {
+	handle C.JoltBodyGroup
+	ids    []BodyID
+}
+
+// PrepareBodyGroup creates the bodies described by settings and prepares their insert into the broadphase,
+// without adding them to the world. Safe to call from any goroutine, also while the world is updating.
+func (bi *BodyInterface) PrepareBodyGroup(settings []BodyCreationSettings) *BodyGroup {
+	ids := make([]BodyID, len(settings))
+
+	var cSettings *C.JoltBodyCreationSettings
+	var cIDs *C.JoltBodyID
+	if len(settings) > 0 {
+		converted := cBodyCreationSettings(settings)
+		cSettings = &converted[0]
+		cIDs = (*C.JoltBodyID)(unsafe.Pointer(&ids[0]))
+	}
+
+	handle := C.JoltCreateBodyGroup(bi.handle, cSettings, C.int(len(settings)), cIDs)
+	return &BodyGroup{handle: handle, ids: ids}
+}
+
+// IDs returns the IDs of the group's bodies in the same order as the settings passed to PrepareBodyGroup
+// (InvalidBodyID for bodies that could not be created). The slice is owned by the group; don't modify it.
+func (g *BodyGroup) IDs() []BodyID {
+	return g.ids
+}
+
+// Len returns the number of bodies in the group that were created
+func (g *BodyGroup) Len() int {
+	return int(C.JoltBodyGroupGetNumBodies(g.handle))
+}
+
+// Commit adds all bodies of the group to the world at once. Call it from the goroutine that updates the world,
+// between updates. If activate is true, the kinematic and dynamic bodies start active.
+// Committing a group that was removed prepares the insert again on the calling goroutine first.
+func (g *BodyGroup) Commit(activate bool) {
+	C.JoltBodyGroupCommit(g.handle, C.int(boolToInt(activate)))
+}
+
+// Remove takes all bodies of the group out of the world in one call. The bodies keep their state and the
+// group can be committed again later. Call it between updates.
+func (g *BodyGroup) Remove() {
+	C.JoltBodyGroupRemove(g.handle)
+}
+
+// IsAdded reports whether the group's bodies are currently in the world
+func (g *BodyGroup) IsAdded() bool {
+	return C.JoltBodyGroupIsAdded(g.handle) != 0
+}
+
+// Destroy removes the group's bodies from the world if needed and destroys them. Call it between updates.
+func (g *BodyGroup) Destroy() {
+	C.JoltDestroyBodyGroup(g.handle)
+	g.handle = nil
+	g.ids = nil
+}
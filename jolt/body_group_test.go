@@ -0,0 +1,64 @@
+package jolt
+
+import "testing"
+
+func TestBodyGroupLifecycle(t *testing.T) {
+	ps := NewPhysicsSystem()
+	defer ps.Destroy()
+	bi := ps.GetBodyInterface()
+
+	box := CreateBox(Vec3{X: 1, Y: 1, Z: 1})
+	defer box.Destroy()
+
+	// Three static boxes along X and one dynamic box above them
+	var settings []BodyCreationSettings
+	for i := 0; i < 3; i++ {
+		settings = append(settings, NewBodyCreationSettings(box, Vec3{X: float32(i) * 4, Y: 0, Z: 0}, MotionTypeStatic))
+	}
+	settings = append(settings, NewBodyCreationSettings(box, Vec3{X: 0, Y: 10, Z: 0}, MotionTypeDynamic))
+
+	// Prepare on another goroutine, like a chunk loader would
+	ready := make(chan *BodyGroup)
+	go func() { ready <- bi.PrepareBodyGroup(settings) }()
+	group := <-ready
+
+	if group.Len() != 4 || len(group.IDs()) != 4 {
+		t.Fatalf("group has %d bodies (%d IDs), expected 4", group.Len(), len(group.IDs()))
+	}
+
+	hitsChunk := func() bool {
+		_, ok := ps.CastRay(Vec3{X: 8, Y: 5, Z: 0}, Vec3{X: 0, Y: -10, Z: 0})
+		return ok
+	}
+	if group.IsAdded() || hitsChunk() {
+		t.Fatal("prepared bodies should not be in the world yet")
+	}
+
+	group.Commit(true)
+	if !group.IsAdded() || !hitsChunk() {
+		t.Fatal("committed bodies should be in the world")
+	}
+	states := NewBodyStateBuffer(8)
+	if n := ps.ReadActiveBodyStates(states); n != 1 || states.IDs[0] != group.IDs()[3] {
+		t.Errorf("active bodies = %v, expected only the dynamic body %v", states.IDs, group.IDs()[3])
+	}
+
+	group.Remove()
+	if group.IsAdded() || hitsChunk() {
+		t.Fatal("removed bodies should not be in the world")
+	}
+
+	// A removed group can come back
+	group.Commit(false)
+	if !hitsChunk() {
+		t.Fatal("recommitted bodies should be in the world")
+	}
+
+	group.Destroy()
+	if hitsChunk() {
+		t.Fatal("destroyed bodies should not be in the world")
+	}
+
+	// Destroying a group that was never committed aborts the prepared insert
+	bi.PrepareBodyGroup(settings).Destroy()
+}
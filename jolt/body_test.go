@@ -0,0 +1,348 @@
+package jolt
+
+import (
+	"math"
+	"testing"
+)
+
+func TestReadBodyStates(t *testing.T) {
+	ps := NewPhysicsSystem()
+	defer ps.Destroy()
+	bi := ps.GetBodyInterface()
+
+	sphere := CreateSphere(0.5)
+	defer sphere.Destroy()
+
+	var ids []BodyID
+	for i := 0; i < 4; i++ {
+		ids = append(ids, bi.CreateBody(sphere, Vec3{X: float32(i) * 2, Y: 10, Z: 0}, MotionTypeDynamic, false))
+	}
+
+	// Include an ID that doesn't refer to a body
+	query := append([]BodyID{}, ids...)
+	query = append(query, InvalidBodyID)
+
+	states := NewBodyStateBuffer(0)
+	if n := ps.ReadBodyStates(query, states); n != len(ids) {
+		t.Fatalf("found %d bodies, expected %d", n, len(ids))
+	}
+	if states.Len() != len(query) {
+		t.Fatalf("buffer length = %d, expected %d", states.Len(), len(query))
+	}
+	for i, id := range ids {
+		if states.IDs[i] != id {
+			t.Errorf("IDs[%d] = %v, expected %v", i, states.IDs[i], id)
+		}
+		if states.Positions[i] != bi.GetPosition(id) {
+			t.Errorf("Positions[%d] = %+v, expected %+v", i, states.Positions[i], bi.GetPosition(id))
+		}
+		if states.Rotations[i] != QuatIdentity() {
+			t.Errorf("Rotations[%d] = %+v, expected identity", i, states.Rotations[i])
+		}
+	}
+	if states.Rotations[len(ids)] != QuatIdentity() || states.Positions[len(ids)] != (Vec3{}) {
+		t.Errorf("missing body should read as default state, got %+v %+v",
+			states.Positions[len(ids)], states.Rotations[len(ids)])
+	}
+}
+
+func TestReadActiveBodyStates(t *testing.T) {
+	ps := NewPhysicsSystem()
+	defer ps.Destroy()
+	bi := ps.GetBodyInterface()
+
+	sphere := CreateSphere(0.5)
+	defer sphere.Destroy()
+
+	floor := CreateBox(Vec3{X: 10, Y: 0.5, Z: 10})
+	defer floor.Destroy()
+	bi.CreateBody(floor, Vec3{}, MotionTypeStatic, false)
+
+	awake := bi.CreateBody(sphere, Vec3{X: 0, Y: 10, Z: 0}, MotionTypeDynamic, false)
+	bi.ActivateBody(awake)
+	bi.CreateBody(sphere, Vec3{X: 4, Y: 10, Z: 0}, MotionTypeDynamic, false) // never activated
+
+	for i := 0; i < 10; i++ {
+		ps.Update(1.0 / 60.0)
+	}
+
+	// Start with no capacity to exercise the grow path
+	states := &BodyStateBuffer{}
+	n := ps.ReadActiveBodyStates(states)
+	if n != 1 || states.Len() != 1 {
+		t.Fatalf("active bodies = %d (len %d), expected 1", n, states.Len())
+	}
+	if states.IDs[0] != awake {
+		t.Errorf("active body = %v, expected %v", states.IDs[0], awake)
+	}
+	if states.LinearVelocities[0].Y >= 0 {
+		t.Errorf("falling body should have negative Y velocity, got %.2f", states.LinearVelocities[0].Y)
+	}
+	if math.Abs(float64(states.Positions[0].Y-bi.GetPosition(awake).Y)) > 1e-6 {
+		t.Errorf("position %.3f differs from GetPosition %.3f", states.Positions[0].Y, bi.GetPosition(awake).Y)
+	}
+
+	// Steady state reads reuse the buffer
+	allocs := testing.AllocsPerRun(10, func() {
+		ps.ReadActiveBodyStates(states)
+	})
+	if allocs != 0 {
+		t.Errorf("ReadActiveBodyStates allocated %.1f times per run, expected 0", allocs)
+	}
+}
+
+func TestCreateBodiesBatch(t *testing.T) {
+	ps := NewPhysicsSystem()
+	defer ps.Destroy()
+	bi := ps.GetBodyInterface()
+
+	box := CreateBox(Vec3{X: 0.5, Y: 0.5, Z: 0.5})
+	defer box.Destroy()
+
+	var settings []BodyCreationSettings
+	for i := 0; i < 100; i++ {
+		settings = append(settings, NewBodyCreationSettings(box, Vec3{X: float32(i) * 2, Y: 0, Z: 0}, MotionTypeStatic))
+	}
+	falling := NewBodyCreationSettings(box, Vec3{X: 0, Y: 20, Z: 0}, MotionTypeDynamic)
+	settings = append(settings, falling)
+
+	ids := bi.CreateBodies(settings, true)
+	ps.OptimizeBroadPhase()
+
+	if len(ids) != len(settings) {
+		t.Fatalf("got %d IDs, expected %d", len(ids), len(settings))
+	}
+	for i, id := range ids {
+		if id.IsInvalid() {
+			t.Fatalf("body %d was not created", i)
+		}
+		if bi.GetPosition(id) != settings[i].Position {
+			t.Errorf("body %d at %+v, expected %+v", i, bi.GetPosition(id), settings[i].Position)
+		}
+	}
+
+	// Only the dynamic body is active
+	states := NewBodyStateBuffer(4)
+	if n := ps.ReadActiveBodyStates(states); n != 1 || states.IDs[0] != ids[len(ids)-1] {
+		t.Errorf("active bodies = %v, expected only %v", states.IDs, ids[len(ids)-1])
+	}
+
+	// The static bodies are queryable straight away
+	if _, ok := ps.CastRay(Vec3{X: 10, Y: 5, Z: 0}, Vec3{X: 0, Y: -10, Z: 0}); !ok {
+		t.Error("ray should hit a batch-created body")
+	}
+
+	bi.RemoveBodies(ids)
+	bi.DestroyBodies(ids)
+
+	if _, ok := ps.CastRay(Vec3{X: 10, Y: 5, Z: 0}, Vec3{X: 0, Y: -10, Z: 0}); ok {
+		t.Error("ray should miss after the bodies were removed")
+	}
+}
+
+func TestBodyTransformAndVelocity(t *testing.T) {
+	ps := NewPhysicsSystem()
+	defer ps.Destroy()
+	bi := ps.GetBodyInterface()
+
+	sphere := CreateSphere(0.5)
+	defer sphere.Destroy()
+	id := bi.CreateBody(sphere, Vec3{X: 0, Y: 10, Z: 0}, MotionTypeDynamic, false)
+
+	// 90 degrees around Y
+	s := float32(math.Sqrt(0.5))
+	rot := Quat{X: 0, Y: s, Z: 0, W: s}
+	bi.SetPositionAndRotation(id, Vec3{X: 1, Y: 2, Z: 3}, rot, false)
+	if p := bi.GetPosition(id); p != (Vec3{X: 1, Y: 2, Z: 3}) {
+		t.Errorf("position = %+v, expected (1, 2, 3)", p)
+	}
+	if got := bi.GetRotation(id); math.Abs(float64(got.Y-s)) > 1e-5 || math.Abs(float64(got.W-s)) > 1e-5 {
+		t.Errorf("rotation = %+v, expected %+v", got, rot)
+	}
+
+	// The zero quaternion resets to identity
+	bi.SetRotation(id, Quat{}, false)
+	if got := bi.GetRotation(id); got != QuatIdentity() {
+		t.Errorf("rotation = %+v, expected identity", got)
+	}
+
+	bi.SetLinearVelocity(id, Vec3{X: 1, Y: 0, Z: 0})
+	bi.SetAngularVelocity(id, Vec3{X: 0, Y: 2, Z: 0})
+	if v := bi.GetLinearVelocity(id); v != (Vec3{X: 1, Y: 0, Z: 0}) {
+		t.Errorf("linear velocity = %+v, expected (1, 0, 0)", v)
+	}
+	if v := bi.GetAngularVelocity(id); v != (Vec3{X: 0, Y: 2, Z: 0}) {
+		t.Errorf("angular velocity = %+v, expected (0, 2, 0)", v)
+	}
+
+	// An impulse changes the velocity immediately
+	bi.AddImpulse(id, Vec3{X: 0, Y: 1000, Z: 0})
+	if v := bi.GetLinearVelocity(id); v.Y <= 0 {
+		t.Errorf("velocity after impulse = %+v, expected upwards", v)
+	}
+
+	// Batched velocities and impulses
+	ids := []BodyID{id}
+	bi.SetVelocities(ids, []Vec3{{X: 0, Y: 0, Z: 0}}, nil)
+	if v := bi.GetLinearVelocity(id); v != (Vec3{}) {
+		t.Errorf("linear velocity = %+v, expected zero", v)
+	}
+	if v := bi.GetAngularVelocity(id); v != (Vec3{X: 0, Y: 2, Z: 0}) {
+		t.Errorf("nil angular velocities should leave the angular velocity alone, got %+v", v)
+	}
+	bi.AddImpulses(ids, []Vec3{{X: 1000, Y: 0, Z: 0}})
+	if v := bi.GetLinearVelocity(id); v.X <= 0 {
+		t.Errorf("velocity after batched impulse = %+v, expected +X", v)
+	}
+}
+
+func TestMoveKinematicBodies(t *testing.T) {
+	ps := NewPhysicsSystem()
+	defer ps.Destroy()
+	bi := ps.GetBodyInterface()
+
+	box := CreateBox(Vec3{X: 1, Y: 0.1, Z: 1})
+	defer box.Destroy()
+
+	var settings []BodyCreationSettings
+	for i := 0; i < 3; i++ {
+		settings = append(settings, NewBodyCreationSettings(box, Vec3{X: float32(i) * 5, Y: 0, Z: 0}, MotionTypeKinematic))
+	}
+	ids := bi.CreateBodies(settings, false)
+
+	const dt = float32(1.0 / 60.0)
+	targets := make([]Vec3, len(ids))
+	rotations := make([]Quat, len(ids))
+	for i := range ids {
+		targets[i] = Vec3{X: float32(i) * 5, Y: 1, Z: 0}
+		rotations[i] = QuatIdentity()
+	}
+
+	bi.MoveKinematicBodies(ids, targets, rotations, dt)
+	for i, id := range ids {
+		// The velocity that reaches the target in one step is set right away and wakes the body
+		if v := bi.GetLinearVelocity(id); math.Abs(float64(v.Y-1/dt)) > 0.01 {
+			t.Errorf("body %d velocity = %+v, expected Y = %.1f", i, v, 1/dt)
+		}
+	}
+
+	ps.Update(dt)
+	for i, id := range ids {
+		if p := bi.GetPosition(id); math.Abs(float64(p.Y-1)) > 1e-3 {
+			t.Errorf("body %d position = %+v, expected Y = 1", i, p)
+		}
+	}
+
+	// Unchanged transforms leave the bodies alone
+	bi.SetPositionsAndRotationsWhenChanged(ids, targets, rotations, false)
+	bi.SetPositionsAndRotations(ids[:1], []Vec3{{X: 0, Y: 5, Z: 0}}, nil, false)
+	if p := bi.GetPosition(ids[0]); p.Y != 5 {
+		t.Errorf("position = %+v, expected Y = 5", p)
+	}
+}
+
+func TestPositions64(t *testing.T) {
+	ps := NewPhysicsSystem()
+	defer ps.Destroy()
+	bi := ps.GetBodyInterface()
+
+	box := CreateBox(Vec3{X: 1, Y: 1, Z: 1})
+	defer box.Destroy()
+
+	// Exactly representable as float32 too, so this holds for both library precisions
+	far := RVec3{X: 20000.5, Y: 3, Z: -30000.25}
+	id := bi.CreateBody64(box, far, MotionTypeKinematic, false, ObjectLayerFromMotionType)
+	if p := bi.GetPosition64(id); p != far {
+		t.Errorf("position = %+v, expected %+v", p, far)
+	}
+
+	batch := bi.CreateBodies([]BodyCreationSettings{
+		NewBodyCreationSettings64(box, far.Add(Vec3{X: 10}), MotionTypeKinematic),
+		NewBodyCreationSettings(box, Vec3{X: 1, Y: 2, Z: 3}, MotionTypeKinematic),
+	}, false)
+
+	dst := make([]RVec3, 3)
+	if n := ps.ReadPositions64([]BodyID{id, batch[0], batch[1]}, dst); n != 3 {
+		t.Fatalf("read %d positions, expected 3", n)
+	}
+	expected := []RVec3{far, far.Add(Vec3{X: 10}), {X: 1, Y: 2, Z: 3}}
+	for i := range expected {
+		if dst[i] != expected[i] {
+			t.Errorf("position %d = %+v, expected %+v", i, dst[i], expected[i])
+		}
+	}
+
+	moved := far.Add(Vec3{Y: 1})
+	bi.SetPositionsAndRotations64([]BodyID{id}, []RVec3{moved}, nil, false)
+	if p := bi.GetPosition64(id); p != moved {
+		t.Errorf("position after batch set = %+v, expected %+v", p, moved)
+	}
+	bi.SetPositionsAndRotationsWhenChanged64([]BodyID{id, batch[1]}, []RVec3{moved, {X: 1, Y: 4, Z: 3}}, nil, false)
+	if p := bi.GetPosition64(id); p != moved {
+		t.Errorf("unchanged position after batch set = %+v, expected %+v", p, moved)
+	}
+	if p := bi.GetPosition64(batch[1]); p != (RVec3{X: 1, Y: 4, Z: 3}) {
+		t.Errorf("changed position after batch set = %+v, expected Y = 4", p)
+	}
+
+	const dt = float32(1.0 / 60.0)
+	bi.MoveKinematic64(id, moved.Add(Vec3{Y: 1}), QuatIdentity(), dt)
+	ps.Update(dt)
+	if p := bi.GetPosition64(id); math.Abs(p.Y-5) > 1e-3 || p.X != far.X {
+		t.Errorf("position after move = %+v, expected Y = 5 at X = %v", p, far.X)
+	}
+
+	// Only the double-precision library keeps centimeters a thousand kilometers from the origin
+	if DoublePrecision {
+		precise := RVec3{X: 1e6 + 0.01, Y: 0, Z: -1e6 - 0.01}
+		bi.SetPosition64(id, precise)
+		if p := bi.GetPosition64(id); p != precise {
+			t.Errorf("position = %+v, expected %+v", p, precise)
+		}
+	}
+}
+
+func TestBodyCreationSettingsZeroObjectLayer(t *testing.T) {
+	ps := NewPhysicsSystem()
+	defer ps.Destroy()
+	bi := ps.GetBodyInterface()
+
+	floor := CreateBox(Vec3{X: 10, Y: 0.5, Z: 10})
+	defer floor.Destroy()
+	sphere := CreateSphere(0.5)
+	defer sphere.Destroy()
+
+	// Hand-built settings without an ObjectLayer get the default layer for their motion type,
+	// so the dynamic ball lands on the static floor instead of sharing its non-moving layer
+	ids := bi.CreateBodies([]BodyCreationSettings{
+		{Shape: floor, MotionType: MotionTypeStatic},
+		{Shape: sphere, Position: Vec3{X: 0, Y: 3, Z: 0}, MotionType: MotionTypeDynamic},
+	}, true)
+	for i := 0; i < 120; i++ {
+		ps.Update(1.0 / 60.0)
+	}
+	if y := bi.GetPosition(ids[1]).Y; y < 0.9 || y > 1.1 {
+		t.Errorf("ball Y = %.2f, expected it to rest on the floor at ~1.0", y)
+	}
+}
+
+func TestBodyCreationSettingsExplicitLayerZero(t *testing.T) {
+	ps := newLayerTestWorld(t)
+	bi := ps.GetBodyInterface()
+
+	sphere := CreateSphere(0.5)
+	defer sphere.Destroy()
+
+	// HasObjectLayer puts a moving body in layer 0 itself
+	ids := bi.CreateBodies([]BodyCreationSettings{
+		{Shape: sphere, MotionType: MotionTypeKinematic, ObjectLayer: testLayerTerrain, HasObjectLayer: true},
+		{Shape: sphere, Position: Vec3{X: 3, Y: 0, Z: 0}, MotionType: MotionTypeKinematic, ObjectLayer: testLayerDebris},
+	}, false)
+
+	opts := NewQueryOptions()
+	opts.LayerMask = testLayerTerrain.Mask()
+	found := make([]BodyID, 4)
+	if n := ps.CollideSphereBroadPhaseInto(Vec3{}, 10, found, opts); n != 1 || found[0] != ids[0] {
+		t.Errorf("terrain layer holds %v, expected only %v", found[:n], ids[0])
+	}
+}
@@ -4,12 +4,43 @@ Package jolt provides Go bindings for the Jolt Physics engine.
 Architecture: Go code → CGO → C wrapper → Jolt C++ library
 Uses opaque pointers to hide C++ types from Go.
 
-Pre-built binaries are provided for darwin/arm64 and linux/amd64.
+Pre-built binaries are provided for darwin/arm64, linux/amd64 and linux/arm64.
 Platform-specific LDFLAGS are in cgo_<os>_<arch>.go files.
+
+Build with the jolt_perf tag (go build -tags jolt_perf) to link the optimized variant of the
+pre-built libraries from lib/<os>_<arch>_perf instead (cgo_perf_<os>_<arch>.go). It is built with
+link-time optimization across Jolt and the wrapper, tuned for the CPU (AVX2/FMA on linux/amd64,
+Neoverse on linux/arm64, Apple M1 on darwin/arm64), and leaves out Jolt's profiler and debug
+renderer. On linux/amd64 it needs a CPU with AVX2 and FMA (Intel Haswell, AMD Excavator or newer);
+on linux/arm64 an ARMv8.2 CPU (AWS Graviton2, Ampere Altra or newer). scripts/build-libs.sh builds
+the default libraries with JPH_CROSS_PLATFORM_DETERMINISTIC and the jolt_perf ones without it; the committed
+default libraries predate that, so CrossPlatformDeterministic reports false until they are rebuilt.
+The jolt_perf libraries are not committed yet; build them with scripts/build-libs.sh (variant perf) or take
+them from the CI artifacts before using the tag.
+
+Build with the jolt_double tag to link the double-precision variant from lib/<os>_<arch>_double
+(cgo_double_<os>_<arch>.go), built with JPH_DOUBLE_PRECISION so positions stay accurate in worlds spanning
+hundreds of kilometers; use the *64 methods taking and returning RVec3 to keep that precision on the Go side.
+Combined with jolt_perf it links lib/<os>_<arch>_perf_double. These libraries are not committed yet either
+(scripts/build-libs.sh variants double and perf_double). The Go API is the same for every variant. Only the
+*64 methods and the single-body position functions carry positions as doubles; batch queries, shape casts,
+broadphase regions, body state buffers, events and character contacts and group states still use float32
+positions and lose precision far from the origin.
+
+Concurrency: queries only read the world, so any number of goroutines can run CastRay, CollideShape,
+CastShape, the broadphase queries and their batches on the same PhysicsSystem at the same time between
+steps. They must not overlap Update. Give each goroutine its own QueryOptions and result slices. By default
+bodies are read under Jolt's body locks, which keeps queries safe while other goroutines create, remove or
+move bodies; QueryOptions.NoLock skips the locks when the caller guarantees nothing modifies the world
+meanwhile. Parallel batches from several goroutines share the worker threads; a batch that finds no free
+barrier (see InitOptions.MaxBarriers) runs on its own goroutine's thread instead. Different characters can
+be updated from different goroutines between steps, each character from one goroutine at a time; their
+updates take turns on the world's temp allocator. The caller orders queries before the next Update, e.g.
+by waiting on a sync.WaitGroup; no mutex around each query is needed.
 */
 package jolt
 
 /*
-#cgo CXXFLAGS: -std=c++17 -IJoltPhysics -DNDEBUG -DJPH_DISABLE_CUSTOM_ALLOCATOR -DJPH_PROFILE_ENABLED -DJPH_DEBUG_RENDERER -DJPH_OBJECT_STREAM
+#cgo CXXFLAGS: -std=c++17 -IJoltPhysics -DNDEBUG -DJPH_DISABLE_CUSTOM_ALLOCATOR -DJPH_OBJECT_STREAM
 */
 import "C"
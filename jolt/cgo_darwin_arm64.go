@@ -1,4 +1,4 @@
-//go:build darwin && arm64
+//go:build darwin && arm64 && !jolt_perf && !jolt_double
 
 package jolt
 
@@ -0,0 +1,12 @@
+//go:build jolt_double
+
+package jolt
+
+/*
+#cgo CXXFLAGS: -DJPH_DOUBLE_PRECISION
+*/
+import "C"
+
+// DoublePrecision reports whether the double-precision jolt_double variant of the native libraries is linked.
+// That variant is built with JPH_DOUBLE_PRECISION, so the *64 position APIs keep their full precision.
+const DoublePrecision = true
@@ -0,0 +1,8 @@
+//go:build darwin && arm64 && !jolt_perf && jolt_double
+
+package jolt
+
+/*
+#cgo LDFLAGS: -L${SRCDIR}/lib/darwin_arm64_double -ljolt_wrapper -lJolt -lc++
+*/
+import "C"
@@ -0,0 +1,8 @@
+//go:build linux && arm64 && !jolt_perf && jolt_double
+
+package jolt
+
+/*
+#cgo LDFLAGS: -L${SRCDIR}/lib/linux_arm64_double -ljolt_wrapper -lJolt -lstdc++ -lm -lpthread
+*/
+import "C"
@@ -0,0 +1,19 @@
+//go:build !jolt_perf
+
+package jolt
+
+/*
+// The wrapper is also built with -ffp-contract=off (see scripts/build-libs.sh); cgo doesn't allow that
+// flag here, and the C++ is only compiled into the pre-built libraries anyway.
+#cgo CXXFLAGS: -DJPH_PROFILE_ENABLED -DJPH_DEBUG_RENDERER -DJPH_CROSS_PLATFORM_DETERMINISTIC
+*/
+import "C"
+
+// PerfBuild reports whether the optimized jolt_perf variant of the native libraries is linked
+const PerfBuild = false
+
+// CrossPlatformDeterministic reports whether the linked libraries are built with
+// JPH_CROSS_PLATFORM_DETERMINISTIC: the same inputs then give bit-identical results on every platform.
+// build-libs.sh builds the default libraries that way, but the committed ones predate it, so this stays
+// false until they are rebuilt and committed.
+const CrossPlatformDeterministic = false
@@ -0,0 +1,12 @@
+//go:build jolt_perf
+
+package jolt
+
+// PerfBuild reports whether the optimized jolt_perf variant of the native libraries is linked.
+// That variant is built without JPH_PROFILE_ENABLED and JPH_DEBUG_RENDERER.
+const PerfBuild = true
+
+// CrossPlatformDeterministic reports whether the linked libraries are built with
+// JPH_CROSS_PLATFORM_DETERMINISTIC. The jolt_perf variant is not: it uses fused multiply-add and other
+// CPU-specific code, so it is only deterministic between machines running the same binary on the same CPU family.
+const CrossPlatformDeterministic = false
@@ -0,0 +1,8 @@
+//go:build linux && amd64 && jolt_perf && jolt_double
+
+package jolt
+
+/*
+#cgo LDFLAGS: -L${SRCDIR}/lib/linux_amd64_perf_double -ljolt_wrapper -lstdc++ -lm -lpthread
+*/
+import "C"
@@ -0,0 +1,8 @@
+//go:build linux && arm64 && jolt_perf && !jolt_double
+
+package jolt
+
+/*
+#cgo LDFLAGS: -L${SRCDIR}/lib/linux_arm64_perf -ljolt_wrapper -lstdc++ -lm -lpthread
+*/
+import "C"
@@ -0,0 +1,6 @@
+//go:build !jolt_double
+
+package jolt
+
+// DoublePrecision reports whether the double-precision jolt_double variant of the native libraries is linked
+const DoublePrecision = false
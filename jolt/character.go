@@ -2,6 +2,10 @@ package jolt
 
 // #include "wrapper/character.h"
 import "C"
+import (
+	"math"
+	"unsafe"
+)
 
 // BackFaceMode controls how the character collides with back faces
 type BackFaceMode int
@@ -27,8 +31,8 @@ type CharacterContact struct {
 	Distance float32
 	// Fraction along the path where this contact takes place
 	Fraction float32
-	// BodyB is the ID of the body we're colliding with (nil if invalid)
-	BodyB *BodyID
+	// BodyB is the ID of the body we're colliding with (InvalidBodyID if none)
+	BodyB BodyID
 	// UserData is the user data of the body
 	UserData uint64
 	// IsSensorB indicates if the body is a sensor
@@ -97,6 +101,72 @@ type CharacterVirtualSettings struct {
 	// EnhancedInternalEdgeRemoval removes ghost contacts with internal mesh edges.
 	// More expensive but smoother movement over convex edges. (default: false)
 	EnhancedInternalEdgeRemoval bool
+
+	// ObjectLayer is the layer the character collides as; it hits whatever a body in this layer would
+	// (default: ObjectLayerMoving)
+	ObjectLayer ObjectLayer
+
+	// ExtendedUpdate configures the stair walking and floor sticking of ExtendedUpdate
+	// (default: NewExtendedUpdateSettings())
+	ExtendedUpdate ExtendedUpdateSettings
+}
+
+// ExtendedUpdateSettings configures the extra sweeps ExtendedUpdate runs on top of Update.
+// Zeroing StickToFloorStepDown or WalkStairsStepUp skips that part entirely, which saves its sweeps for
+// characters that never need it (e.g. NPCs on flat navmesh areas).
+type ExtendedUpdateSettings struct {
+	// StickToFloorStepDown is how far to probe for the floor when the character leaves the ground while
+	// walking down a slope (default: {0, -0.5, 0}). Zero disables StickToFloor.
+	StickToFloorStepDown Vec3
+
+	// WalkStairsStepUp is the maximum step up when walking into a stair (default: {0, 0.4, 0}).
+	// Zero disables WalkStairs.
+	WalkStairsStepUp Vec3
+
+	// WalkStairsMinStepForward is the distance to move forward after stepping up (default: 0.02)
+	WalkStairsMinStepForward float32
+
+	// WalkStairsStepForwardTest is the distance to test ahead for a floor after stepping up,
+	// so the character doesn't step up onto thin obstacles (default: 0.15)
+	WalkStairsStepForwardTest float32
+
+	// WalkStairsCosAngleForwardContact is the cos of the max angle between the contact normal and the
+	// movement direction for a contact to count as a stair (default: cos(75 degrees))
+	WalkStairsCosAngleForwardContact float32
+
+	// WalkStairsStepDownExtra is an extra step down after a stair step, for stairs with a slope
+	// (default: {0, 0, 0})
+	WalkStairsStepDownExtra Vec3
+}
+
+// NewExtendedUpdateSettings creates settings with Jolt's default values
+func NewExtendedUpdateSettings() ExtendedUpdateSettings {
+	return ExtendedUpdateSettings{
+		StickToFloorStepDown:             Vec3{X: 0, Y: -0.5, Z: 0},
+		WalkStairsStepUp:                 Vec3{X: 0, Y: 0.4, Z: 0},
+		WalkStairsMinStepForward:         0.02,
+		WalkStairsStepForwardTest:        0.15,
+		WalkStairsCosAngleForwardContact: float32(math.Cos(float64(DegreesToRadians(75.0)))),
+		WalkStairsStepDownExtra:          Vec3{X: 0, Y: 0, Z: 0},
+	}
+}
+
+// toC converts the settings for the wrapper
+func (s *ExtendedUpdateSettings) toC() C.JoltExtendedUpdateSettings {
+	return C.JoltExtendedUpdateSettings{
+		stickToFloorStepDownX:            C.float(s.StickToFloorStepDown.X),
+		stickToFloorStepDownY:            C.float(s.StickToFloorStepDown.Y),
+		stickToFloorStepDownZ:            C.float(s.StickToFloorStepDown.Z),
+		walkStairsStepUpX:                C.float(s.WalkStairsStepUp.X),
+		walkStairsStepUpY:                C.float(s.WalkStairsStepUp.Y),
+		walkStairsStepUpZ:                C.float(s.WalkStairsStepUp.Z),
+		walkStairsMinStepForward:         C.float(s.WalkStairsMinStepForward),
+		walkStairsStepForwardTest:        C.float(s.WalkStairsStepForwardTest),
+		walkStairsCosAngleForwardContact: C.float(s.WalkStairsCosAngleForwardContact),
+		walkStairsStepDownExtraX:         C.float(s.WalkStairsStepDownExtra.X),
+		walkStairsStepDownExtraY:         C.float(s.WalkStairsStepDownExtra.Y),
+		walkStairsStepDownExtraZ:         C.float(s.WalkStairsStepDownExtra.Z),
+	}
 }
 
 // NewCharacterVirtualSettings creates settings with Jolt's default values
@@ -119,6 +189,8 @@ func NewCharacterVirtualSettings(shape *Shape) *CharacterVirtualSettings {
 		HitReductionCosMaxAngle:     0.999,
 		PenetrationRecoverySpeed:    1.0,
 		EnhancedInternalEdgeRemoval: false,
+		ObjectLayer:                 ObjectLayerMoving,
+		ExtendedUpdate:              NewExtendedUpdateSettings(),
 	}
 }
 
@@ -126,10 +198,18 @@ func NewCharacterVirtualSettings(shape *Shape) *CharacterVirtualSettings {
 type CharacterVirtual struct {
 	handle C.JoltCharacterVirtual
 	ps     *PhysicsSystem
+	layer  ObjectLayer
+
+	// Group the character belongs to (nil if none) and its index in the group
+	group      *CharacterGroup
+	groupIndex int
+
+	// Reused by GetActiveContactsInto so polling contacts every tick doesn't allocate
+	contactScratch []C.JoltCharacterContact
 }
 
 // GroundState indicates the ground contact state of a CharacterVirtual
-type GroundState int
+type GroundState int32
 
 const (
 	// GroundStateOnGround - Character is on the ground and can move freely
@@ -159,6 +239,11 @@ func (gs GroundState) String() string {
 
 // CreateCharacterVirtual creates a virtual character with the specified settings at the initial position
 func (ps *PhysicsSystem) CreateCharacterVirtual(settings *CharacterVirtualSettings, position Vec3) *CharacterVirtual {
+	return ps.CreateCharacterVirtual64(settings, position.RVec3())
+}
+
+// CreateCharacterVirtual64 is CreateCharacterVirtual with a double-precision initial position (see RVec3)
+func (ps *PhysicsSystem) CreateCharacterVirtual64(settings *CharacterVirtualSettings, position RVec3) *CharacterVirtual {
 	// Convert Go settings to C settings
 	cSettings := C.JoltCharacterVirtualSettings{
 		shape:                       settings.Shape.handle,
@@ -182,6 +267,8 @@ func (ps *PhysicsSystem) CreateCharacterVirtual(settings *CharacterVirtualSettin
 		hitReductionCosMaxAngle:     C.float(settings.HitReductionCosMaxAngle),
 		penetrationRecoverySpeed:    C.float(settings.PenetrationRecoverySpeed),
 		enhancedInternalEdgeRemoval: 0,
+		objectLayer:                 C.uint(settings.ObjectLayer),
+		extendedUpdate:              settings.ExtendedUpdate.toC(),
 	}
 	if settings.EnhancedInternalEdgeRemoval {
 		cSettings.enhancedInternalEdgeRemoval = 1
@@ -190,11 +277,11 @@ func (ps *PhysicsSystem) CreateCharacterVirtual(settings *CharacterVirtualSettin
 	handle := C.JoltCreateCharacterVirtual(
 		ps.handle,
 		&cSettings,
-		C.float(position.X),
-		C.float(position.Y),
-		C.float(position.Z),
+		C.double(position.X),
+		C.double(position.Y),
+		C.double(position.Z),
 	)
-	return &CharacterVirtual{handle: handle, ps: ps}
+	return &CharacterVirtual{handle: handle, ps: ps, layer: settings.ObjectLayer}
 }
 
 // Update advances the character simulation using the current velocity
@@ -214,7 +301,8 @@ func (cv *CharacterVirtual) Update(deltaTime float32, gravity Vec3) {
 }
 
 // ExtendedUpdate advances the character simulation with combined movement logic
-// Combines Update, StickToFloor, and WalkStairs into a unified operation
+// Combines Update, StickToFloor, and WalkStairs into a unified operation, configured by the character's
+// ExtendedUpdateSettings (see SetExtendedUpdateSettings)
 // deltaTime: duration of simulation step in seconds
 // gravity: acceleration vector (e.g., Vec3{0, -9.81, 0} for Earth gravity)
 func (cv *CharacterVirtual) ExtendedUpdate(deltaTime float32, gravity Vec3) {
@@ -228,6 +316,30 @@ func (cv *CharacterVirtual) ExtendedUpdate(deltaTime float32, gravity Vec3) {
 	)
 }
 
+// ObjectLayer returns the object layer the character collides as
+func (cv *CharacterVirtual) ObjectLayer() ObjectLayer {
+	return cv.layer
+}
+
+// SetObjectLayer changes the object layer the character collides as, starting with the next update
+func (cv *CharacterVirtual) SetObjectLayer(layer ObjectLayer) {
+	cv.layer = layer
+	C.JoltCharacterVirtualSetObjectLayer(cv.handle, C.uint(layer))
+}
+
+// SetExtendedUpdateSettings changes the settings used by ExtendedUpdate (and CharacterGroup.ExtendedUpdate)
+// for this character, starting with the next update
+//
+// Example usage:
+//
+//	// NPCs on flat ground: skip the stair and floor probes
+//	settings := jolt.ExtendedUpdateSettings{}
+//	npc.SetExtendedUpdateSettings(&settings)
+func (cv *CharacterVirtual) SetExtendedUpdateSettings(settings *ExtendedUpdateSettings) {
+	cSettings := settings.toC()
+	C.JoltCharacterVirtualSetExtendedUpdateSettings(cv.handle, &cSettings)
+}
+
 // SetLinearVelocity sets the character's linear velocity
 func (cv *CharacterVirtual) SetLinearVelocity(velocity Vec3) {
 	C.JoltCharacterVirtualSetLinearVelocity(
@@ -262,28 +374,42 @@ func (cv *CharacterVirtual) GetGroundVelocity() Vec3 {
 
 // SetPosition sets the character's position in the world
 func (cv *CharacterVirtual) SetPosition(position Vec3) {
+	cv.SetPosition64(position.RVec3())
+}
+
+// SetPosition64 sets the character's position in the world in double precision (see RVec3)
+func (cv *CharacterVirtual) SetPosition64(position RVec3) {
 	C.JoltCharacterVirtualSetPosition(
 		cv.handle,
-		C.float(position.X),
-		C.float(position.Y),
-		C.float(position.Z),
+		C.double(position.X),
+		C.double(position.Y),
+		C.double(position.Z),
 	)
 }
 
 // GetPosition returns the current position of the character
 func (cv *CharacterVirtual) GetPosition() Vec3 {
-	var x, y, z C.float
+	return cv.GetPosition64().Vec3()
+}
+
+// GetPosition64 returns the current position of the character in double precision (see RVec3)
+func (cv *CharacterVirtual) GetPosition64() RVec3 {
+	var x, y, z C.double
 	C.JoltCharacterVirtualGetPosition(cv.handle, &x, &y, &z)
-	return Vec3{
-		X: float32(x),
-		Y: float32(y),
-		Z: float32(z),
-	}
+	return RVec3{X: float64(x), Y: float64(y), Z: float64(z)}
 }
 
-// Destroy frees the character resources
+// Destroy frees the character resources (removing it from its CharacterGroup, if any).
+// Does nothing if the character was already destroyed, e.g. by CharacterGroup.Destroy.
 func (cv *CharacterVirtual) Destroy() {
+	if cv.handle == nil {
+		return
+	}
+	if cv.group != nil {
+		cv.group.remove(cv)
+	}
 	C.JoltDestroyCharacterVirtual(cv.handle)
+	cv.handle = nil
 }
 
 // GetGroundState returns the current ground contact state
@@ -334,39 +460,63 @@ func (cv *CharacterVirtual) GetGroundNormal() Vec3 {
 
 // GetGroundPosition returns the world position of the ground contact point
 func (cv *CharacterVirtual) GetGroundPosition() Vec3 {
-	var x, y, z C.float
+	return cv.GetGroundPosition64().Vec3()
+}
+
+// GetGroundPosition64 returns the world position of the ground contact point in double precision (see RVec3)
+func (cv *CharacterVirtual) GetGroundPosition64() RVec3 {
+	var x, y, z C.double
 	C.JoltCharacterVirtualGetGroundPosition(cv.handle, &x, &y, &z)
-	return Vec3{
-		X: float32(x),
-		Y: float32(y),
-		Z: float32(z),
-	}
+	return RVec3{X: float64(x), Y: float64(y), Z: float64(z)}
 }
 
 // GetActiveContacts returns the list of active contacts for the character
 // maxContacts specifies the maximum number of contacts to retrieve (typically 256)
+//
+// Allocates the returned slice on every call; use GetActiveContactsInto in per-tick code.
 func (cv *CharacterVirtual) GetActiveContacts(maxContacts int) []CharacterContact {
-	// Allocate C array for contacts
-	cContacts := make([]C.JoltCharacterContact, maxContacts)
+	if maxContacts <= 0 {
+		return nil
+	}
+	contacts := make([]CharacterContact, maxContacts)
+	return contacts[:cv.GetActiveContactsInto(contacts)]
+}
+
+// GetActiveContactsInto writes the active contacts of the character into dst and returns how many were
+// written (at most len(dst)). Costs no allocations once the character has been polled with a dst this large.
+//
+// Parameters:
+//   - dst: Caller-owned buffer to write the contacts into, reused between ticks
+//
+// Example usage:
+//
+//	contacts := make([]jolt.CharacterContact, 256)
+//	for {
+//	    n := character.GetActiveContactsInto(contacts)
+//	    for _, c := range contacts[:n] {
+//	        // ...
+//	    }
+//	}
+func (cv *CharacterVirtual) GetActiveContactsInto(dst []CharacterContact) int {
+	if len(dst) == 0 {
+		return 0
+	}
+	if cap(cv.contactScratch) < len(dst) {
+		cv.contactScratch = make([]C.JoltCharacterContact, len(dst))
+	}
+	cContacts := cv.contactScratch[:len(dst)]
 
-	// Call C function
 	numContacts := int(C.JoltCharacterVirtualGetActiveContacts(
 		cv.handle,
 		&cContacts[0],
-		C.int(maxContacts),
+		C.int(len(dst)),
 	))
 
 	// Convert C contacts to Go contacts
-	contacts := make([]CharacterContact, numContacts)
 	for i := 0; i < numContacts; i++ {
 		c := &cContacts[i]
 
-		var bodyB *BodyID
-		if c.bodyB != nil {
-			bodyB = &BodyID{handle: c.bodyB}
-		}
-
-		contacts[i] = CharacterContact{
+		dst[i] = CharacterContact{
 			Position: Vec3{
 				X: float32(c.positionX),
 				Y: float32(c.positionY),
@@ -389,7 +539,7 @@ func (cv *CharacterVirtual) GetActiveContacts(maxContacts int) []CharacterContac
 			},
 			Distance:         float32(c.distance),
 			Fraction:         float32(c.fraction),
-			BodyB:            bodyB,
+			BodyB:            BodyID(c.bodyB),
 			UserData:         uint64(c.userData),
 			IsSensorB:        c.isSensorB != 0,
 			HadCollision:     c.hadCollision != 0,
@@ -398,5 +548,204 @@ func (cv *CharacterVirtual) GetActiveContacts(maxContacts int) []CharacterContac
 		}
 	}
 
-	return contacts
+	return numContacts
+}
+
+// CharacterState is the state of a character after a CharacterGroup update
+type CharacterState struct {
+	Position    Vec3
+	Velocity    Vec3
+	GroundState GroundState
+}
+
+// CharacterState shares its memory layout with JoltCharacterState so states are written straight into Go memory
+var (
+	_ [unsafe.Sizeof(CharacterState{}) - unsafe.Sizeof(C.JoltCharacterState{})]struct{}
+	_ [unsafe.Sizeof(C.JoltCharacterState{}) - unsafe.Sizeof(CharacterState{})]struct{}
+	_ [unsafe.Offsetof(CharacterState{}.Velocity) - unsafe.Offsetof(C.JoltCharacterState{}.velocityX)]struct{}
+	_ [unsafe.Offsetof(C.JoltCharacterState{}.velocityX) - unsafe.Offsetof(CharacterState{}.Velocity)]struct{}
+	_ [unsafe.Offsetof(CharacterState{}.GroundState) - unsafe.Offsetof(C.JoltCharacterState{}.groundState)]struct{}
+	_ [unsafe.Offsetof(C.JoltCharacterState{}.groundState) - unsafe.Offsetof(CharacterState{}.GroundState)]struct{}
+)
+
+// CharacterGroup updates many characters in a single cgo call, split across the job system worker threads
+// (unless collision between them is enabled, see EnableCollision). Each worker batch uses its own temp
+// allocator, so the batches don't contend on the shared one.
+//
+// Characters in a group keep working as regular CharacterVirtuals (contacts, shape changes, ...); the group
+// only replaces their per-character Update calls. Like CharacterVirtual.Update, group updates must not run
+// concurrently with PhysicsSystem.Update.
+//
+// Example usage:
+//
+//	group := ps.CreateCharacterGroup()
+//	defer group.Destroy()
+//	for _, p := range players {
+//	    p.Character = group.CreateCharacter(settings, p.Spawn)
+//	}
+//
+//	velocities := make([]jolt.Vec3, 0, maxPlayers) // reused every tick
+//	states := make([]jolt.CharacterState, maxPlayers)
+//	for {
+//	    // velocities[i] belongs to group.Characters()[i]
+//	    velocities = velocities[:0]
+//	    for _, cv := range group.Characters() {
+//	        velocities = append(velocities, desiredVelocity(cv))
+//	    }
+//	    n := group.ExtendedUpdate(dt, jolt.Vec3{X: 0, Y: -9.81, Z: 0}, velocities, states)
+//	    for i, state := range states[:n] {
+//	        replicate(group.Characters()[i], state.Position, state.GroundState)
+//	    }
+//	}
+type CharacterGroup struct {
+	handle     C.JoltCharacterGroup
+	ps         *PhysicsSystem
+	characters []*CharacterVirtual
+}
+
+// CreateCharacterGroup creates an empty character group
+func (ps *PhysicsSystem) CreateCharacterGroup() *CharacterGroup {
+	return &CharacterGroup{
+		handle: C.JoltCreateCharacterGroup(ps.handle),
+		ps:     ps,
+	}
+}
+
+// CreateCharacter creates a virtual character and adds it to the group
+func (g *CharacterGroup) CreateCharacter(settings *CharacterVirtualSettings, position Vec3) *CharacterVirtual {
+	cv := g.ps.CreateCharacterVirtual(settings, position)
+	g.Add(cv)
+	return cv
+}
+
+// Add adds an existing character to the group (moving it out of its previous group, if any).
+// The character must belong to the group's physics system.
+func (g *CharacterGroup) Add(cv *CharacterVirtual) {
+	if cv.group == g {
+		return
+	}
+	if cv.group != nil {
+		cv.group.remove(cv)
+	}
+
+	cv.group = g
+	cv.groupIndex = int(C.JoltCharacterGroupAdd(g.handle, cv.handle))
+	g.characters = append(g.characters, cv)
+}
+
+// Remove takes a character out of the group without destroying it.
+// The last character of the group moves into the removed character's index.
+func (g *CharacterGroup) Remove(cv *CharacterVirtual) {
+	if cv.group == g {
+		g.remove(cv)
+	}
+}
+
+// remove swap-removes cv, mirroring JoltCharacterGroupRemove
+func (g *CharacterGroup) remove(cv *CharacterVirtual) {
+	index := cv.groupIndex
+	C.JoltCharacterGroupRemove(g.handle, C.int(index))
+
+	last := len(g.characters) - 1
+	g.characters[index] = g.characters[last]
+	g.characters[index].groupIndex = index
+	g.characters[last] = nil
+	g.characters = g.characters[:last]
+
+	cv.group = nil
+	cv.groupIndex = 0
+}
+
+// EnableCollision makes the characters of the group collide with each other (they pass through each other
+// by default). Once per update the characters are bucketed into a uniform grid of cellSize cells, so each
+// character only tests the characters near it and the cost grows linearly with the group size.
+// Pairs whose object layers don't collide are skipped.
+//
+// Parameters:
+//   - cellSize: edge length of a grid cell, about the size of a character (0 for the default of 2 units)
+//
+// Characters collide with where the other characters were before the update. Jolt reads the velocity of the
+// other character of a contact while the group updates, so a group with collision enabled updates all its
+// characters on the calling thread, in group order; that keeps the result deterministic. Calling it again
+// changes the cell size.
+func (g *CharacterGroup) EnableCollision(cellSize float32) {
+	C.JoltCharacterGroupSetCollision(g.handle, 1, C.float(cellSize))
+}
+
+// DisableCollision lets the characters of the group pass through each other again
+func (g *CharacterGroup) DisableCollision() {
+	C.JoltCharacterGroupSetCollision(g.handle, 0, 0)
+}
+
+// Characters returns the characters of the group in update order: the velocities and states passed to
+// Update and ExtendedUpdate are indexed the same way. The slice must not be modified and is only valid
+// until the group changes.
+func (g *CharacterGroup) Characters() []*CharacterVirtual {
+	return g.characters
+}
+
+// Len returns the number of characters in the group
+func (g *CharacterGroup) Len() int {
+	return len(g.characters)
+}
+
+// Update runs CharacterVirtual.Update for every character of the group in one call.
+//
+// Parameters:
+//   - deltaTime: duration of simulation step in seconds
+//   - gravity: acceleration vector, applied when standing on objects (apply gravity to the velocities yourself)
+//   - velocities: desired linear velocity of each character (nil, or shorter than the group: the remaining
+//     characters keep their current velocity)
+//   - states: receives the position, velocity and ground state of each character after the update
+//     (can be nil or shorter than the group)
+//
+// Returns the number of states written.
+func (g *CharacterGroup) Update(deltaTime float32, gravity Vec3, velocities []Vec3, states []CharacterState) int {
+	return g.update(deltaTime, gravity, velocities, states, false)
+}
+
+// ExtendedUpdate runs CharacterVirtual.ExtendedUpdate (Update combined with StickToFloor and WalkStairs)
+// for every character of the group in one call. Parameters and result are the same as for Update.
+func (g *CharacterGroup) ExtendedUpdate(deltaTime float32, gravity Vec3, velocities []Vec3, states []CharacterState) int {
+	return g.update(deltaTime, gravity, velocities, states, true)
+}
+
+func (g *CharacterGroup) update(deltaTime float32, gravity Vec3, velocities []Vec3, states []CharacterState, extended bool) int {
+	// Velocities and states are passed without conversion (Vec3 is three packed float32s)
+	var cVelocities *C.float
+	if len(velocities) > 0 {
+		cVelocities = (*C.float)(unsafe.Pointer(&velocities[0]))
+	}
+	var cStates *C.JoltCharacterState
+	if len(states) > 0 {
+		cStates = (*C.JoltCharacterState)(unsafe.Pointer(&states[0]))
+	}
+
+	numStates := C.JoltCharacterGroupUpdate(
+		g.handle,
+		C.float(deltaTime),
+		C.float(gravity.X),
+		C.float(gravity.Y),
+		C.float(gravity.Z),
+		cVelocities,
+		C.int(len(velocities)),
+		cStates,
+		C.int(len(states)),
+		C.int(boolToInt(extended)),
+		1,
+	)
+
+	return int(numStates)
+}
+
+// Destroy destroys the group and every character in it. Calling Destroy on one of its characters
+// afterwards does nothing.
+func (g *CharacterGroup) Destroy() {
+	for _, cv := range g.characters {
+		cv.group = nil
+		C.JoltDestroyCharacterVirtual(cv.handle)
+		cv.handle = nil
+	}
+	g.characters = nil
+	C.JoltDestroyCharacterGroup(g.handle)
 }
@@ -0,0 +1,274 @@
+package jolt
+
+import (
+	"testing"
+)
+
+// newCharacterTestWorld creates a world with a large static floor whose top is at Y=0
+func newCharacterTestWorld(t *testing.T) (*PhysicsSystem, *Shape) {
+	t.Helper()
+
+	ps := NewPhysicsSystem()
+	floor := CreateBox(Vec3{X: 100, Y: 0.5, Z: 100})
+	ps.GetBodyInterface().CreateBody(floor, Vec3{X: 0, Y: -0.5, Z: 0}, MotionTypeStatic, false)
+	floor.Destroy()
+
+	capsule := CreateCapsule(0.5, 0.3)
+	t.Cleanup(func() {
+		capsule.Destroy()
+		ps.Destroy()
+	})
+	return ps, capsule
+}
+
+func TestCharacterGroupMatchesSingleUpdates(t *testing.T) {
+	ps, capsule := newCharacterTestWorld(t)
+	settings := NewCharacterVirtualSettings(capsule)
+	settings.ShapeOffset = Vec3{X: 0, Y: 0.8, Z: 0}
+
+	// Characters don't collide with each other, so grouped and standalone characters can share positions
+	const numCharacters = 32
+	group := ps.CreateCharacterGroup()
+	defer group.Destroy()
+	single := make([]*CharacterVirtual, numCharacters)
+	for i := range single {
+		position := Vec3{X: float32(i%8) * 2, Y: 1, Z: float32(i/8) * 2}
+		group.CreateCharacter(settings, position)
+		single[i] = ps.CreateCharacterVirtual(settings, position)
+		defer single[i].Destroy()
+	}
+	if group.Len() != numCharacters {
+		t.Fatalf("group has %d characters, expected %d", group.Len(), numCharacters)
+	}
+
+	gravity := Vec3{X: 0, Y: -9.81, Z: 0}
+	velocities := make([]Vec3, numCharacters)
+	states := make([]CharacterState, numCharacters)
+	const dt = 1.0 / 60.0
+	for step := 0; step < 60; step++ {
+		for i, cv := range group.Characters() {
+			velocities[i] = Vec3{X: 1, Y: cv.GetLinearVelocity().Y - 9.81*dt, Z: 0}
+			if cv.IsSupported() {
+				velocities[i].Y = 0
+			}
+		}
+		if n := group.ExtendedUpdate(dt, gravity, velocities, states); n != numCharacters {
+			t.Fatalf("step %d: %d states, expected %d", step, n, numCharacters)
+		}
+
+		for i, cv := range single {
+			cv.SetLinearVelocity(velocities[i])
+			cv.ExtendedUpdate(dt, gravity)
+		}
+	}
+
+	for i, cv := range single {
+		if states[i].Position != cv.GetPosition() {
+			t.Errorf("character %d: group position %v, single position %v", i, states[i].Position, cv.GetPosition())
+		}
+		if states[i].GroundState != GroundStateOnGround {
+			t.Errorf("character %d: ground state %v, expected OnGround", i, states[i].GroundState)
+		}
+		if states[i].Position != group.Characters()[i].GetPosition() {
+			t.Errorf("character %d: state %v doesn't match the character", i, states[i].Position)
+		}
+	}
+}
+
+func TestCharacterGroupRemove(t *testing.T) {
+	ps, capsule := newCharacterTestWorld(t)
+	settings := NewCharacterVirtualSettings(capsule)
+
+	group := ps.CreateCharacterGroup()
+	defer group.Destroy()
+	a := group.CreateCharacter(settings, Vec3{X: 0, Y: 5, Z: 0})
+	group.CreateCharacter(settings, Vec3{X: 1, Y: 5, Z: 0})
+	c := group.CreateCharacter(settings, Vec3{X: 2, Y: 5, Z: 0})
+
+	// The last character takes the removed character's index
+	group.Remove(a)
+	defer a.Destroy()
+	if group.Len() != 2 || group.Characters()[0] != c {
+		t.Fatalf("after Remove: %d characters, first %v", group.Len(), group.Characters()[0])
+	}
+
+	// Destroying a member removes it from the group
+	c.Destroy()
+	if group.Len() != 1 {
+		t.Fatalf("after Destroy: %d characters, expected 1", group.Len())
+	}
+
+	// Only the first character gets the new velocity; the state buffer may be shorter than the group
+	group.Add(a)
+	states := make([]CharacterState, 1)
+	before := group.Characters()[1].GetLinearVelocity()
+	n := group.Update(1.0/60.0, Vec3{}, []Vec3{{X: 3, Y: 0, Z: 0}}, states)
+	if n != 1 || states[0].Velocity.X != 3 {
+		t.Errorf("Update wrote %d states, first %+v", n, states[0])
+	}
+	if v := group.Characters()[1].GetLinearVelocity(); v != before {
+		t.Errorf("second character velocity changed from %v to %v", before, v)
+	}
+}
+
+func TestCharacterGroupDestroyOwnsCharacters(t *testing.T) {
+	ps, capsule := newCharacterTestWorld(t)
+	settings := NewCharacterVirtualSettings(capsule)
+
+	group := ps.CreateCharacterGroup()
+	cv := group.CreateCharacter(settings, Vec3{X: 0, Y: 1, Z: 0})
+	defer cv.Destroy() // Must not free the character a second time
+
+	group.Destroy()
+	if cv.handle != nil {
+		t.Error("group should have released the character's handle")
+	}
+}
+
+func TestCharacterGroupCollision(t *testing.T) {
+	ps, capsule := newCharacterTestWorld(t)
+	settings := NewCharacterVirtualSettings(capsule)
+	settings.ShapeOffset = Vec3{X: 0, Y: 0.8, Z: 0}
+
+	// Two characters walking towards each other, plus a crowd far away that must not matter
+	group := ps.CreateCharacterGroup()
+	defer group.Destroy()
+	left := group.CreateCharacter(settings, Vec3{X: -2, Y: 0, Z: 0})
+	right := group.CreateCharacter(settings, Vec3{X: 2, Y: 0, Z: 0})
+	for i := 0; i < 100; i++ {
+		group.CreateCharacter(settings, Vec3{X: 50 + float32(i%10)*2, Y: 0, Z: float32(i/10) * 2})
+	}
+
+	run := func() float32 {
+		left.SetPosition(Vec3{X: -2, Y: 0, Z: 0})
+		right.SetPosition(Vec3{X: 2, Y: 0, Z: 0})
+		velocities := []Vec3{{X: 2, Y: 0, Z: 0}, {X: -2, Y: 0, Z: 0}}
+		for step := 0; step < 120; step++ {
+			group.Update(1.0/60.0, Vec3{X: 0, Y: -9.81, Z: 0}, velocities, nil)
+		}
+		return right.GetPosition().X - left.GetPosition().X
+	}
+
+	// Without collision the characters walk through each other
+	if gap := run(); gap > 0 {
+		t.Fatalf("characters without collision ended %v apart, expected them to pass each other", gap)
+	}
+
+	// With collision they stop about two radii (plus padding) apart
+	group.EnableCollision(0)
+	if gap := run(); gap < 2*0.3 {
+		t.Errorf("characters with collision ended %v apart, expected at least %v", gap, 2*0.3)
+	}
+
+	group.DisableCollision()
+	if gap := run(); gap > 0 {
+		t.Errorf("characters after DisableCollision ended %v apart, expected them to pass each other", gap)
+	}
+}
+
+func TestCharacterGroupCollisionDeterministic(t *testing.T) {
+	// A dense crowd pushing into each other, simulated twice from the same start
+	simulate := func() []CharacterState {
+		ps, capsule := newCharacterTestWorld(t)
+		settings := NewCharacterVirtualSettings(capsule)
+		settings.ShapeOffset = Vec3{X: 0, Y: 0.8, Z: 0}
+
+		group := ps.CreateCharacterGroup()
+		defer group.Destroy()
+		group.EnableCollision(0)
+		velocities := make([]Vec3, 256)
+		for i := range velocities {
+			pos := Vec3{X: float32(i%16) * 0.7, Y: 0, Z: float32(i/16) * 0.7}
+			group.CreateCharacter(settings, pos)
+			velocities[i] = Vec3{X: 4 - pos.X/2, Y: 0, Z: pos.Z/2 - 2}
+		}
+
+		states := make([]CharacterState, len(velocities))
+		for step := 0; step < 60; step++ {
+			group.Update(1.0/60.0, Vec3{X: 0, Y: -9.81, Z: 0}, velocities, states)
+		}
+		return states
+	}
+
+	first, second := simulate(), simulate()
+	for i := range first {
+		if first[i] != second[i] {
+			t.Fatalf("character %d: %+v, then %+v from the same start", i, first[i], second[i])
+		}
+	}
+}
+
+func TestCharacterExtendedUpdateSettings(t *testing.T) {
+	ps, capsule := newCharacterTestWorld(t)
+
+	// A 0.3 high step starting at X=1
+	step := CreateBox(Vec3{X: 1, Y: 0.15, Z: 5})
+	ps.GetBodyInterface().CreateBody(step, Vec3{X: 2, Y: 0.15, Z: 0}, MotionTypeStatic, false)
+	step.Destroy()
+
+	settings := NewCharacterVirtualSettings(capsule)
+	settings.ShapeOffset = Vec3{X: 0, Y: 0.8, Z: 0}
+
+	group := ps.CreateCharacterGroup()
+	defer group.Destroy()
+	climber := group.CreateCharacter(settings, Vec3{X: 0, Y: 0, Z: -2})
+	settings.ExtendedUpdate.WalkStairsStepUp = Vec3{}
+	blocked := group.CreateCharacter(settings, Vec3{X: 0, Y: 0, Z: 2})
+
+	// The same settings can be set after creation
+	settings.ExtendedUpdate = NewExtendedUpdateSettings()
+	single := ps.CreateCharacterVirtual(settings, Vec3{X: 0, Y: 0, Z: 0})
+	defer single.Destroy()
+	noStairs := NewExtendedUpdateSettings()
+	noStairs.WalkStairsStepUp = Vec3{}
+	single.SetExtendedUpdateSettings(&noStairs)
+
+	gravity := Vec3{X: 0, Y: -9.81, Z: 0}
+	velocities := []Vec3{{X: 2, Y: 0, Z: 0}, {X: 2, Y: 0, Z: 0}}
+	for i := 0; i < 120; i++ {
+		group.ExtendedUpdate(1.0/60.0, gravity, velocities, nil)
+		single.SetLinearVelocity(Vec3{X: 2, Y: 0, Z: 0})
+		single.ExtendedUpdate(1.0/60.0, gravity)
+	}
+
+	if pos := climber.GetPosition(); pos.X < 1.5 || pos.Y < 0.25 {
+		t.Errorf("character with stair walking ended at %v, expected on top of the step", pos)
+	}
+	if pos := blocked.GetPosition(); pos.X > 1 {
+		t.Errorf("character without stair walking ended at %v, expected in front of the step", pos)
+	}
+	if pos := single.GetPosition(); pos.X > 1 {
+		t.Errorf("character with stair walking disabled after creation ended at %v, expected in front of the step", pos)
+	}
+}
+
+func TestCharacterActiveContactsInto(t *testing.T) {
+	ps, capsule := newCharacterTestWorld(t)
+	settings := NewCharacterVirtualSettings(capsule)
+	settings.ShapeOffset = Vec3{X: 0, Y: 0.8, Z: 0}
+
+	character := ps.CreateCharacterVirtual(settings, Vec3{X: 0, Y: 0.1, Z: 0})
+	defer character.Destroy()
+	gravity := Vec3{X: 0, Y: -9.81, Z: 0}
+	for i := 0; i < 30; i++ {
+		character.Update(1.0/60.0, gravity)
+	}
+
+	contacts := make([]CharacterContact, 16)
+	n := character.GetActiveContactsInto(contacts)
+	if n == 0 {
+		t.Fatal("expected a contact with the floor")
+	}
+	if got := character.GetActiveContacts(16); len(got) != n || got[0] != contacts[0] {
+		t.Errorf("GetActiveContacts = %+v, GetActiveContactsInto = %+v", got, contacts[:n])
+	}
+
+	// Polling every tick reuses the scratch buffer
+	allocs := testing.AllocsPerRun(10, func() {
+		character.Update(1.0/60.0, gravity)
+		character.GetActiveContactsInto(contacts)
+	})
+	if allocs != 0 {
+		t.Errorf("update and contact polling allocated %v times per run, expected 0", allocs)
+	}
+}
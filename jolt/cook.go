@@ -0,0 +1,165 @@
+package jolt
+
+import (
+	"fmt"
+	"runtime"
+	"sync"
+)
+
+// Future holds the result of an asynchronous operation. It is completed exactly once; after that Wait returns
+// immediately and Ready reports true. A Future is safe to use from multiple goroutines.
+type Future[T any] struct {
+	done  chan struct{}
+	value T
+	err   error
+}
+
+func newFuture[T any]() *Future[T] {
+	return &Future[T]{done: make(chan struct{})}
+}
+
+func (f *Future[T]) complete(value T, err error) {
+	f.value = value
+	f.err = err
+	close(f.done)
+}
+
+// Done returns a channel that is closed when the result is available, for use in select statements
+func (f *Future[T]) Done() <-chan struct{} {
+	return f.done
+}
+
+// Ready reports whether the result is available, without blocking. Poll it from a game loop.
+func (f *Future[T]) Ready() bool {
+	select {
+	case <-f.done:
+		return true
+	default:
+		return false
+	}
+}
+
+// Wait blocks until the result is available and returns it
+func (f *Future[T]) Wait() (T, error) {
+	<-f.done
+	return f.value, f.err
+}
+
+// ShapeCooker builds convex hulls and meshes in the background, so the hull and BVH construction of streamed
+// map chunks never runs on the goroutine driving the simulation. Cooking runs on the cooker's own goroutines
+// (each holds an OS thread in cgo while it builds), separate from the worker threads of the physics job system,
+// and at most Workers shapes are built at the same time. Submitting never blocks.
+//
+// The input slices are read while the shape is being built: don't modify them until the future is ready.
+// Shapes that are never collected with Wait leak; release every cooked shape with Destroy as usual.
+//
+// Example usage:
+//
+//	cooker := jolt.NewShapeCooker(2)
+//	defer cooker.Close()
+//
+//	pending := cooker.CookMeshAsync(chunk.Vertices, chunk.Indices)
+//	for {
+//	    if pending != nil && pending.Ready() {
+//	        shape, err := pending.Wait() // doesn't block any more
+//	        if err == nil {
+//	            bi.CreateBody(shape, chunk.Origin, jolt.MotionTypeStatic, false)
+//	            shape.Destroy()
+//	        }
+//	        pending = nil
+//	    }
+//	    ps.Update(dt)
+//	}
+type ShapeCooker struct {
+	slots   chan struct{} // One token per worker that may be cooking
+	mu      sync.Mutex
+	closed  bool
+	pending sync.WaitGroup
+}
+
+// NewShapeCooker creates a cooker that builds at most workers shapes at the same time.
+// workers <= 0 uses half of runtime.GOMAXPROCS (at least one), leaving the rest for the simulation.
+func NewShapeCooker(workers int) *ShapeCooker {
+	if workers <= 0 {
+		workers = max(runtime.GOMAXPROCS(0)/2, 1)
+	}
+	return &ShapeCooker{slots: make(chan struct{}, workers)}
+}
+
+// Workers returns the maximum number of shapes cooked at the same time
+func (c *ShapeCooker) Workers() int {
+	return cap(c.slots)
+}
+
+// submit runs build on a cooking slot and completes the returned future with its result
+func (c *ShapeCooker) submit(build func() (*Shape, error)) *Future[*Shape] {
+	future := newFuture[*Shape]()
+
+	c.mu.Lock()
+	if c.closed {
+		c.mu.Unlock()
+		future.complete(nil, fmt.Errorf("shape cooker is closed"))
+		return future
+	}
+	c.pending.Add(1)
+	c.mu.Unlock()
+
+	go func() {
+		defer c.pending.Done()
+		c.slots <- struct{}{}
+		defer func() { <-c.slots }()
+
+		future.complete(build())
+	}()
+	return future
+}
+
+// CookMeshAsync builds a mesh shape from an indexed triangle list in the background (see CreateIndexedMesh)
+func (c *ShapeCooker) CookMeshAsync(vertices []float32, indices []uint32) *Future[*Shape] {
+	return c.submit(func() (*Shape, error) {
+		return CreateIndexedMesh(vertices, indices)
+	})
+}
+
+// CookConvexHullAsync builds a convex hull shape from packed xyz points in the background
+// (see CreateConvexHullFromPoints)
+func (c *ShapeCooker) CookConvexHullAsync(points []float32) *Future[*Shape] {
+	return c.submit(func() (*Shape, error) {
+		return CreateConvexHullFromPoints(points)
+	})
+}
+
+// Close waits for every submitted shape to finish cooking. Shapes submitted after Close fail immediately.
+// Call it before Shutdown.
+func (c *ShapeCooker) Close() {
+	c.mu.Lock()
+	c.closed = true
+	c.mu.Unlock()
+
+	c.pending.Wait()
+}
+
+var (
+	defaultCooker     *ShapeCooker
+	defaultCookerOnce sync.Once
+)
+
+// DefaultShapeCooker returns the cooker used by CookMeshAsync and CookConvexHullAsync, created on first use
+// with the default number of workers. It lives for the whole process, so don't Close it.
+func DefaultShapeCooker() *ShapeCooker {
+	defaultCookerOnce.Do(func() {
+		defaultCooker = NewShapeCooker(0)
+	})
+	return defaultCooker
+}
+
+// CookMeshAsync builds a mesh shape in the background on the default cooker (see ShapeCooker.CookMeshAsync)
+func CookMeshAsync(vertices []float32, indices []uint32) *Future[*Shape] {
+	return DefaultShapeCooker().CookMeshAsync(vertices, indices)
+}
+
+// CookConvexHullAsync builds a convex hull shape in the background on the default cooker
+// (see ShapeCooker.CookConvexHullAsync)
+func CookConvexHullAsync(points []float32) *Future[*Shape] {
+	return DefaultShapeCooker().CookConvexHullAsync(points)
+}
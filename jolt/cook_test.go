@@ -0,0 +1,48 @@
+package jolt
+
+import "testing"
+
+func TestShapeCookerBuildsShapes(t *testing.T) {
+	cooker := NewShapeCooker(2)
+
+	// A row of quads, each a separate chunk
+	var futures []*Future[*Shape]
+	for i := 0; i < 8; i++ {
+		x := float32(i) * 20
+		vertices := []float32{x - 10, 0, -10, x + 10, 0, -10, x + 10, 0, 10, x - 10, 0, 10}
+		futures = append(futures, cooker.CookMeshAsync(vertices, []uint32{0, 2, 1, 0, 3, 2}))
+	}
+	hull := cooker.CookConvexHullAsync([]float32{0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1})
+	bad := cooker.CookMeshAsync([]float32{0, 0, 0}, []uint32{0, 1, 2})
+
+	for i, f := range futures {
+		shape, err := f.Wait()
+		if err != nil {
+			t.Fatalf("chunk %d: %v", i, err)
+		}
+		if !f.Ready() {
+			t.Errorf("chunk %d: future should be ready after Wait", i)
+		}
+
+		ray := RRayCast{Origin: Vec3{X: float32(i) * 20, Y: 5, Z: 0}, Direction: Vec3{X: 0, Y: -10, Z: 0}}
+		var result RayCastResult
+		if !shape.CastRay(ray, DefaultRayCastSettings(), &result) {
+			t.Errorf("chunk %d: ray should hit the cooked mesh", i)
+		}
+		shape.Destroy()
+	}
+
+	if shape, err := hull.Wait(); err != nil {
+		t.Errorf("hull: %v", err)
+	} else {
+		shape.Destroy()
+	}
+	if _, err := bad.Wait(); err == nil {
+		t.Error("mesh with out of range indices should fail")
+	}
+
+	cooker.Close()
+	if _, err := cooker.CookConvexHullAsync([]float32{0, 0, 0}).Wait(); err == nil {
+		t.Error("cooking after Close should fail")
+	}
+}
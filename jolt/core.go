@@ -5,11 +5,106 @@ import "C"
 import (
 	"fmt"
 	"math"
+	"runtime"
 )
 
-// Init initializes Jolt Physics (call once at startup)
+// InitOptions configures the shared job system and temp allocator created by InitWithOptions
+type InitOptions struct {
+	// NumThreads is the number of worker threads in the shared pool. -1 uses one less than
+	// runtime.GOMAXPROCS, which follows the container CPU quota rather than the host CPU count (default: -1)
+	NumThreads int
+
+	// MaxJobs is the maximum number of jobs that can be in flight at once (default: 2048)
+	MaxJobs uint32
+
+	// MaxBarriers is the maximum number of concurrent waits on the job system, i.e. roughly the
+	// number of worlds that can be updated at the same time on the shared pool (default: 8)
+	MaxBarriers uint32
+
+	// TempAllocatorSize is the size in bytes of the shared temp allocator (default: 10 MB)
+	TempAllocatorSize uint32
+
+	// SingleThreaded runs all physics jobs on the calling goroutine's thread without any worker threads.
+	// For tiny worlds this is faster because handing work to other threads costs more than it saves (default: false)
+	SingleThreaded bool
+
+	// CPUAffinity optionally pins the worker threads: worker i runs on CPUAffinity[i % len(CPUAffinity)].
+	// Only supported on Linux; ignored elsewhere (default: nil, no pinning)
+	CPUAffinity []int
+
+	// EnableProfiler starts Jolt's profiler, which PhysicsSystem.ProfileNextUpdate needs. While it runs every
+	// profile scope of every update records a sample, so leave it off unless updates will be profiled.
+	// Has no effect with the jolt_perf libraries, which are built without the profiler (default: false)
+	EnableProfiler bool
+}
+
+// NewInitOptions creates options with the default values
+func NewInitOptions() *InitOptions {
+	return &InitOptions{
+		NumThreads:        -1,
+		MaxJobs:           2048,
+		MaxBarriers:       8,
+		TempAllocatorSize: 10 * 1024 * 1024,
+		SingleThreaded:    false,
+		CPUAffinity:       nil,
+		EnableProfiler:    false,
+	}
+}
+
+// Init initializes Jolt Physics with default options (call once at startup)
 func Init() error {
-	result := C.JoltInit()
+	return InitWithOptions(NewInitOptions())
+}
+
+// InitWithOptions initializes Jolt Physics with the given job system and allocator options
+// (call once at startup, instead of Init).
+//
+// Example usage:
+//
+//	// 4-CPU container: 3 workers pinned to CPUs 1-3, leaving CPU 0 for the Go scheduler
+//	opts := jolt.NewInitOptions()
+//	opts.NumThreads = 3
+//	opts.CPUAffinity = []int{1, 2, 3}
+//	if err := jolt.InitWithOptions(opts); err != nil {
+//	    panic(err)
+//	}
+//	defer jolt.Shutdown()
+func InitWithOptions(opts *InitOptions) error {
+	// The wrapper ABI is the same for both precisions, so a stale library in the lib directory
+	// would link fine and silently round positions
+	if (C.JoltIsDoublePrecision() != 0) != DoublePrecision {
+		return fmt.Errorf("native Jolt library precision does not match the jolt_double build tag")
+	}
+
+	numThreads := opts.NumThreads
+	if numThreads < 0 {
+		numThreads = max(runtime.GOMAXPROCS(0)-1, 0)
+	}
+
+	settings := C.JoltInitSettings{
+		numThreads:        C.int(numThreads),
+		maxJobs:           C.uint(opts.MaxJobs),
+		maxBarriers:       C.uint(opts.MaxBarriers),
+		tempAllocatorSize: C.uint(opts.TempAllocatorSize),
+		singleThreaded:    C.int(boolToInt(opts.SingleThreaded)),
+		enableProfiler:    C.int(boolToInt(opts.EnableProfiler)),
+	}
+
+	// The wrapper copies the CPU list, so a temporary C-compatible copy is enough.
+	// It is referenced from inside settings, so it has to be pinned for the duration of the call.
+	if len(opts.CPUAffinity) > 0 {
+		cpus := make([]C.int, len(opts.CPUAffinity))
+		for i, cpu := range opts.CPUAffinity {
+			cpus[i] = C.int(cpu)
+		}
+		var pinner runtime.Pinner
+		pinner.Pin(&cpus[0])
+		defer pinner.Unpin()
+		settings.cpuAffinity = &cpus[0]
+		settings.numCpuAffinity = C.int(len(cpus))
+	}
+
+	result := C.JoltInitWithSettings(&settings)
 	if result == 0 {
 		return fmt.Errorf("failed to initialize Jolt")
 	}
@@ -0,0 +1,75 @@
+package jolt
+
+import "testing"
+
+// reinit restarts Jolt with the given options for the rest of the test and restores the defaults afterwards
+func reinit(t *testing.T, opts *InitOptions) {
+	t.Helper()
+	Shutdown()
+	if err := InitWithOptions(opts); err != nil {
+		t.Fatal(err)
+	}
+	t.Cleanup(func() {
+		Shutdown()
+		if err := Init(); err != nil {
+			t.Fatal(err)
+		}
+	})
+}
+
+func TestInitWithOptions(t *testing.T) {
+	tests := []struct {
+		name string
+		opts func(*InitOptions)
+	}{
+		{"SingleThreaded", func(o *InitOptions) { o.SingleThreaded = true }},
+		{"NoWorkers", func(o *InitOptions) { o.NumThreads = 0 }},
+		{"PinnedWorkers", func(o *InitOptions) { o.NumThreads = 2; o.CPUAffinity = []int{0} }},
+	}
+
+	for _, tt := range tests {
+		t.Run(tt.name, func(t *testing.T) {
+			opts := NewInitOptions()
+			tt.opts(opts)
+			reinit(t, opts)
+
+			ps := newQueryTestWorld(t)
+			bi := ps.GetBodyInterface()
+			sphere := CreateSphere(0.5)
+			defer sphere.Destroy()
+			ball := bi.CreateBody(sphere, Vec3{X: 8, Y: 5, Z: 0}, MotionTypeDynamic, false)
+			bi.ActivateBody(ball)
+
+			for i := 0; i < 120; i++ {
+				ps.Update(1.0 / 60.0)
+			}
+			if y := bi.GetPosition(ball).Y; y > 1.1 {
+				t.Errorf("ball should have landed on the floor, at Y = %.2f", y)
+			}
+
+			// Parallel ray batches fall back to the calling thread when there are no workers
+			origins := []Vec3{{X: 0, Y: 10, Z: 0}}
+			directions := []Vec3{{X: 0, Y: -20, Z: 0}}
+			out := make([]RaycastHit, 1)
+			if ps.CastRayBatchParallel(origins, directions, out) != 1 {
+				t.Error("ray should hit")
+			}
+		})
+	}
+}
+
+func TestInitWithInvalidOptions(t *testing.T) {
+	opts := NewInitOptions()
+	opts.MaxJobs = 0
+
+	Shutdown()
+	defer func() {
+		Shutdown()
+		if err := Init(); err != nil {
+			t.Fatal(err)
+		}
+	}()
+	if err := InitWithOptions(opts); err == nil {
+		t.Error("expected an error for MaxJobs = 0")
+	}
+}
@@ -0,0 +1,125 @@
+package jolt
+
+// #include "wrapper/events.h"
+import "C"
+import "unsafe"
+
+// ContactEventType identifies what a ContactEvent reports
+type ContactEventType int32
+
+const (
+	// ContactEventAdded - Two bodies started touching
+	ContactEventAdded ContactEventType = C.JoltContactEventAdded
+	// ContactEventPersisted - Two bodies are still touching (reported every update while in contact)
+	ContactEventPersisted ContactEventType = C.JoltContactEventPersisted
+	// ContactEventRemoved - Two bodies stopped touching
+	ContactEventRemoved ContactEventType = C.JoltContactEventRemoved
+	// ContactEventActivated - A body woke up
+	ContactEventActivated ContactEventType = C.JoltContactEventActivated
+	// ContactEventDeactivated - A body went to sleep
+	ContactEventDeactivated ContactEventType = C.JoltContactEventDeactivated
+)
+
+// String returns a human-readable representation of the event type
+func (t ContactEventType) String() string {
+	switch t {
+	case ContactEventAdded:
+		return "Added"
+	case ContactEventPersisted:
+		return "Persisted"
+	case ContactEventRemoved:
+		return "Removed"
+	case ContactEventActivated:
+		return "Activated"
+	case ContactEventDeactivated:
+		return "Deactivated"
+	default:
+		return "Unknown"
+	}
+}
+
+// ContactEventMask selects which event types are recorded
+type ContactEventMask uint32
+
+const (
+	EventMaskContactAdded     ContactEventMask = 1 << ContactEventAdded
+	EventMaskContactPersisted ContactEventMask = 1 << ContactEventPersisted
+	EventMaskContactRemoved   ContactEventMask = 1 << ContactEventRemoved
+	EventMaskBodyActivated    ContactEventMask = 1 << ContactEventActivated
+	EventMaskBodyDeactivated  ContactEventMask = 1 << ContactEventDeactivated
+
+	// EventMaskDefault records everything except persisted contacts, which are reported every update
+	EventMaskDefault ContactEventMask = C.JOLT_EVENT_MASK_DEFAULT
+)
+
+// EventOverflowPolicy decides which events are kept when the event buffer fills up between drains
+type EventOverflowPolicy int
+
+const (
+	// EventOverflowDropNewest keeps the oldest events and discards new ones until the buffer is drained
+	EventOverflowDropNewest EventOverflowPolicy = C.JoltEventOverflowDropNewest
+	// EventOverflowOverwrite keeps the newest events, overwriting the oldest ones
+	EventOverflowOverwrite EventOverflowPolicy = C.JoltEventOverflowOverwrite
+)
+
+// ContactEvent is a contact or body activation event recorded during an update.
+// Contact events are reported per sub shape pair, so compound bodies can produce several events per body pair.
+type ContactEvent struct {
+	Type             ContactEventType
+	Body1            BodyID  // First body (the only body for activation events)
+	Body2            BodyID  // Second body (InvalidBodyID for activation events)
+	ContactPoint     Vec3    // First contact point on Body1 in world space (Added/Persisted only)
+	Normal           Vec3    // Contact normal in world space, pointing from Body1 to Body2 (Added/Persisted only)
+	PenetrationDepth float32 // Penetration depth (Added/Persisted only)
+}
+
+// ContactEvent shares its memory layout with JoltContactEvent so events are copied straight into Go memory.
+// Each pair of array types below fails to compile if the sizes or field offsets drift apart.
+var (
+	_ [unsafe.Sizeof(ContactEvent{}) - unsafe.Sizeof(C.JoltContactEvent{})]struct{}
+	_ [unsafe.Sizeof(C.JoltContactEvent{}) - unsafe.Sizeof(ContactEvent{})]struct{}
+	_ [unsafe.Offsetof(ContactEvent{}.ContactPoint) - unsafe.Offsetof(C.JoltContactEvent{}.contactPointX)]struct{}
+	_ [unsafe.Offsetof(C.JoltContactEvent{}.contactPointX) - unsafe.Offsetof(ContactEvent{}.ContactPoint)]struct{}
+	_ [unsafe.Offsetof(ContactEvent{}.PenetrationDepth) - unsafe.Offsetof(C.JoltContactEvent{}.penetrationDepth)]struct{}
+	_ [unsafe.Offsetof(C.JoltContactEvent{}.penetrationDepth) - unsafe.Offsetof(ContactEvent{}.PenetrationDepth)]struct{}
+)
+
+// DrainEvents copies the events recorded since the last call into dst, oldest first, in a single cgo call.
+// Events are only recorded if the world was created with PhysicsSystemSettings.EventBufferSize > 0.
+// Must not be called concurrently with Update or with body changes on this world.
+//
+// If more than len(dst) events are pending, the rest are returned by the next call.
+//
+// Returns:
+//   - n: number of events written to dst
+//   - dropped: number of events lost since the last call because the buffer was full
+//
+// Example usage:
+//
+//	settings := jolt.NewPhysicsSystemSettings()
+//	settings.EventBufferSize = 4096
+//	ps, _ := jolt.NewPhysicsSystemWithSettings(settings)
+//
+//	events := make([]jolt.ContactEvent, 4096) // allocated once
+//	for {
+//	    ps.Update(1.0 / 60.0)
+//	    n, dropped := ps.DrainEvents(events)
+//	    for _, ev := range events[:n] {
+//	        if ev.Type == jolt.ContactEventAdded {
+//	            onHit(ev.Body1, ev.Body2, ev.ContactPoint)
+//	        }
+//	    }
+//	    if dropped > 0 {
+//	        log.Printf("lost %d contact events", dropped)
+//	    }
+//	}
+func (ps *PhysicsSystem) DrainEvents(dst []ContactEvent) (n int, dropped uint64) {
+	var cEvents *C.JoltContactEvent
+	if len(dst) > 0 {
+		cEvents = (*C.JoltContactEvent)(unsafe.Pointer(&dst[0]))
+	}
+
+	var cDropped C.ulonglong
+	numEvents := C.JoltPhysicsSystemDrainEvents(ps.handle, cEvents, C.int(len(dst)), &cDropped)
+	return int(numEvents), uint64(cDropped)
+}
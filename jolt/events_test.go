@@ -0,0 +1,103 @@
+package jolt
+
+import "testing"
+
+// newEventTestWorld creates a world recording events with a floor and a ball dropped onto it
+func newEventTestWorld(t *testing.T, bufferSize uint32, mask ContactEventMask, overflow EventOverflowPolicy) (*PhysicsSystem, BodyID, BodyID) {
+	t.Helper()
+
+	settings := NewPhysicsSystemSettings()
+	settings.EventBufferSize = bufferSize
+	settings.EventMask = mask
+	settings.EventOverflow = overflow
+	ps, err := NewPhysicsSystemWithSettings(settings)
+	if err != nil {
+		t.Fatal(err)
+	}
+	t.Cleanup(ps.Destroy)
+
+	bi := ps.GetBodyInterface()
+	floorShape := CreateBox(Vec3{X: 10, Y: 0.5, Z: 10})
+	defer floorShape.Destroy()
+	sphere := CreateSphere(0.5)
+	defer sphere.Destroy()
+
+	floor := bi.CreateBody(floorShape, Vec3{}, MotionTypeStatic, false)
+	ball := bi.CreateBody(sphere, Vec3{X: 0, Y: 2, Z: 0}, MotionTypeDynamic, false)
+	bi.ActivateBody(ball)
+	return ps, floor, ball
+}
+
+func TestDrainEventsContactAdded(t *testing.T) {
+	ps, floor, ball := newEventTestWorld(t, 256, EventMaskDefault, EventOverflowDropNewest)
+
+	events := make([]ContactEvent, 256)
+	var got []ContactEvent
+	for i := 0; i < 120; i++ {
+		ps.Update(1.0 / 60.0)
+		n, dropped := ps.DrainEvents(events)
+		if dropped != 0 {
+			t.Fatalf("dropped %d events", dropped)
+		}
+		got = append(got, events[:n]...)
+	}
+
+	var activated, added bool
+	for _, ev := range got {
+		switch ev.Type {
+		case ContactEventActivated:
+			activated = activated || ev.Body1 == ball
+		case ContactEventAdded:
+			pair := (ev.Body1 == ball && ev.Body2 == floor) || (ev.Body1 == floor && ev.Body2 == ball)
+			if pair {
+				added = true
+				if ev.ContactPoint.Y > 0.6 || ev.ContactPoint.Y < 0.4 {
+					t.Errorf("contact point Y = %.2f, expected the floor surface at 0.5", ev.ContactPoint.Y)
+				}
+			}
+		case ContactEventPersisted:
+			t.Error("persisted events are not in the default mask")
+		}
+	}
+	if !activated {
+		t.Error("expected an activation event for the ball")
+	}
+	if !added {
+		t.Error("expected a contact added event between the ball and the floor")
+	}
+}
+
+func TestDrainEventsOverflow(t *testing.T) {
+	mask := EventMaskContactPersisted
+	for _, overflow := range []EventOverflowPolicy{EventOverflowDropNewest, EventOverflowOverwrite} {
+		ps, _, _ := newEventTestWorld(t, 4, mask, overflow)
+
+		// The ball rests on the floor and reports a persisted contact every update
+		for i := 0; i < 60; i++ {
+			ps.Update(1.0 / 60.0)
+		}
+
+		events := make([]ContactEvent, 16)
+		n, dropped := ps.DrainEvents(events)
+		if n != 4 {
+			t.Errorf("overflow %d: drained %d events, expected the buffer size 4", overflow, n)
+		}
+		if dropped == 0 {
+			t.Errorf("overflow %d: expected dropped events", overflow)
+		}
+
+		// Draining resets the buffer and the drop counter
+		if n, dropped := ps.DrainEvents(events); n != 0 || dropped != 0 {
+			t.Errorf("overflow %d: second drain returned %d events, %d dropped", overflow, n, dropped)
+		}
+	}
+}
+
+func TestDrainEventsDisabled(t *testing.T) {
+	ps := newQueryTestWorld(t)
+	ps.Update(1.0 / 60.0)
+
+	if n, dropped := ps.DrainEvents(make([]ContactEvent, 8)); n != 0 || dropped != 0 {
+		t.Errorf("world without an event buffer returned %d events, %d dropped", n, dropped)
+	}
+}
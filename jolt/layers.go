@@ -0,0 +1,99 @@
+package jolt
+
+// #include "wrapper/physics.h"
+// #include "wrapper/body.h"
+import "C"
+import "fmt"
+
+// ObjectLayer is the collision layer a body lives in. Which layers collide with each other, and which
+// broadphase tree each layer is stored in, is set per world with PhysicsSystemSettings.ObjectLayers.
+type ObjectLayer uint16
+
+const (
+	// ObjectLayerNonMoving is the layer of static bodies in the default layer table
+	ObjectLayerNonMoving ObjectLayer = C.JOLT_OBJECT_LAYER_NON_MOVING
+	// ObjectLayerMoving is the layer of kinematic and dynamic bodies in the default layer table
+	ObjectLayerMoving ObjectLayer = C.JOLT_OBJECT_LAYER_MOVING
+
+	// ObjectLayerFromMotionType picks ObjectLayerNonMoving for static bodies and ObjectLayerMoving otherwise
+	ObjectLayerFromMotionType ObjectLayer = 0xffff
+
+	// MaxObjectLayers is the maximum number of object layers in a layer table
+	MaxObjectLayers = C.JOLT_MAX_OBJECT_LAYERS
+	// MaxBroadPhaseLayers is the maximum number of broadphase layers in a layer table
+	MaxBroadPhaseLayers = C.JOLT_MAX_BROADPHASE_LAYERS
+)
+
+// ObjectLayerMask is a set of object layers (bit i set = layer i is in the set)
+type ObjectLayerMask uint32
+
+// AllObjectLayers contains every object layer
+const AllObjectLayers ObjectLayerMask = C.JOLT_ALL_OBJECT_LAYERS
+
+// Mask returns the mask containing only this layer
+func (l ObjectLayer) Mask() ObjectLayerMask {
+	if l >= MaxObjectLayers {
+		return 0
+	}
+	return 1 << l
+}
+
+// LayerMask returns the mask containing the given layers
+func LayerMask(layers ...ObjectLayer) ObjectLayerMask {
+	var mask ObjectLayerMask
+	for _, l := range layers {
+		mask |= l.Mask()
+	}
+	return mask
+}
+
+// ObjectLayerConfig describes one object layer of a layer table
+type ObjectLayerConfig struct {
+	// BroadPhaseLayer is the broadphase tree bodies of this layer are stored in [0, MaxBroadPhaseLayers).
+	// Layers that are rarely queried together belong in different trees, so a query for one skips the other.
+	BroadPhaseLayer uint8
+
+	// CollidesWith is the set of layers this layer may collide with. Two layers only collide if both
+	// list each other, so the table is always symmetric.
+	CollidesWith ObjectLayerMask
+}
+
+// DefaultObjectLayers returns the default layer table: ObjectLayerNonMoving only collides with
+// ObjectLayerMoving, ObjectLayerMoving collides with everything, and each has its own broadphase tree
+func DefaultObjectLayers() []ObjectLayerConfig {
+	return []ObjectLayerConfig{
+		ObjectLayerNonMoving: {BroadPhaseLayer: 0, CollidesWith: ObjectLayerMoving.Mask()},
+		ObjectLayerMoving:    {BroadPhaseLayer: 1, CollidesWith: LayerMask(ObjectLayerNonMoving, ObjectLayerMoving)},
+	}
+}
+
+// fillLayerTable copies a layer table (indexed by object layer) into the C settings.
+// An empty table selects the wrapper's default table.
+func fillLayerTable(layers []ObjectLayerConfig, out *C.JoltPhysicsSystemSettings) error {
+	if len(layers) > MaxObjectLayers {
+		return fmt.Errorf("too many object layers: %d (max %d)", len(layers), MaxObjectLayers)
+	}
+
+	numBroadPhaseLayers := 0
+	for i, layer := range layers {
+		if layer.BroadPhaseLayer >= MaxBroadPhaseLayers {
+			return fmt.Errorf("object layer %d: broadphase layer %d out of range (max %d)",
+				i, layer.BroadPhaseLayer, MaxBroadPhaseLayers-1)
+		}
+		numBroadPhaseLayers = max(numBroadPhaseLayers, int(layer.BroadPhaseLayer)+1)
+
+		out.objectLayerMasks[i] = C.uint(layer.CollidesWith)
+		out.objectToBroadPhaseLayer[i] = C.uchar(layer.BroadPhaseLayer)
+	}
+	out.numObjectLayers = C.uint(len(layers))
+	out.numBroadPhaseLayers = C.uint(numBroadPhaseLayers)
+	return nil
+}
+
+// cObjectLayer converts a body layer for the wrapper (ObjectLayerFromMotionType maps to the C sentinel)
+func cObjectLayer(layer ObjectLayer) C.int {
+	if layer == ObjectLayerFromMotionType {
+		return C.JOLT_OBJECT_LAYER_FROM_MOTION_TYPE
+	}
+	return C.int(layer)
+}
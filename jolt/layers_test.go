@@ -0,0 +1,116 @@
+package jolt
+
+import "testing"
+
+const (
+	testLayerTerrain ObjectLayer = iota
+	testLayerPlayer
+	testLayerDebris
+)
+
+// newLayerTestWorld creates a world where debris collides with terrain but not with players
+func newLayerTestWorld(t *testing.T) *PhysicsSystem {
+	t.Helper()
+
+	settings := NewPhysicsSystemSettings()
+	settings.ObjectLayers = []ObjectLayerConfig{
+		testLayerTerrain: {BroadPhaseLayer: 0, CollidesWith: LayerMask(testLayerPlayer, testLayerDebris)},
+		// Players list every layer, but debris doesn't list players, so that pair never collides
+		testLayerPlayer: {BroadPhaseLayer: 1, CollidesWith: AllObjectLayers},
+		testLayerDebris: {BroadPhaseLayer: 2, CollidesWith: LayerMask(testLayerTerrain, testLayerDebris)},
+	}
+	ps, err := NewPhysicsSystemWithSettings(settings)
+	if err != nil {
+		t.Fatal(err)
+	}
+	t.Cleanup(ps.Destroy)
+	return ps
+}
+
+func TestLayerTableCollisionMatrix(t *testing.T) {
+	ps := newLayerTestWorld(t)
+	bi := ps.GetBodyInterface()
+
+	floorShape := CreateBox(Vec3{X: 10, Y: 0.5, Z: 10})
+	defer floorShape.Destroy()
+	box := CreateBox(Vec3{X: 2, Y: 0.25, Z: 2})
+	defer box.Destroy()
+	sphere := CreateSphere(0.5)
+	defer sphere.Destroy()
+
+	bi.CreateBodyInLayer(floorShape, Vec3{}, MotionTypeStatic, false, testLayerTerrain)
+
+	// A static player platform sits between the debris and the floor; debris must fall through it
+	bi.CreateBodyInLayer(box, Vec3{X: 0, Y: 3, Z: 0}, MotionTypeStatic, false, testLayerPlayer)
+	debris := bi.CreateBodyInLayer(sphere, Vec3{X: 0, Y: 5, Z: 0}, MotionTypeDynamic, false, testLayerDebris)
+	bi.ActivateBody(debris)
+
+	for i := 0; i < 180; i++ {
+		ps.Update(1.0 / 60.0)
+	}
+
+	if y := bi.GetPosition(debris).Y; y > 1.5 || y < 0.5 {
+		t.Errorf("debris Y = %.2f, expected it to pass the player platform and rest on the terrain at ~1.0", y)
+	}
+}
+
+func TestQueryLayerMask(t *testing.T) {
+	ps := newLayerTestWorld(t)
+	bi := ps.GetBodyInterface()
+
+	floorShape := CreateBox(Vec3{X: 10, Y: 0.5, Z: 10})
+	defer floorShape.Destroy()
+	sphere := CreateSphere(1.0)
+	defer sphere.Destroy()
+
+	floor := bi.CreateBodyInLayer(floorShape, Vec3{}, MotionTypeStatic, false, testLayerTerrain)
+	debris := bi.CreateBodyInLayer(sphere, Vec3{X: 0, Y: 5, Z: 0}, MotionTypeStatic, false, testLayerDebris)
+
+	origin := Vec3{X: 0, Y: 10, Z: 0}
+	direction := Vec3{X: 0, Y: -20, Z: 0}
+
+	// Unfiltered rays hit the debris sphere first
+	if hit, ok := ps.CastRay(origin, direction); !ok || hit.BodyID != debris {
+		t.Fatalf("unfiltered ray hit %v (%v), expected the debris sphere", hit.BodyID, ok)
+	}
+
+	opts := NewQueryOptions()
+	opts.LayerMask = testLayerTerrain.Mask()
+	if hit, ok := ps.CastRayWithOptions(origin, direction, opts); !ok || hit.BodyID != floor {
+		t.Errorf("terrain-only ray hit %v (%v), expected the floor", hit.BodyID, ok)
+	}
+
+	hits := make([]RaycastHit, 4)
+	if n := ps.CastRayGetHitsIntoWithOptions(origin, direction, hits, opts); n != 1 || hits[0].BodyID != floor {
+		t.Errorf("terrain-only ray returned %d hits (%v), expected just the floor", n, hits[:n])
+	}
+
+	out := make([]RaycastHit, 1)
+	if n := ps.CastRayBatchWithOptions([]Vec3{origin}, []Vec3{direction}, out, opts); n != 1 || out[0].BodyID != floor {
+		t.Errorf("terrain-only batch ray hit %v, expected the floor", out[0].BodyID)
+	}
+
+	probe := CreateSphere(0.5)
+	defer probe.Destroy()
+	opts.LayerMask = testLayerPlayer.Mask()
+	if ps.CollideShapeWithOptions(probe, Vec3{X: 0, Y: 5, Z: 0}, 0, opts) {
+		t.Error("player-only overlap should not see the debris sphere")
+	}
+}
+
+func TestLayerTableInvalid(t *testing.T) {
+	tests := map[string][]ObjectLayerConfig{
+		"too many layers":            make([]ObjectLayerConfig, MaxObjectLayers+1),
+		"broadphase layer too large": {{BroadPhaseLayer: MaxBroadPhaseLayers, CollidesWith: AllObjectLayers}},
+	}
+	for name, layers := range tests {
+		t.Run(name, func(t *testing.T) {
+			settings := NewPhysicsSystemSettings()
+			settings.ObjectLayers = layers
+			if ps, err := NewPhysicsSystemWithSettings(settings); err == nil {
+				ps.Destroy()
+				t.Fatal("expected an error")
+			}
+		})
+	}
+}
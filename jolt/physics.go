@@ -2,24 +2,364 @@ package jolt
 
 // #include "wrapper/physics.h"
 import "C"
+import (
+	"fmt"
+	"strings"
+)
 
 // PhysicsSystem represents a physics simulation world
 type PhysicsSystem struct {
 	handle C.JoltPhysicsSystem
 }
 
-// NewPhysicsSystem creates a new physics world
+// PhysicsSystemSettings configures the capacity and solver behaviour of a physics world.
+// Capacity limits are preallocated when the world is created, so size them to the expected load.
+type PhysicsSystemSettings struct {
+	// MaxBodies is the maximum number of bodies the world can hold (default: 10240)
+	MaxBodies uint32
+
+	// NumBodyMutexes is the number of mutexes protecting the bodies; more mutexes means less
+	// lock contention between threads. 0 picks a default based on the CPU count (default: 0)
+	NumBodyMutexes uint32
+
+	// MaxBodyPairs is the maximum number of body pairs the broadphase finds per update.
+	// Pairs beyond this limit are ignored (default: 65536)
+	MaxBodyPairs uint32
+
+	// MaxContactConstraints is the maximum number of contact constraints per update.
+	// Contacts beyond this limit are ignored (default: 20480)
+	MaxContactConstraints uint32
+
+	// Gravity is the acceleration applied to dynamic bodies (default: {0, -9.81, 0})
+	Gravity Vec3
+
+	// NumVelocitySteps is the number of velocity solver iterations (default: 10)
+	NumVelocitySteps uint32
+
+	// NumPositionSteps is the number of position solver iterations (default: 2)
+	NumPositionSteps uint32
+
+	// Baumgarte is the fraction of position error fixed per step [0, 1] (default: 0.2)
+	Baumgarte float32
+
+	// SpeculativeContactDistance is the radius around objects inside which speculative contacts are detected (default: 0.02)
+	SpeculativeContactDistance float32
+
+	// PenetrationSlop is how much bodies are allowed to sink into each other (default: 0.02)
+	PenetrationSlop float32
+
+	// LinearCastThreshold is the fraction of its inner radius a body must move per step to enable continuous collision detection (default: 0.75)
+	LinearCastThreshold float32
+
+	// LinearCastMaxPenetration is the fraction of its inner radius a body may penetrate another body when using continuous collision detection (default: 0.25)
+	LinearCastMaxPenetration float32
+
+	// MaxPenetrationDistance is the maximum distance the position solver corrects in a single step (default: 0.2)
+	MaxPenetrationDistance float32
+
+	// MinVelocityForRestitution is the minimum velocity needed before restitution is applied (default: 1.0)
+	MinVelocityForRestitution float32
+
+	// ConstraintWarmStart starts the solver with the impulses of the previous frame (default: true)
+	ConstraintWarmStart bool
+
+	// UseBodyPairContactCache reuses the contacts of body pairs that barely moved (default: true)
+	UseBodyPairContactCache bool
+
+	// UseLargeIslandSplitter splits large islands so they can be solved in parallel (default: true)
+	UseLargeIslandSplitter bool
+
+	// DeterministicSimulation keeps the simulation deterministic at some performance cost (default: true)
+	DeterministicSimulation bool
+
+	// AllowSleeping lets bodies that come to rest go to sleep (default: true)
+	AllowSleeping bool
+
+	// TimeBeforeSleep is how long in seconds a body must be nearly motionless before it goes to sleep (default: 0.5)
+	TimeBeforeSleep float32
+
+	// PointVelocitySleepThreshold is the velocity of body points below which a body may go to sleep (default: 0.03)
+	PointVelocitySleepThreshold float32
+
+	// TempAllocatorSize is the size in bytes of scratch memory owned by this world. Worlds with their own
+	// allocator can be updated concurrently from different goroutines; with 0 the world uses the shared
+	// allocator created by Init and updates of such worlds are serialized (default: 0)
+	TempAllocatorSize uint32
+
+	// JobThreads is the number of worker threads owned by this world. With 0 the world uses the shared
+	// thread pool created by Init, which can serve several worlds at once (default: 0)
+	JobThreads uint32
+
+	// EventBufferSize is the number of contact and activation events buffered between DrainEvents calls.
+	// 0 disables event recording entirely (default: 0)
+	EventBufferSize uint32
+
+	// EventMask selects the event types to record (default: EventMaskDefault)
+	EventMask ContactEventMask
+
+	// EventOverflow decides which events are kept when the buffer fills up (default: EventOverflowDropNewest)
+	EventOverflow EventOverflowPolicy
+
+	// ObjectLayers is the layer table, indexed by ObjectLayer: which layers collide with each other and which
+	// broadphase tree each layer uses. Empty selects the default table (default: DefaultObjectLayers())
+	ObjectLayers []ObjectLayerConfig
+}
+
+// NewPhysicsSystemSettings creates settings with the wrapper's default capacity and Jolt's default solver settings
+func NewPhysicsSystemSettings() *PhysicsSystemSettings {
+	// The wrapper fills in the defaults, so the solver settings follow Jolt's PhysicsSettings
+	var c C.JoltPhysicsSystemSettings
+	C.JoltPhysicsSystemDefaultSettings(&c)
+
+	return &PhysicsSystemSettings{
+		MaxBodies:                   uint32(c.maxBodies),
+		NumBodyMutexes:              uint32(c.numBodyMutexes),
+		MaxBodyPairs:                uint32(c.maxBodyPairs),
+		MaxContactConstraints:       uint32(c.maxContactConstraints),
+		Gravity:                     Vec3{X: float32(c.gravityX), Y: float32(c.gravityY), Z: float32(c.gravityZ)},
+		NumVelocitySteps:            uint32(c.numVelocitySteps),
+		NumPositionSteps:            uint32(c.numPositionSteps),
+		Baumgarte:                   float32(c.baumgarte),
+		SpeculativeContactDistance:  float32(c.speculativeContactDistance),
+		PenetrationSlop:             float32(c.penetrationSlop),
+		LinearCastThreshold:         float32(c.linearCastThreshold),
+		LinearCastMaxPenetration:    float32(c.linearCastMaxPenetration),
+		MaxPenetrationDistance:      float32(c.maxPenetrationDistance),
+		MinVelocityForRestitution:   float32(c.minVelocityForRestitution),
+		ConstraintWarmStart:         c.constraintWarmStart != 0,
+		UseBodyPairContactCache:     c.useBodyPairContactCache != 0,
+		UseLargeIslandSplitter:      c.useLargeIslandSplitter != 0,
+		DeterministicSimulation:     c.deterministicSimulation != 0,
+		AllowSleeping:               c.allowSleeping != 0,
+		TimeBeforeSleep:             float32(c.timeBeforeSleep),
+		PointVelocitySleepThreshold: float32(c.pointVelocitySleepThreshold),
+		TempAllocatorSize:           uint32(c.tempAllocatorSize),
+		JobThreads:                  uint32(c.jobThreads),
+		EventBufferSize:             uint32(c.eventCapacity),
+		EventMask:                   ContactEventMask(c.eventMask),
+		EventOverflow:               EventOverflowPolicy(c.eventOverflowPolicy),
+		ObjectLayers:                DefaultObjectLayers(),
+	}
+}
+
+// NewPhysicsSystem creates a new physics world with default settings
 func NewPhysicsSystem() *PhysicsSystem {
 	handle := C.JoltCreatePhysicsSystem()
 	return &PhysicsSystem{handle: handle}
 }
 
+// NewPhysicsSystemWithSettings creates a new physics world with the given capacity and solver settings.
+// Returns an error if the settings are invalid (e.g. MaxBodies is 0).
+//
+// Example usage:
+//
+//	settings := jolt.NewPhysicsSystemSettings()
+//	settings.MaxBodies = 65536
+//	settings.MaxBodyPairs = 262144
+//	settings.MaxContactConstraints = 131072
+//	ps, err := jolt.NewPhysicsSystemWithSettings(settings)
+//	if err != nil {
+//	    panic(err)
+//	}
+//	defer ps.Destroy()
+//
+//	// One world per match, each stepped by its own goroutine
+//	settings = jolt.NewPhysicsSystemSettings()
+//	settings.MaxBodies = 2048
+//	settings.TempAllocatorSize = 4 * 1024 * 1024
+//	match, err := jolt.NewPhysicsSystemWithSettings(settings)
+//
+//	// Custom layers: terrain and debris get their own broadphase trees, so a terrain-only ray
+//	// never walks the debris tree, and debris doesn't collide with players
+//	const (
+//	    LayerTerrain jolt.ObjectLayer = iota
+//	    LayerPlayer
+//	    LayerDebris
+//	)
+//	settings = jolt.NewPhysicsSystemSettings()
+//	settings.ObjectLayers = []jolt.ObjectLayerConfig{
+//	    LayerTerrain: {BroadPhaseLayer: 0, CollidesWith: jolt.LayerMask(LayerPlayer, LayerDebris)},
+//	    LayerPlayer:  {BroadPhaseLayer: 1, CollidesWith: jolt.LayerMask(LayerTerrain, LayerPlayer)},
+//	    LayerDebris:  {BroadPhaseLayer: 2, CollidesWith: jolt.LayerMask(LayerTerrain, LayerDebris)},
+//	}
+//	ps, err = jolt.NewPhysicsSystemWithSettings(settings)
+func NewPhysicsSystemWithSettings(settings *PhysicsSystemSettings) (*PhysicsSystem, error) {
+	cSettings := C.JoltPhysicsSystemSettings{
+		maxBodies:                   C.uint(settings.MaxBodies),
+		numBodyMutexes:              C.uint(settings.NumBodyMutexes),
+		maxBodyPairs:                C.uint(settings.MaxBodyPairs),
+		maxContactConstraints:       C.uint(settings.MaxContactConstraints),
+		gravityX:                    C.float(settings.Gravity.X),
+		gravityY:                    C.float(settings.Gravity.Y),
+		gravityZ:                    C.float(settings.Gravity.Z),
+		numVelocitySteps:            C.uint(settings.NumVelocitySteps),
+		numPositionSteps:            C.uint(settings.NumPositionSteps),
+		baumgarte:                   C.float(settings.Baumgarte),
+		speculativeContactDistance:  C.float(settings.SpeculativeContactDistance),
+		penetrationSlop:             C.float(settings.PenetrationSlop),
+		linearCastThreshold:         C.float(settings.LinearCastThreshold),
+		linearCastMaxPenetration:    C.float(settings.LinearCastMaxPenetration),
+		maxPenetrationDistance:      C.float(settings.MaxPenetrationDistance),
+		minVelocityForRestitution:   C.float(settings.MinVelocityForRestitution),
+		constraintWarmStart:         C.int(boolToInt(settings.ConstraintWarmStart)),
+		useBodyPairContactCache:     C.int(boolToInt(settings.UseBodyPairContactCache)),
+		useLargeIslandSplitter:      C.int(boolToInt(settings.UseLargeIslandSplitter)),
+		deterministicSimulation:     C.int(boolToInt(settings.DeterministicSimulation)),
+		allowSleeping:               C.int(boolToInt(settings.AllowSleeping)),
+		timeBeforeSleep:             C.float(settings.TimeBeforeSleep),
+		pointVelocitySleepThreshold: C.float(settings.PointVelocitySleepThreshold),
+		tempAllocatorSize:           C.uint(settings.TempAllocatorSize),
+		jobThreads:                  C.uint(settings.JobThreads),
+		eventCapacity:               C.uint(settings.EventBufferSize),
+		eventMask:                   C.uint(settings.EventMask),
+		eventOverflowPolicy:         C.int(settings.EventOverflow),
+	}
+	if err := fillLayerTable(settings.ObjectLayers, &cSettings); err != nil {
+		return nil, err
+	}
+
+	handle := C.JoltCreatePhysicsSystemWithSettings(&cSettings)
+	if handle == nil {
+		return nil, fmt.Errorf("invalid physics system settings (max bodies %d, max body pairs %d, max contact constraints %d)",
+			settings.MaxBodies, settings.MaxBodyPairs, settings.MaxContactConstraints)
+	}
+	return &PhysicsSystem{handle: handle}, nil
+}
+
 // Destroy frees the physics system
 func (ps *PhysicsSystem) Destroy() {
 	C.JoltDestroyPhysicsSystem(ps.handle)
 }
 
-// Update advances the simulation by deltaTime seconds
+// Update advances the simulation by deltaTime seconds.
+// Different worlds can be updated from different goroutines at the same time; they only run in parallel
+// if they own their temp allocator (see PhysicsSystemSettings.TempAllocatorSize).
 func (ps *PhysicsSystem) Update(deltaTime float32) {
 	C.JoltPhysicsSystemUpdate(ps.handle, C.float(deltaTime))
 }
+
+// PhysicsUpdateError is a set of flags reporting what an update had to drop because a capacity limit was reached
+type PhysicsUpdateError uint32
+
+const (
+	// UpdateErrorManifoldCacheFull means contact manifolds were dropped; increase MaxContactConstraints
+	UpdateErrorManifoldCacheFull PhysicsUpdateError = C.JOLT_UPDATE_ERROR_MANIFOLD_CACHE_FULL
+	// UpdateErrorBodyPairCacheFull means body pairs were dropped; increase MaxBodyPairs
+	UpdateErrorBodyPairCacheFull PhysicsUpdateError = C.JOLT_UPDATE_ERROR_BODY_PAIR_CACHE_FULL
+	// UpdateErrorContactConstraintsFull means contact constraints were dropped; increase MaxContactConstraints
+	UpdateErrorContactConstraintsFull PhysicsUpdateError = C.JOLT_UPDATE_ERROR_CONTACT_CONSTRAINTS_FULL
+)
+
+// String returns a human-readable list of the error flags
+func (e PhysicsUpdateError) String() string {
+	if e == 0 {
+		return "None"
+	}
+	var names []string
+	if e&UpdateErrorManifoldCacheFull != 0 {
+		names = append(names, "ManifoldCacheFull")
+	}
+	if e&UpdateErrorBodyPairCacheFull != 0 {
+		names = append(names, "BodyPairCacheFull")
+	}
+	if e&UpdateErrorContactConstraintsFull != 0 {
+		names = append(names, "ContactConstraintsFull")
+	}
+	return strings.Join(names, "|")
+}
+
+// UpdateWithCollisionSteps advances the simulation by deltaTime seconds, split into collisionSteps collision steps.
+// At low tick rates, fast objects can tunnel or collide late; more collision steps fix that for less than the
+// cost of calling Update several times with a smaller deltaTime.
+//
+// Returns the error flags of the update (0 if nothing was dropped).
+//
+// Example usage:
+//
+//	// 30 Hz server tick with 2 collision steps for fast projectiles
+//	if errs := ps.UpdateWithCollisionSteps(1.0/30.0, 2); errs != 0 {
+//	    log.Printf("physics update dropped work: %v", errs)
+//	}
+func (ps *PhysicsSystem) UpdateWithCollisionSteps(deltaTime float32, collisionSteps int) PhysicsUpdateError {
+	return PhysicsUpdateError(C.JoltPhysicsSystemUpdateWithCollisionSteps(ps.handle, C.float(deltaTime), C.int(collisionSteps)))
+}
+
+// FixedTimestep steps a physics world at a fixed rate from variable wall-clock frame times.
+// All the steps due in a frame run inside a single cgo call.
+type FixedTimestep struct {
+	// StepSize is the duration of one simulation step in seconds
+	StepSize float32
+
+	// CollisionSteps is the number of collision steps per simulation step; 0 means 1 (default: 1)
+	CollisionSteps int
+
+	// MaxStepsPerFrame caps the steps run by one Advance call. When a frame takes so long that more steps are due,
+	// the extra time is dropped so the simulation catches up instead of falling further behind. 0 uses the
+	// default, so a FixedTimestep{StepSize: ...} literal works too (default: 8)
+	MaxStepsPerFrame int
+
+	// UpdateErrors holds the combined error flags of the steps run by the last Advance call
+	UpdateErrors PhysicsUpdateError
+
+	accumulator float64
+}
+
+// NewFixedTimestep creates a stepper running steps of stepSize seconds
+func NewFixedTimestep(stepSize float32) *FixedTimestep {
+	return &FixedTimestep{
+		StepSize:         stepSize,
+		CollisionSteps:   1,
+		MaxStepsPerFrame: 8,
+	}
+}
+
+// Advance adds elapsed seconds of wall-clock time and runs all whole steps that are due.
+//
+// Returns:
+//   - steps: number of simulation steps that were run
+//   - alpha: fraction of a step that is left over [0, 1), used to interpolate rendered state between
+//     the previous and the current simulation state
+//
+// Example usage:
+//
+//	stepper := jolt.NewFixedTimestep(1.0 / 60.0)
+//	last := time.Now()
+//	for {
+//	    now := time.Now()
+//	    _, alpha := stepper.Advance(ps, now.Sub(last).Seconds())
+//	    last = now
+//	    render(alpha)
+//	}
+func (ft *FixedTimestep) Advance(ps *PhysicsSystem, elapsed float64) (steps int, alpha float32) {
+	var cAccumulator C.double = C.double(ft.accumulator)
+	var cAlpha C.float
+	var cErrors C.int
+
+	numSteps := C.JoltPhysicsSystemStepFixed(
+		ps.handle,
+		C.double(elapsed),
+		C.float(ft.StepSize),
+		C.int(ft.CollisionSteps),
+		C.int(ft.MaxStepsPerFrame),
+		&cAccumulator,
+		&cAlpha,
+		&cErrors,
+	)
+
+	ft.accumulator = float64(cAccumulator)
+	ft.UpdateErrors = PhysicsUpdateError(cErrors)
+	return int(numSteps), float32(cAlpha)
+}
+
+// Reset discards any accumulated time that has not been simulated yet
+func (ft *FixedTimestep) Reset() {
+	ft.accumulator = 0
+	ft.UpdateErrors = 0
+}
+
+// OptimizeBroadPhase rebuilds the broadphase trees so queries and collision detection run at full speed.
+// Bodies added with CreateBody/CreateBodies are inserted incrementally, which leaves the trees unbalanced;
+// call this once after loading a level. It is expensive, so don't call it every frame.
+func (ps *PhysicsSystem) OptimizeBroadPhase() {
+	C.JoltPhysicsSystemOptimizeBroadPhase(ps.handle)
+}
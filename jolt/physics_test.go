@@ -0,0 +1,203 @@
+package jolt
+
+import "testing"
+
+func TestNewPhysicsSystemWithSettings(t *testing.T) {
+	settings := NewPhysicsSystemSettings()
+	settings.MaxBodies = 4
+	settings.Gravity = Vec3{X: 0, Y: -1, Z: 0}
+
+	ps, err := NewPhysicsSystemWithSettings(settings)
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer ps.Destroy()
+	bi := ps.GetBodyInterface()
+
+	sphere := CreateSphere(0.5)
+	defer sphere.Destroy()
+
+	// The world holds exactly MaxBodies bodies
+	var settingsList []BodyCreationSettings
+	for i := 0; i < 5; i++ {
+		settingsList = append(settingsList, NewBodyCreationSettings(sphere, Vec3{X: float32(i) * 2, Y: 10, Z: 0}, MotionTypeDynamic))
+	}
+	ids := bi.CreateBodies(settingsList, true)
+	for i := 0; i < 4; i++ {
+		if ids[i].IsInvalid() {
+			t.Fatalf("body %d should fit", i)
+		}
+	}
+	if !ids[4].IsInvalid() {
+		t.Error("body beyond MaxBodies should not be created")
+	}
+
+	// Custom gravity is applied: after 1s of free fall at 1 m/s^2 the body is ~0.5m lower
+	for i := 0; i < 60; i++ {
+		ps.Update(1.0 / 60.0)
+	}
+	drop := 10 - bi.GetPosition(ids[0]).Y
+	if drop < 0.4 || drop > 0.6 {
+		t.Errorf("body dropped %.3f m, expected ~0.5 m under custom gravity", drop)
+	}
+}
+
+func TestPhysicsSystemSettingsDefaults(t *testing.T) {
+	// The defaults come from the wrapper, which takes the solver settings from Jolt's PhysicsSettings
+	settings := NewPhysicsSystemSettings()
+	if settings.MaxBodies != 10240 || settings.MaxBodyPairs != 65536 || settings.MaxContactConstraints != 20480 {
+		t.Errorf("default capacity = %d bodies, %d pairs, %d constraints", settings.MaxBodies, settings.MaxBodyPairs, settings.MaxContactConstraints)
+	}
+	if settings.Gravity != (Vec3{X: 0, Y: -9.81, Z: 0}) {
+		t.Errorf("default gravity = %+v", settings.Gravity)
+	}
+	if settings.NumVelocitySteps == 0 || settings.NumPositionSteps == 0 || !settings.AllowSleeping {
+		t.Errorf("solver defaults not filled in: %+v", settings)
+	}
+	if settings.EventMask != EventMaskDefault || settings.EventOverflow != EventOverflowDropNewest {
+		t.Errorf("event defaults = %v, %v", settings.EventMask, settings.EventOverflow)
+	}
+}
+
+func TestNewPhysicsSystemWithInvalidSettings(t *testing.T) {
+	settings := NewPhysicsSystemSettings()
+	settings.MaxBodies = 0
+
+	ps, err := NewPhysicsSystemWithSettings(settings)
+	if err == nil {
+		ps.Destroy()
+		t.Fatal("expected an error for MaxBodies = 0")
+	}
+}
+
+func TestWorldsUpdateConcurrently(t *testing.T) {
+	const numWorlds = 4
+
+	settings := NewPhysicsSystemSettings()
+	settings.MaxBodies = 256
+	settings.TempAllocatorSize = 1024 * 1024
+
+	sphere := CreateSphere(0.5)
+	defer sphere.Destroy()
+	floor := CreateBox(Vec3{X: 10, Y: 0.5, Z: 10})
+	defer floor.Destroy()
+
+	worlds := make([]*PhysicsSystem, numWorlds)
+	balls := make([]BodyID, numWorlds)
+	for i := range worlds {
+		// The last world gets a dedicated thread pool
+		if i == numWorlds-1 {
+			settings.JobThreads = 1
+		}
+		ps, err := NewPhysicsSystemWithSettings(settings)
+		if err != nil {
+			t.Fatal(err)
+		}
+		defer ps.Destroy()
+		worlds[i] = ps
+
+		bi := ps.GetBodyInterface()
+		bi.CreateBody(floor, Vec3{}, MotionTypeStatic, false)
+		balls[i] = bi.CreateBody(sphere, Vec3{X: 0, Y: 5, Z: 0}, MotionTypeDynamic, false)
+		bi.ActivateBody(balls[i])
+	}
+
+	done := make(chan struct{})
+	for _, ps := range worlds {
+		go func(ps *PhysicsSystem) {
+			defer func() { done <- struct{}{} }()
+			for i := 0; i < 120; i++ {
+				ps.Update(1.0 / 60.0)
+			}
+		}(ps)
+	}
+	for range worlds {
+		<-done
+	}
+
+	// Every world ran the same deterministic simulation
+	expected := worlds[0].GetBodyInterface().GetPosition(balls[0])
+	for i, ps := range worlds {
+		pos := ps.GetBodyInterface().GetPosition(balls[i])
+		if pos != expected {
+			t.Errorf("world %d: ball at %+v, expected %+v", i, pos, expected)
+		}
+	}
+	if expected.Y > 1.1 {
+		t.Errorf("ball should have landed on the floor, at Y = %.2f", expected.Y)
+	}
+}
+
+func TestFixedTimestep(t *testing.T) {
+	ps := NewPhysicsSystem()
+	defer ps.Destroy()
+	bi := ps.GetBodyInterface()
+
+	sphere := CreateSphere(0.5)
+	defer sphere.Destroy()
+	ball := bi.CreateBody(sphere, Vec3{X: 0, Y: 100, Z: 0}, MotionTypeDynamic, false)
+	bi.ActivateBody(ball)
+
+	stepper := NewFixedTimestep(0.01)
+
+	// 2.5 steps worth of time runs 2 steps and leaves half a step
+	steps, alpha := stepper.Advance(ps, 0.025)
+	if steps != 2 {
+		t.Errorf("steps = %d, expected 2", steps)
+	}
+	if alpha < 0.49 || alpha > 0.51 {
+		t.Errorf("alpha = %.3f, expected 0.5", alpha)
+	}
+
+	// The leftover carries over to the next frame
+	if steps, _ := stepper.Advance(ps, 0.005); steps != 1 {
+		t.Errorf("steps = %d, expected 1", steps)
+	}
+
+	// A very long frame is capped and the excess dropped
+	stepper.MaxStepsPerFrame = 4
+	if steps, alpha := stepper.Advance(ps, 1.0); steps != 4 || alpha >= 1 {
+		t.Errorf("steps = %d, alpha = %.3f, expected 4 steps and alpha < 1", steps, alpha)
+	}
+	if steps, _ := stepper.Advance(ps, 0); steps != 0 {
+		t.Errorf("dropped time should not be simulated later, ran %d steps", steps)
+	}
+	if stepper.UpdateErrors != 0 {
+		t.Errorf("unexpected update errors: %v", stepper.UpdateErrors)
+	}
+
+	// Same result as calling UpdateWithCollisionSteps directly
+	ref := NewPhysicsSystem()
+	defer ref.Destroy()
+	refBall := ref.GetBodyInterface().CreateBody(sphere, Vec3{X: 0, Y: 100, Z: 0}, MotionTypeDynamic, false)
+	ref.GetBodyInterface().ActivateBody(refBall)
+	for i := 0; i < 7; i++ {
+		ref.UpdateWithCollisionSteps(0.01, 1)
+	}
+	if got, want := bi.GetPosition(ball), ref.GetBodyInterface().GetPosition(refBall); got != want {
+		t.Errorf("stepper position %+v differs from manual stepping %+v", got, want)
+	}
+}
+
+func TestFixedTimestepZeroValue(t *testing.T) {
+	ps := NewPhysicsSystem()
+	defer ps.Destroy()
+	bi := ps.GetBodyInterface()
+
+	sphere := CreateSphere(0.5)
+	defer sphere.Destroy()
+	ball := bi.CreateBody(sphere, Vec3{X: 0, Y: 100, Z: 0}, MotionTypeDynamic, false)
+	bi.ActivateBody(ball)
+
+	// Unset CollisionSteps and MaxStepsPerFrame use their defaults instead of never stepping
+	stepper := FixedTimestep{StepSize: 0.01}
+	if steps, _ := stepper.Advance(ps, 0.025); steps != 2 {
+		t.Errorf("steps = %d, expected 2", steps)
+	}
+	if steps, _ := stepper.Advance(ps, 1.0); steps != 8 {
+		t.Errorf("steps = %d, expected the default cap of 8", steps)
+	}
+	if y := bi.GetPosition(ball).Y; y >= 100 {
+		t.Errorf("ball at Y=%.3f, expected it to fall", y)
+	}
+}
@@ -2,22 +2,139 @@ package jolt
 
 // #include "wrapper/query.h"
 import "C"
+import (
+	"runtime"
+	"unsafe"
+)
 
 // CollisionHit contains information about a single collision detected during a shape query
 type CollisionHit struct {
-	BodyID           *BodyID // The body that was hit
+	BodyID           BodyID  // The body that was hit
 	ContactPoint     Vec3    // The contact point in world space
 	PenetrationDepth float32 // How deep the shapes overlap (negative if separated)
 }
 
 // RaycastHit contains information about a single raycast hit
 type RaycastHit struct {
-	BodyID   *BodyID // The body that was hit (nil if no hit)
+	BodyID   BodyID  // The body that was hit (InvalidBodyID if no hit)
 	HitPoint Vec3    // The position where the ray hit the surface
 	Normal   Vec3    // The surface normal at the hit point
 	Fraction float32 // The fraction along the ray where the hit occurred [0, 1]
 }
 
+// CollisionHit and RaycastHit share their memory layout with JoltCollisionHit and JoltRaycastHit,
+// so result slices can be handed to the wrapper directly without a C-side copy.
+// Each pair of array types below fails to compile if the sizes or field offsets drift apart.
+var (
+	_ [unsafe.Sizeof(CollisionHit{}) - unsafe.Sizeof(C.JoltCollisionHit{})]struct{}
+	_ [unsafe.Sizeof(C.JoltCollisionHit{}) - unsafe.Sizeof(CollisionHit{})]struct{}
+	_ [unsafe.Offsetof(CollisionHit{}.PenetrationDepth) - unsafe.Offsetof(C.JoltCollisionHit{}.penetrationDepth)]struct{}
+	_ [unsafe.Offsetof(C.JoltCollisionHit{}.penetrationDepth) - unsafe.Offsetof(CollisionHit{}.PenetrationDepth)]struct{}
+
+	_ [unsafe.Sizeof(RaycastHit{}) - unsafe.Sizeof(C.JoltRaycastHit{})]struct{}
+	_ [unsafe.Sizeof(C.JoltRaycastHit{}) - unsafe.Sizeof(RaycastHit{})]struct{}
+	_ [unsafe.Offsetof(RaycastHit{}.Normal) - unsafe.Offsetof(C.JoltRaycastHit{}.normalX)]struct{}
+	_ [unsafe.Offsetof(C.JoltRaycastHit{}.normalX) - unsafe.Offsetof(RaycastHit{}.Normal)]struct{}
+	_ [unsafe.Offsetof(RaycastHit{}.Fraction) - unsafe.Offsetof(C.JoltRaycastHit{}.fraction)]struct{}
+	_ [unsafe.Offsetof(C.JoltRaycastHit{}.fraction) - unsafe.Offsetof(RaycastHit{}.Fraction)]struct{}
+)
+
+// CollisionHit64 is CollisionHit with a double-precision contact point, returned by the *64 queries
+type CollisionHit64 struct {
+	BodyID           BodyID  // The body that was hit
+	PenetrationDepth float32 // How deep the shapes overlap (negative if separated)
+	ContactPoint     RVec3   // The contact point in world space
+}
+
+// RaycastHit64 is RaycastHit with a double-precision hit point, returned by CastRay64
+type RaycastHit64 struct {
+	BodyID   BodyID  // The body that was hit (InvalidBodyID if no hit)
+	HitPoint RVec3   // The position where the ray hit the surface
+	Normal   Vec3    // The surface normal at the hit point
+	Fraction float32 // The fraction along the ray where the hit occurred [0, 1]
+}
+
+// Same layout checks for the double-precision hits (the doubles are 8-byte aligned on both sides)
+var (
+	_ [unsafe.Sizeof(CollisionHit64{}) - unsafe.Sizeof(C.JoltCollisionHit64{})]struct{}
+	_ [unsafe.Sizeof(C.JoltCollisionHit64{}) - unsafe.Sizeof(CollisionHit64{})]struct{}
+	_ [unsafe.Offsetof(CollisionHit64{}.ContactPoint) - unsafe.Offsetof(C.JoltCollisionHit64{}.contactPointX)]struct{}
+	_ [unsafe.Offsetof(C.JoltCollisionHit64{}.contactPointX) - unsafe.Offsetof(CollisionHit64{}.ContactPoint)]struct{}
+	_ [unsafe.Offsetof(CollisionHit64{}.PenetrationDepth) - unsafe.Offsetof(C.JoltCollisionHit64{}.penetrationDepth)]struct{}
+	_ [unsafe.Offsetof(C.JoltCollisionHit64{}.penetrationDepth) - unsafe.Offsetof(CollisionHit64{}.PenetrationDepth)]struct{}
+
+	_ [unsafe.Sizeof(RaycastHit64{}) - unsafe.Sizeof(C.JoltRaycastHit64{})]struct{}
+	_ [unsafe.Sizeof(C.JoltRaycastHit64{}) - unsafe.Sizeof(RaycastHit64{})]struct{}
+	_ [unsafe.Offsetof(RaycastHit64{}.HitPoint) - unsafe.Offsetof(C.JoltRaycastHit64{}.hitPointX)]struct{}
+	_ [unsafe.Offsetof(C.JoltRaycastHit64{}.hitPointX) - unsafe.Offsetof(RaycastHit64{}.HitPoint)]struct{}
+	_ [unsafe.Offsetof(RaycastHit64{}.Fraction) - unsafe.Offsetof(C.JoltRaycastHit64{}.fraction)]struct{}
+	_ [unsafe.Offsetof(C.JoltRaycastHit64{}.fraction) - unsafe.Offsetof(RaycastHit64{}.Fraction)]struct{}
+)
+
+// QueryOptions restricts what a query can hit. Filtering happens inside Jolt's traversal, so bodies
+// that are filtered out cost nothing in the narrow phase.
+// A nil *QueryOptions is the same as NewQueryOptions(). A QueryOptions must not be used by several
+// queries at the same time; give each goroutine its own.
+type QueryOptions struct {
+	// LayerMask selects the object layers that can be hit. Broadphase trees that hold none of these
+	// layers are skipped entirely. The zero value hits every layer like AllObjectLayers, so options
+	// built as a struct literal don't filter out everything (default: AllObjectLayers)
+	LayerMask ObjectLayerMask
+
+	// IgnoreBodies lists bodies that can't be hit, typically the caster's own body. The list is searched
+	// linearly for every candidate body, so keep it short (default: nil)
+	IgnoreBodies []BodyID
+
+	// IgnoreSensors skips sensor bodies (default: false)
+	IgnoreSensors bool
+
+	// AnyHit makes CastRay, CastShape and their batches return the first hit found instead of the closest one,
+	// which ends the traversal early. Use it for line-of-sight checks where only hit/no-hit matters.
+	// Ignored by the GetHits queries; CollideShape always stops at the first hit (default: false)
+	AnyHit bool
+
+	// NoLock reads bodies without taking Jolt's body locks, saving a lock and unlock per candidate body.
+	// Only set it when nothing updates the world or adds, removes or modifies bodies while the query runs,
+	// e.g. for queries issued by a goroutine pool between steps that waits for all of them before the next
+	// Update. Character updates can push bodies, so don't run them alongside NoLock queries. Any number of
+	// NoLock queries can run at the same time (default: false)
+	NoLock bool
+
+	c C.JoltQueryOptions // C copy handed to the wrapper, kept here so queries don't allocate
+}
+
+// NewQueryOptions creates options that let a query hit everything
+func NewQueryOptions() *QueryOptions {
+	return &QueryOptions{
+		LayerMask:     AllObjectLayers,
+		IgnoreBodies:  nil,
+		IgnoreSensors: false,
+		AnyHit:        false,
+		NoLock:        false,
+	}
+}
+
+// toC converts the options for the wrapper, or returns nil for nil options.
+// The ignored body list is handed to C without a copy and stays pinned until pinner is unpinned.
+func (o *QueryOptions) toC(pinner *runtime.Pinner) *C.JoltQueryOptions {
+	if o == nil {
+		return nil
+	}
+
+	out := &o.c
+	out.objectLayerMask = C.uint(o.LayerMask)
+	out.ignoredBodies = nil
+	out.numIgnoredBodies = C.int(len(o.IgnoreBodies))
+	if len(o.IgnoreBodies) > 0 {
+		pinner.Pin(&o.IgnoreBodies[0])
+		out.ignoredBodies = (*C.JoltBodyID)(unsafe.Pointer(&o.IgnoreBodies[0]))
+	}
+	out.ignoreSensors = C.int(boolToInt(o.IgnoreSensors))
+	out.anyHit = C.int(boolToInt(o.AnyHit))
+	out.noLock = C.int(boolToInt(o.NoLock))
+	return out
+}
+
 // CollideShape checks if a shape at the given position collides with any bodies in the physics system.
 // This performs a static overlap test - the shape itself is not added to the physics system.
 //
@@ -37,13 +154,28 @@ type RaycastHit struct {
 //	    fmt.Println("Collision detected!")
 //	}
 func (ps *PhysicsSystem) CollideShape(shape *Shape, position Vec3, penetrationTolerance float32) bool {
+	return ps.CollideShapeWithOptions(shape, position, penetrationTolerance, nil)
+}
+
+// CollideShapeWithOptions is like CollideShape but only considers the bodies allowed by opts.
+//
+// Example usage:
+//
+//	// Is the spawn point blocked by level geometry? (ignores players and debris)
+//	opts := jolt.NewQueryOptions()
+//	opts.LayerMask = LayerStatic.Mask()
+//	blocked := ps.CollideShapeWithOptions(capsule, spawnPoint, 0, opts)
+func (ps *PhysicsSystem) CollideShapeWithOptions(shape *Shape, position Vec3, penetrationTolerance float32, opts *QueryOptions) bool {
+	var pinner runtime.Pinner
+	defer pinner.Unpin()
 	result := C.JoltCollideShape(
 		ps.handle,
 		shape.handle,
-		C.float(position.X),
-		C.float(position.Y),
-		C.float(position.Z),
+		C.double(position.X),
+		C.double(position.Y),
+		C.double(position.Z),
 		C.float(penetrationTolerance),
+		opts.toC(&pinner),
 	)
 	return result != 0
 }
@@ -59,6 +191,7 @@ func (ps *PhysicsSystem) CollideShape(shape *Shape, position Vec3, penetrationTo
 //     If the change of the squared distance is less than tolerance * current_penetration_depth^2 the algorithm will terminate. (unit: dimensionless)
 //
 // Returns a slice of CollisionHit containing information about each collision.
+// Allocates the result slice on every call; use CollideShapeGetHitsInto in hot paths.
 //
 // Example usage:
 //
@@ -76,36 +209,98 @@ func (ps *PhysicsSystem) CollideShapeGetHits(shape *Shape, position Vec3, maxHit
 		return []CollisionHit{}
 	}
 
-	// Allocate C array for results
-	cHits := make([]C.JoltCollisionHit, maxHits)
+	hits := make([]CollisionHit, maxHits)
+	numHits := ps.CollideShapeGetHitsInto(shape, position, hits, penetrationTolerance)
+	return hits[:numHits]
+}
 
+// CollideShapeGetHitsInto is like CollideShapeGetHits but writes the hits into a caller-owned buffer
+// instead of allocating one. Up to len(dst) hits are returned; reusing dst across frames makes the query
+// allocation free.
+//
+// Returns the number of hits written to dst.
+//
+// Example usage:
+//
+//	hits := make([]jolt.CollisionHit, 16) // allocated once
+//	for {
+//	    n := ps.CollideShapeGetHitsInto(sphere, pos, hits, 0)
+//	    for _, hit := range hits[:n] {
+//	        // ...
+//	    }
+//	}
+func (ps *PhysicsSystem) CollideShapeGetHitsInto(shape *Shape, position Vec3, dst []CollisionHit, penetrationTolerance float32) int {
+	return ps.CollideShapeGetHitsIntoWithOptions(shape, position, dst, penetrationTolerance, nil)
+}
+
+// CollideShapeGetHitsIntoWithOptions is like CollideShapeGetHitsInto but only considers the bodies allowed by opts.
+func (ps *PhysicsSystem) CollideShapeGetHitsIntoWithOptions(shape *Shape, position Vec3, dst []CollisionHit, penetrationTolerance float32, opts *QueryOptions) int {
+	if len(dst) == 0 {
+		return 0
+	}
+
+	// The wrapper writes straight into dst, see the layout assertions above
+	var pinner runtime.Pinner
+	defer pinner.Unpin()
 	numHits := C.JoltCollideShapeGetHits(
 		ps.handle,
 		shape.handle,
-		C.float(position.X),
-		C.float(position.Y),
-		C.float(position.Z),
-		&cHits[0],
-		C.int(maxHits),
+		C.double(position.X),
+		C.double(position.Y),
+		C.double(position.Z),
+		(*C.JoltCollisionHit)(unsafe.Pointer(&dst[0])),
+		C.int(len(dst)),
 		C.float(penetrationTolerance),
+		opts.toC(&pinner),
 	)
 
-	// Convert C results to Go
-	hits := make([]CollisionHit, int(numHits))
-	for i := 0; i < int(numHits); i++ {
-		cHit := cHits[i]
-		hits[i] = CollisionHit{
-			BodyID: &BodyID{handle: cHit.bodyID},
-			ContactPoint: Vec3{
-				X: float32(cHit.contactPointX),
-				Y: float32(cHit.contactPointY),
-				Z: float32(cHit.contactPointZ),
-			},
-			PenetrationDepth: float32(cHit.penetrationDepth),
-		}
+	return int(numHits)
+}
+
+// CollideShape64 is CollideShapeWithOptions with a double-precision position (see RVec3)
+func (ps *PhysicsSystem) CollideShape64(shape *Shape, position RVec3, penetrationTolerance float32, opts *QueryOptions) bool {
+	var pinner runtime.Pinner
+	defer pinner.Unpin()
+	result := C.JoltCollideShape(
+		ps.handle,
+		shape.handle,
+		C.double(position.X),
+		C.double(position.Y),
+		C.double(position.Z),
+		C.float(penetrationTolerance),
+		opts.toC(&pinner),
+	)
+	return result != 0
+}
+
+// CollideShapeGetHitsInto64 is CollideShapeGetHitsIntoWithOptions with a double-precision position and
+// contact points (see RVec3). The contacts are computed relative to position, so they stay accurate far from
+// the origin.
+//
+// Example usage:
+//
+//	hits := make([]jolt.CollisionHit64, 16) // allocated once
+//	n := ps.CollideShapeGetHitsInto64(sphere, ship.Position64(), hits, 0, nil)
+func (ps *PhysicsSystem) CollideShapeGetHitsInto64(shape *Shape, position RVec3, dst []CollisionHit64, penetrationTolerance float32, opts *QueryOptions) int {
+	if len(dst) == 0 {
+		return 0
 	}
 
-	return hits
+	var pinner runtime.Pinner
+	defer pinner.Unpin()
+	numHits := C.JoltCollideShapeGetHits64(
+		ps.handle,
+		shape.handle,
+		C.double(position.X),
+		C.double(position.Y),
+		C.double(position.Z),
+		(*C.JoltCollisionHit64)(unsafe.Pointer(&dst[0])),
+		C.int(len(dst)),
+		C.float(penetrationTolerance),
+		opts.toC(&pinner),
+	)
+
+	return int(numHits)
 }
 
 // CastRay performs a raycast from origin in the specified direction and returns the closest hit.
@@ -130,50 +325,150 @@ func (ps *PhysicsSystem) CollideShapeGetHits(shape *Shape, position Vec3, maxHit
 //	        hit.HitPoint.X, hit.HitPoint.Y, hit.HitPoint.Z, hit.Fraction)
 //	}
 func (ps *PhysicsSystem) CastRay(origin, direction Vec3) (RaycastHit, bool) {
-	var cHit C.JoltRaycastHit
+	return ps.CastRayWithOptions(origin, direction, nil)
+}
+
+// CastRayWithOptions is like CastRay but only considers the bodies allowed by opts.
+//
+// Example usage:
+//
+//	// Ground probe that only walks the terrain broadphase tree
+//	opts := jolt.NewQueryOptions()
+//	opts.LayerMask = LayerTerrain.Mask()
+//	hit, onGround := ps.CastRayWithOptions(feet, jolt.Vec3{X: 0, Y: -0.2, Z: 0}, opts)
+func (ps *PhysicsSystem) CastRayWithOptions(origin, direction Vec3, opts *QueryOptions) (RaycastHit, bool) {
+	var hit RaycastHit
+	var pinner runtime.Pinner
+	defer pinner.Unpin()
 
 	result := C.JoltCastRay(
 		ps.handle,
-		C.float(origin.X),
-		C.float(origin.Y),
-		C.float(origin.Z),
+		C.double(origin.X),
+		C.double(origin.Y),
+		C.double(origin.Z),
 		C.float(direction.X),
 		C.float(direction.Y),
 		C.float(direction.Z),
-		&cHit,
+		(*C.JoltRaycastHit)(unsafe.Pointer(&hit)),
+		opts.toC(&pinner),
 	)
 
 	if result == 0 {
-		return RaycastHit{}, false
+		return RaycastHit{BodyID: InvalidBodyID}, false
 	}
 
-	hit := RaycastHit{
-		BodyID: &BodyID{handle: cHit.bodyID},
-		HitPoint: Vec3{
-			X: float32(cHit.hitPointX),
-			Y: float32(cHit.hitPointY),
-			Z: float32(cHit.hitPointZ),
-		},
-		Normal: Vec3{
-			X: float32(cHit.normalX),
-			Y: float32(cHit.normalY),
-			Z: float32(cHit.normalZ),
-		},
-		Fraction: float32(cHit.fraction),
+	return hit, true
+}
+
+// CastRay64 is CastRayWithOptions with a double-precision origin and hit point (see RVec3).
+// The direction stays single precision: it is relative to the origin.
+//
+// Example usage:
+//
+//	hit, hasHit := ps.CastRay64(muzzle, aim.Mul(500), opts)
+//	if hasHit {
+//	    spawnDecal(hit.HitPoint, hit.Normal)
+//	}
+func (ps *PhysicsSystem) CastRay64(origin RVec3, direction Vec3, opts *QueryOptions) (RaycastHit64, bool) {
+	var hit RaycastHit64
+	var pinner runtime.Pinner
+	defer pinner.Unpin()
+
+	result := C.JoltCastRay64(
+		ps.handle,
+		C.double(origin.X),
+		C.double(origin.Y),
+		C.double(origin.Z),
+		C.float(direction.X),
+		C.float(direction.Y),
+		C.float(direction.Z),
+		(*C.JoltRaycastHit64)(unsafe.Pointer(&hit)),
+		opts.toC(&pinner),
+	)
+
+	if result == 0 {
+		return RaycastHit64{BodyID: InvalidBodyID}, false
 	}
 
 	return hit, true
 }
 
+// CastRayBatch casts many rays in a single call and writes the closest hit of each ray to out.
+// This avoids paying a cgo transition and filter setup per ray, which dominates the cost of
+// short rays such as line-of-sight or hitscan checks.
+//
+// Parameters:
+//   - origins: Starting positions of the rays in world space
+//   - directions: Direction and length of each ray (ray i goes from origins[i] to origins[i] + directions[i])
+//   - out: Caller-owned buffer receiving one result per ray; out[i].BodyID is InvalidBodyID if ray i missed
+//
+// The number of rays cast is the shortest of len(origins), len(directions) and len(out).
+// Returns the number of rays that hit something.
+//
+// Example usage:
+//
+//	origins := []jolt.Vec3{{X: 0, Y: 10, Z: 0}, {X: 5, Y: 10, Z: 0}}
+//	directions := []jolt.Vec3{{X: 0, Y: -20, Z: 0}, {X: 0, Y: -20, Z: 0}}
+//	hits := make([]jolt.RaycastHit, len(origins))
+//	ps.CastRayBatch(origins, directions, hits)
+//	for i, hit := range hits {
+//	    if !hit.BodyID.IsInvalid() {
+//	        fmt.Printf("Ray %d hit at fraction %.2f\n", i, hit.Fraction)
+//	    }
+//	}
+func (ps *PhysicsSystem) CastRayBatch(origins, directions []Vec3, out []RaycastHit) int {
+	return ps.castRayBatch(origins, directions, out, false, nil)
+}
+
+// CastRayBatchParallel is like CastRayBatch but splits the rays across the job system worker threads.
+// The calling goroutine blocks until all rays are done. Worth it for batches of a few hundred rays or more.
+func (ps *PhysicsSystem) CastRayBatchParallel(origins, directions []Vec3, out []RaycastHit) int {
+	return ps.castRayBatch(origins, directions, out, true, nil)
+}
+
+// CastRayBatchWithOptions is like CastRayBatch but every ray only considers the bodies allowed by opts.
+func (ps *PhysicsSystem) CastRayBatchWithOptions(origins, directions []Vec3, out []RaycastHit, opts *QueryOptions) int {
+	return ps.castRayBatch(origins, directions, out, false, opts)
+}
+
+// CastRayBatchParallelWithOptions is like CastRayBatchParallel but every ray only considers the bodies allowed by opts.
+func (ps *PhysicsSystem) CastRayBatchParallelWithOptions(origins, directions []Vec3, out []RaycastHit, opts *QueryOptions) int {
+	return ps.castRayBatch(origins, directions, out, true, opts)
+}
+
+func (ps *PhysicsSystem) castRayBatch(origins, directions []Vec3, out []RaycastHit, parallel bool, opts *QueryOptions) int {
+	n := min(len(origins), len(directions), len(out))
+	if n == 0 {
+		return 0
+	}
+
+	// Vec3 is three packed float32s, so the slices can be passed to C as flat float arrays,
+	// and the results are written straight into out (see the layout assertions above)
+	var pinner runtime.Pinner
+	defer pinner.Unpin()
+	numHits := C.JoltCastRayBatch(
+		ps.handle,
+		(*C.float)(unsafe.Pointer(&origins[0])),
+		(*C.float)(unsafe.Pointer(&directions[0])),
+		C.int(n),
+		(*C.JoltRaycastHit)(unsafe.Pointer(&out[0])),
+		C.int(boolToInt(parallel)),
+		opts.toC(&pinner),
+	)
+
+	return int(numHits)
+}
+
 // CastRayGetHits performs a raycast and returns all hits along the ray, sorted by distance.
 // The direction vector does not need to be normalized - its length determines the maximum ray distance.
 //
 // Parameters:
 //   - origin: Starting position of the ray in world space
 //   - direction: Direction and length of the ray (ray goes from origin to origin + direction)
-//   - maxHits: Maximum number of hits to return (limits memory allocation)
+//   - maxHits: Maximum number of hits to return (the closest maxHits hits are kept)
 //
 // Returns a slice of RaycastHit containing all hits sorted by distance (closest first).
+// Allocates the result slice on every call; use CastRayGetHitsInto in hot paths.
 //
 // Example usage:
 //
@@ -190,40 +485,480 @@ func (ps *PhysicsSystem) CastRayGetHits(origin, direction Vec3, maxHits int) []R
 		return []RaycastHit{}
 	}
 
-	// Allocate C array for results
-	cHits := make([]C.JoltRaycastHit, maxHits)
+	hits := make([]RaycastHit, maxHits)
+	numHits := ps.CastRayGetHitsInto(origin, direction, hits)
+	return hits[:numHits]
+}
+
+// CastRayGetHitsInto is like CastRayGetHits but writes the hits into a caller-owned buffer
+// instead of allocating one. The closest len(dst) hits are returned, sorted by distance; reusing dst
+// across frames makes the query allocation free.
+//
+// Returns the number of hits written to dst.
+//
+// Example usage:
+//
+//	hits := make([]jolt.RaycastHit, 8) // allocated once
+//	for {
+//	    n := ps.CastRayGetHitsInto(origin, direction, hits)
+//	    for _, hit := range hits[:n] {
+//	        // ...
+//	    }
+//	}
+func (ps *PhysicsSystem) CastRayGetHitsInto(origin, direction Vec3, dst []RaycastHit) int {
+	return ps.CastRayGetHitsIntoWithOptions(origin, direction, dst, nil)
+}
 
+// CastRayGetHitsIntoWithOptions is like CastRayGetHitsInto but only considers the bodies allowed by opts.
+func (ps *PhysicsSystem) CastRayGetHitsIntoWithOptions(origin, direction Vec3, dst []RaycastHit, opts *QueryOptions) int {
+	if len(dst) == 0 {
+		return 0
+	}
+
+	// The wrapper writes straight into dst, see the layout assertions above
+	var pinner runtime.Pinner
+	defer pinner.Unpin()
 	numHits := C.JoltCastRayGetHits(
 		ps.handle,
-		C.float(origin.X),
-		C.float(origin.Y),
-		C.float(origin.Z),
+		C.double(origin.X),
+		C.double(origin.Y),
+		C.double(origin.Z),
 		C.float(direction.X),
 		C.float(direction.Y),
 		C.float(direction.Z),
-		&cHits[0],
-		C.int(maxHits),
+		(*C.JoltRaycastHit)(unsafe.Pointer(&dst[0])),
+		C.int(len(dst)),
+		opts.toC(&pinner),
+	)
+
+	return int(numHits)
+}
+
+// ShapeCastHit contains information about a single shape cast hit
+type ShapeCastHit struct {
+	BodyID           BodyID  // The body that was hit (InvalidBodyID if no hit)
+	ContactPoint     Vec3    // Deepest contact point on the hit body in world space
+	Normal           Vec3    // Surface normal of the hit body at the contact point, pointing towards the cast shape
+	Fraction         float32 // Fraction along the cast direction where the shapes first touch [0, 1]
+	PenetrationDepth float32 // Penetration depth at the contact point (> 0 if the shape started out overlapping)
+}
+
+// ShapeCast is a shape swept from a start transform along a direction.
+// Create it with NewShapeCast; the shape is stored as its wrapper handle so that slices of casts
+// can be handed to the wrapper without conversion.
+type ShapeCast struct {
+	shape     C.JoltShape
+	Position  Vec3 // Start position in world space
+	Rotation  Quat // Start rotation (the zero value is treated as identity)
+	Direction Vec3 // Direction and length of the sweep
+}
+
+// ShapeCastHit and ShapeCast share their memory layout with JoltShapeCastHit and JoltShapeCast.
+var (
+	_ [unsafe.Sizeof(ShapeCastHit{}) - unsafe.Sizeof(C.JoltShapeCastHit{})]struct{}
+	_ [unsafe.Sizeof(C.JoltShapeCastHit{}) - unsafe.Sizeof(ShapeCastHit{})]struct{}
+	_ [unsafe.Offsetof(ShapeCastHit{}.Normal) - unsafe.Offsetof(C.JoltShapeCastHit{}.normalX)]struct{}
+	_ [unsafe.Offsetof(C.JoltShapeCastHit{}.normalX) - unsafe.Offsetof(ShapeCastHit{}.Normal)]struct{}
+	_ [unsafe.Offsetof(ShapeCastHit{}.PenetrationDepth) - unsafe.Offsetof(C.JoltShapeCastHit{}.penetrationDepth)]struct{}
+	_ [unsafe.Offsetof(C.JoltShapeCastHit{}.penetrationDepth) - unsafe.Offsetof(ShapeCastHit{}.PenetrationDepth)]struct{}
+
+	_ [unsafe.Sizeof(ShapeCast{}) - unsafe.Sizeof(C.JoltShapeCast{})]struct{}
+	_ [unsafe.Sizeof(C.JoltShapeCast{}) - unsafe.Sizeof(ShapeCast{})]struct{}
+	_ [unsafe.Offsetof(ShapeCast{}.Rotation) - unsafe.Offsetof(C.JoltShapeCast{}.rotationX)]struct{}
+	_ [unsafe.Offsetof(C.JoltShapeCast{}.rotationX) - unsafe.Offsetof(ShapeCast{}.Rotation)]struct{}
+	_ [unsafe.Offsetof(ShapeCast{}.Direction) - unsafe.Offsetof(C.JoltShapeCast{}.directionX)]struct{}
+	_ [unsafe.Offsetof(C.JoltShapeCast{}.directionX) - unsafe.Offsetof(ShapeCast{}.Direction)]struct{}
+)
+
+// NewShapeCast creates a sweep of shape from position and rotation along direction.
+// The direction vector does not need to be normalized - its length determines the sweep distance.
+func NewShapeCast(shape *Shape, position Vec3, rotation Quat, direction Vec3) ShapeCast {
+	return ShapeCast{
+		shape:     shape.handle,
+		Position:  position,
+		Rotation:  rotation,
+		Direction: direction,
+	}
+}
+
+// SetShape changes the swept shape
+func (c *ShapeCast) SetShape(shape *Shape) {
+	c.shape = shape.handle
+}
+
+// ShapeCastSettings configures how shapes are swept
+type ShapeCastSettings struct {
+	// CollisionTolerance is the distance at which shapes are considered touching (default: 1.0e-4)
+	CollisionTolerance float32
+
+	// PenetrationTolerance is the penetration depth accuracy for casts that start out overlapping (default: 1.0e-4)
+	PenetrationTolerance float32
+
+	// BackFaceModeTriangles controls hits on the back faces of triangles (default: BackFaceModeIgnore)
+	BackFaceModeTriangles BackFaceMode
+
+	// BackFaceModeConvex controls hits on convex shapes the cast starts inside of (default: BackFaceModeIgnore)
+	BackFaceModeConvex BackFaceMode
+
+	// UseShrunkenShapeAndConvexRadius sweeps the shrunken shape plus its convex radius, which is faster
+	// but rounds off corners (default: false)
+	UseShrunkenShapeAndConvexRadius bool
+
+	// ReturnDeepestPoint returns the deepest point instead of the first contact for casts that start
+	// out overlapping (default: false)
+	ReturnDeepestPoint bool
+}
+
+// NewShapeCastSettings creates settings with Jolt's default values
+func NewShapeCastSettings() *ShapeCastSettings {
+	return &ShapeCastSettings{
+		CollisionTolerance:              1.0e-4,
+		PenetrationTolerance:            1.0e-4,
+		BackFaceModeTriangles:           BackFaceModeIgnore,
+		BackFaceModeConvex:              BackFaceModeIgnore,
+		UseShrunkenShapeAndConvexRadius: false,
+		ReturnDeepestPoint:              false,
+	}
+}
+
+// defaultShapeCastSettings is used for nil settings
+var defaultShapeCastSettings = NewShapeCastSettings()
+
+// toC converts the settings for the wrapper (nil selects the defaults)
+func (s *ShapeCastSettings) toC() C.JoltShapeCastSettings {
+	if s == nil {
+		s = defaultShapeCastSettings
+	}
+	return C.JoltShapeCastSettings{
+		collisionTolerance:              C.float(s.CollisionTolerance),
+		penetrationTolerance:            C.float(s.PenetrationTolerance),
+		backFaceModeTriangles:           C.int(s.BackFaceModeTriangles),
+		backFaceModeConvex:              C.int(s.BackFaceModeConvex),
+		useShrunkenShapeAndConvexRadius: C.int(boolToInt(s.UseShrunkenShapeAndConvexRadius)),
+		returnDeepestPoint:              C.int(boolToInt(s.ReturnDeepestPoint)),
+	}
+}
+
+// CastShape sweeps a shape along a direction and returns the closest hit (or with opts.AnyHit, the first
+// hit found). Unlike a series of overlap tests along the path, a sweep can't tunnel through thin geometry.
+//
+// Parameters:
+//   - cast: The shape, its start position and rotation, and the sweep direction and length
+//   - settings: How to sweep (nil for the defaults)
+//   - opts: Which bodies can be hit (nil for all)
+//
+// Returns:
+//   - hit: Information about the hit (BodyID, ContactPoint, Normal, Fraction)
+//   - hasHit: true if the shape hit something, false otherwise
+//
+// Example usage:
+//
+//	// Melee swing: sweep a box 2 units forward, ignoring the attacker
+//	blade := jolt.CreateBox(jolt.Vec3{X: 0.1, Y: 0.5, Z: 0.1})
+//	opts := jolt.NewQueryOptions()
+//	opts.IgnoreBodies = []jolt.BodyID{attacker}
+//	cast := jolt.NewShapeCast(blade, handPos, handRot, jolt.Vec3{X: 0, Y: 0, Z: 2})
+//	if hit, ok := ps.CastShape(cast, nil, opts); ok {
+//	    applyDamage(hit.BodyID, hit.ContactPoint)
+//	}
+func (ps *PhysicsSystem) CastShape(cast ShapeCast, settings *ShapeCastSettings, opts *QueryOptions) (ShapeCastHit, bool) {
+	var hit ShapeCastHit
+	var pinner runtime.Pinner
+	defer pinner.Unpin()
+
+	result := C.JoltCastShape(
+		ps.handle,
+		cast.shape,
+		C.double(cast.Position.X),
+		C.double(cast.Position.Y),
+		C.double(cast.Position.Z),
+		C.float(cast.Rotation.X),
+		C.float(cast.Rotation.Y),
+		C.float(cast.Rotation.Z),
+		C.float(cast.Rotation.W),
+		C.float(cast.Direction.X),
+		C.float(cast.Direction.Y),
+		C.float(cast.Direction.Z),
+		settings.toC(),
+		(*C.JoltShapeCastHit)(unsafe.Pointer(&hit)),
+		opts.toC(&pinner),
+	)
+
+	if result == 0 {
+		return ShapeCastHit{BodyID: InvalidBodyID}, false
+	}
+
+	return hit, true
+}
+
+// CastShapeGetHitsInto sweeps a shape and writes all hits along the sweep into a caller-owned buffer,
+// sorted by fraction. The closest len(dst) hits are kept; reusing dst across frames makes the query
+// allocation free.
+//
+// Returns the number of hits written to dst.
+//
+// Example usage:
+//
+//	hits := make([]jolt.ShapeCastHit, 16) // allocated once
+//	n := ps.CastShapeGetHitsInto(cast, hits, nil, nil)
+//	for _, hit := range hits[:n] {
+//	    // piercing projectile: damage everything along the path
+//	}
+func (ps *PhysicsSystem) CastShapeGetHitsInto(cast ShapeCast, dst []ShapeCastHit, settings *ShapeCastSettings, opts *QueryOptions) int {
+	if len(dst) == 0 {
+		return 0
+	}
+
+	// The wrapper writes straight into dst, see the layout assertions above
+	var pinner runtime.Pinner
+	defer pinner.Unpin()
+	numHits := C.JoltCastShapeGetHits(
+		ps.handle,
+		cast.shape,
+		C.double(cast.Position.X),
+		C.double(cast.Position.Y),
+		C.double(cast.Position.Z),
+		C.float(cast.Rotation.X),
+		C.float(cast.Rotation.Y),
+		C.float(cast.Rotation.Z),
+		C.float(cast.Rotation.W),
+		C.float(cast.Direction.X),
+		C.float(cast.Direction.Y),
+		C.float(cast.Direction.Z),
+		settings.toC(),
+		(*C.JoltShapeCastHit)(unsafe.Pointer(&dst[0])),
+		C.int(len(dst)),
+		opts.toC(&pinner),
+	)
+
+	return int(numHits)
+}
+
+// CastShapeBatch sweeps many shapes in a single call and writes the closest hit of each sweep to out,
+// so one call can handle every projectile and melee sweep of a tick.
+//
+// Parameters:
+//   - casts: The sweeps to perform
+//   - out: Caller-owned buffer receiving one result per sweep; out[i].BodyID is InvalidBodyID if sweep i missed
+//   - settings: How to sweep (nil for the defaults)
+//   - opts: Which bodies can be hit (nil for all), shared by every sweep
+//
+// The number of sweeps is the shorter of len(casts) and len(out).
+// Returns the number of sweeps that hit something.
+//
+// Example usage:
+//
+//	casts := make([]jolt.ShapeCast, 0, len(projectiles)) // reused every tick
+//	hits := make([]jolt.ShapeCastHit, len(projectiles))
+//	for _, p := range projectiles {
+//	    casts = append(casts, jolt.NewShapeCast(p.Shape, p.Position, p.Rotation, p.Velocity.Mul(dt)))
+//	}
+//	ps.CastShapeBatch(casts, hits, nil, nil)
+func (ps *PhysicsSystem) CastShapeBatch(casts []ShapeCast, out []ShapeCastHit, settings *ShapeCastSettings, opts *QueryOptions) int {
+	return ps.castShapeBatch(casts, out, settings, opts, false)
+}
+
+// CastShapeBatchParallel is like CastShapeBatch but splits the sweeps across the job system worker threads.
+// The calling goroutine blocks until all sweeps are done.
+func (ps *PhysicsSystem) CastShapeBatchParallel(casts []ShapeCast, out []ShapeCastHit, settings *ShapeCastSettings, opts *QueryOptions) int {
+	return ps.castShapeBatch(casts, out, settings, opts, true)
+}
+
+func (ps *PhysicsSystem) castShapeBatch(casts []ShapeCast, out []ShapeCastHit, settings *ShapeCastSettings, opts *QueryOptions, parallel bool) int {
+	n := min(len(casts), len(out))
+	if n == 0 {
+		return 0
+	}
+
+	// Casts and results are passed without conversion, see the layout assertions above
+	var pinner runtime.Pinner
+	defer pinner.Unpin()
+	numHits := C.JoltCastShapeBatch(
+		ps.handle,
+		(*C.JoltShapeCast)(unsafe.Pointer(&casts[0])),
+		C.int(n),
+		settings.toC(),
+		(*C.JoltShapeCastHit)(unsafe.Pointer(&out[0])),
+		C.int(boolToInt(parallel)),
+		opts.toC(&pinner),
+	)
+
+	return int(numHits)
+}
+
+// BroadPhaseRegion is the region of a broadphase query: an axis aligned box (Radius == 0) or a sphere.
+// Create it with BoxRegion or SphereRegion.
+type BroadPhaseRegion struct {
+	Center     Vec3    // Center of the box or sphere
+	HalfExtent Vec3    // Box half extents (ignored for spheres)
+	Radius     float32 // Sphere radius, 0 for a box
+}
+
+// BroadPhaseRegion shares its memory layout with JoltBroadPhaseRegion
+var (
+	_ [unsafe.Sizeof(BroadPhaseRegion{}) - unsafe.Sizeof(C.JoltBroadPhaseRegion{})]struct{}
+	_ [unsafe.Sizeof(C.JoltBroadPhaseRegion{}) - unsafe.Sizeof(BroadPhaseRegion{})]struct{}
+	_ [unsafe.Offsetof(BroadPhaseRegion{}.Radius) - unsafe.Offsetof(C.JoltBroadPhaseRegion{}.radius)]struct{}
+	_ [unsafe.Offsetof(C.JoltBroadPhaseRegion{}.radius) - unsafe.Offsetof(BroadPhaseRegion{}.Radius)]struct{}
+)
+
+// BoxRegion returns the region covering the axis aligned box from min to max
+func BoxRegion(min, max Vec3) BroadPhaseRegion {
+	return BroadPhaseRegion{
+		Center:     min.Add(max).Mul(0.5),
+		HalfExtent: max.Sub(min).Mul(0.5),
+	}
+}
+
+// SphereRegion returns the region covering a sphere
+func SphereRegion(center Vec3, radius float32) BroadPhaseRegion {
+	return BroadPhaseRegion{Center: center, Radius: radius}
+}
+
+// CollideAABoxBroadPhaseInto finds the bodies whose bounding boxes overlap an axis aligned box.
+// Only the broadphase is queried: no narrow phase test is run against the bodies' shapes, so this is
+// far cheaper than CollideShapeGetHitsInto when the set of nearby bodies is all that is needed.
+// Bodies are written in traversal order; opts.AnyHit is ignored.
+//
+// Returns the number of bodies written to dst. If it equals len(dst), more bodies may overlap.
+//
+// Example usage:
+//
+//	nearby := make([]jolt.BodyID, 256) // allocated once
+//	n := ps.CollideAABoxBroadPhaseInto(jolt.Vec3{X: -50, Y: -10, Z: -50}, jolt.Vec3{X: 50, Y: 10, Z: 50}, nearby, nil)
+//	for _, id := range nearby[:n] {
+//	    // replicate id
+//	}
+func (ps *PhysicsSystem) CollideAABoxBroadPhaseInto(min, max Vec3, dst []BodyID, opts *QueryOptions) int {
+	if len(dst) == 0 {
+		return 0
+	}
+
+	var pinner runtime.Pinner
+	defer pinner.Unpin()
+	numBodies := C.JoltBroadPhaseCollideAABox(
+		ps.handle,
+		C.float(min.X),
+		C.float(min.Y),
+		C.float(min.Z),
+		C.float(max.X),
+		C.float(max.Y),
+		C.float(max.Z),
+		(*C.JoltBodyID)(unsafe.Pointer(&dst[0])),
+		C.int(len(dst)),
+		opts.toC(&pinner),
+	)
+
+	return int(numBodies)
+}
+
+// CollideSphereBroadPhaseInto finds the bodies whose bounding boxes overlap a sphere.
+// Like CollideAABoxBroadPhaseInto, only the broadphase is queried.
+//
+// Returns the number of bodies written to dst. If it equals len(dst), more bodies may overlap.
+func (ps *PhysicsSystem) CollideSphereBroadPhaseInto(center Vec3, radius float32, dst []BodyID, opts *QueryOptions) int {
+	if len(dst) == 0 {
+		return 0
+	}
+
+	var pinner runtime.Pinner
+	defer pinner.Unpin()
+	numBodies := C.JoltBroadPhaseCollideSphere(
+		ps.handle,
+		C.float(center.X),
+		C.float(center.Y),
+		C.float(center.Z),
+		C.float(radius),
+		(*C.JoltBodyID)(unsafe.Pointer(&dst[0])),
+		C.int(len(dst)),
+		opts.toC(&pinner),
 	)
 
-	// Convert C results to Go
-	hits := make([]RaycastHit, int(numHits))
-	for i := 0; i < int(numHits); i++ {
-		cHit := cHits[i]
-		hits[i] = RaycastHit{
-			BodyID: &BodyID{handle: cHit.bodyID},
-			HitPoint: Vec3{
-				X: float32(cHit.hitPointX),
-				Y: float32(cHit.hitPointY),
-				Z: float32(cHit.hitPointZ),
-			},
-			Normal: Vec3{
-				X: float32(cHit.normalX),
-				Y: float32(cHit.normalY),
-				Z: float32(cHit.normalZ),
-			},
-			Fraction: float32(cHit.fraction),
+	return int(numBodies)
+}
+
+// BroadPhaseRegionResults receives the bodies found by CollideBroadPhaseRegions.
+// Each region owns a fixed slice of Bodies, so the buffer is reused across calls without allocation.
+type BroadPhaseRegionResults struct {
+	bodies    []BodyID
+	counts    []int32
+	perRegion int
+}
+
+// NewBroadPhaseRegionResults creates results for up to maxRegions regions of up to maxBodiesPerRegion bodies each.
+// Querying more regions grows the buffer.
+func NewBroadPhaseRegionResults(maxRegions, maxBodiesPerRegion int) *BroadPhaseRegionResults {
+	return &BroadPhaseRegionResults{
+		bodies:    make([]BodyID, maxRegions*maxBodiesPerRegion),
+		counts:    make([]int32, maxRegions),
+		perRegion: maxBodiesPerRegion,
+	}
+}
+
+// NumRegions returns the number of regions of the last query
+func (r *BroadPhaseRegionResults) NumRegions() int {
+	return len(r.counts)
+}
+
+// Region returns the bodies found for region i of the last query. The slice is overwritten by the next query.
+// If its length equals the per region capacity, more bodies may overlap the region.
+func (r *BroadPhaseRegionResults) Region(i int) []BodyID {
+	start := i * r.perRegion
+	return r.bodies[start : start+int(r.counts[i])]
+}
+
+// CollideBroadPhaseRegions queries many broadphase regions in a single cgo call, e.g. the area of interest
+// of every player. Region i's bodies are returned by results.Region(i). The options are shared by every region.
+//
+// Returns the total number of bodies found.
+//
+// Example usage:
+//
+//	results := jolt.NewBroadPhaseRegionResults(maxPlayers, 512) // allocated once
+//	regions := make([]jolt.BroadPhaseRegion, 0, maxPlayers)
+//	for {
+//	    regions = regions[:0]
+//	    for _, p := range players {
+//	        regions = append(regions, jolt.SphereRegion(p.Position, 100))
+//	    }
+//	    ps.CollideBroadPhaseRegionsParallel(regions, results, nil)
+//	    for i, p := range players {
+//	        p.UpdateInterest(results.Region(i))
+//	    }
+//	}
+func (ps *PhysicsSystem) CollideBroadPhaseRegions(regions []BroadPhaseRegion, results *BroadPhaseRegionResults, opts *QueryOptions) int {
+	return ps.collideBroadPhaseRegions(regions, results, opts, false)
+}
+
+// CollideBroadPhaseRegionsParallel is like CollideBroadPhaseRegions but splits the regions across the job
+// system worker threads. The calling goroutine blocks until all regions are done.
+func (ps *PhysicsSystem) CollideBroadPhaseRegionsParallel(regions []BroadPhaseRegion, results *BroadPhaseRegionResults, opts *QueryOptions) int {
+	return ps.collideBroadPhaseRegions(regions, results, opts, true)
+}
+
+func (ps *PhysicsSystem) collideBroadPhaseRegions(regions []BroadPhaseRegion, results *BroadPhaseRegionResults, opts *QueryOptions, parallel bool) int {
+	results.counts = resizeSlice(results.counts, len(regions))
+	results.bodies = resizeSlice(results.bodies, len(regions)*results.perRegion)
+	if len(regions) == 0 || results.perRegion == 0 {
+		for i := range results.counts {
+			results.counts[i] = 0
 		}
+		return 0
 	}
 
-	return hits
+	// Regions and results are passed without conversion, see the layout assertions above
+	var pinner runtime.Pinner
+	defer pinner.Unpin()
+	numBodies := C.JoltBroadPhaseCollideRegions(
+		ps.handle,
+		(*C.JoltBroadPhaseRegion)(unsafe.Pointer(&regions[0])),
+		C.int(len(regions)),
+		(*C.JoltBodyID)(unsafe.Pointer(&results.bodies[0])),
+		C.int(results.perRegion),
+		(*C.int)(unsafe.Pointer(&results.counts[0])),
+		C.int(boolToInt(parallel)),
+		opts.toC(&pinner),
+	)
+
+	return int(numBodies)
 }
@@ -0,0 +1,594 @@
+package jolt
+
+import (
+	"math"
+	"os"
+	"sync"
+	"testing"
+)
+
+func TestMain(m *testing.M) {
+	if err := Init(); err != nil {
+		panic(err)
+	}
+	code := m.Run()
+	Shutdown()
+	os.Exit(code)
+}
+
+// newQueryTestWorld creates a world with a static 20x1x20 floor at the origin and a row of
+// unit spheres at Y=5 along the X axis (X = -4, 0, 4)
+func newQueryTestWorld(t *testing.T) *PhysicsSystem {
+	t.Helper()
+
+	ps := NewPhysicsSystem()
+	bi := ps.GetBodyInterface()
+
+	floor := CreateBox(Vec3{X: 10, Y: 0.5, Z: 10})
+	bi.CreateBody(floor, Vec3{X: 0, Y: 0, Z: 0}, MotionTypeStatic, false)
+	floor.Destroy()
+
+	sphere := CreateSphere(1.0)
+	for _, x := range []float32{-4, 0, 4} {
+		bi.CreateBody(sphere, Vec3{X: x, Y: 5, Z: 0}, MotionTypeStatic, false)
+	}
+	sphere.Destroy()
+
+	t.Cleanup(ps.Destroy)
+	return ps
+}
+
+func TestCastRayBatch(t *testing.T) {
+	ps := newQueryTestWorld(t)
+
+	origins := []Vec3{
+		{X: -4, Y: 10, Z: 0}, // hits sphere at Y=6
+		{X: 0, Y: 10, Z: 0},  // hits sphere at Y=6
+		{X: 8, Y: 10, Z: 0},  // hits floor at Y=0.5
+		{X: 20, Y: 10, Z: 0}, // misses everything
+	}
+	directions := make([]Vec3, len(origins))
+	for i := range directions {
+		directions[i] = Vec3{X: 0, Y: -20, Z: 0}
+	}
+	expectedY := []float32{6, 6, 0.5}
+
+	for _, parallel := range []bool{false, true} {
+		out := make([]RaycastHit, len(origins))
+		var numHits int
+		if parallel {
+			numHits = ps.CastRayBatchParallel(origins, directions, out)
+		} else {
+			numHits = ps.CastRayBatch(origins, directions, out)
+		}
+
+		if numHits != 3 {
+			t.Fatalf("parallel=%v: numHits = %d, expected 3", parallel, numHits)
+		}
+		for i, y := range expectedY {
+			if out[i].BodyID.IsInvalid() {
+				t.Fatalf("parallel=%v: ray %d should have hit", parallel, i)
+			}
+			if math.Abs(float64(out[i].HitPoint.Y-y)) > 0.01 {
+				t.Errorf("parallel=%v: ray %d hit Y = %.2f, expected %.2f", parallel, i, out[i].HitPoint.Y, y)
+			}
+
+			// Batched results must match the single-ray query
+			single, ok := ps.CastRay(origins[i], directions[i])
+			if !ok || math.Abs(float64(single.Fraction-out[i].Fraction)) > 1e-6 {
+				t.Errorf("parallel=%v: ray %d fraction %.4f differs from CastRay (%.4f, %v)",
+					parallel, i, out[i].Fraction, single.Fraction, ok)
+			}
+		}
+		if !out[3].BodyID.IsInvalid() {
+			t.Errorf("parallel=%v: ray 3 should have missed", parallel)
+		}
+	}
+}
+
+func TestCastRayBatchParallelMatchesSerial(t *testing.T) {
+	ps := newQueryTestWorld(t)
+
+	// Enough rays that the batch is split across worker threads
+	const gridSize = 32
+	var origins, directions []Vec3
+	for i := 0; i < gridSize; i++ {
+		for j := 0; j < gridSize; j++ {
+			origins = append(origins, Vec3{X: float32(i) - gridSize/2, Y: 10, Z: float32(j)/4 - 4})
+			directions = append(directions, Vec3{X: 0, Y: -20, Z: 0})
+		}
+	}
+
+	serial := make([]RaycastHit, len(origins))
+	parallel := make([]RaycastHit, len(origins))
+	serialHits := ps.CastRayBatch(origins, directions, serial)
+	parallelHits := ps.CastRayBatchParallel(origins, directions, parallel)
+
+	if serialHits != parallelHits {
+		t.Fatalf("serial hits = %d, parallel hits = %d", serialHits, parallelHits)
+	}
+	for i := range serial {
+		if serial[i].BodyID != parallel[i].BodyID || serial[i].Fraction != parallel[i].Fraction {
+			t.Fatalf("ray %d: serial %+v differs from parallel %+v", i, serial[i], parallel[i])
+		}
+	}
+}
+
+func TestCastRayGetHitsIntoKeepsClosest(t *testing.T) {
+	ps := newQueryTestWorld(t)
+
+	// Horizontal ray at sphere height passes through all three spheres
+	origin := Vec3{X: -10, Y: 5, Z: 0}
+	direction := Vec3{X: 20, Y: 0, Z: 0}
+
+	all := ps.CastRayGetHits(origin, direction, 16)
+	if len(all) < 3 {
+		t.Fatalf("got %d hits, expected at least 3", len(all))
+	}
+	for i := 1; i < len(all); i++ {
+		if all[i].Fraction < all[i-1].Fraction {
+			t.Fatalf("hits not sorted by fraction: %v", all)
+		}
+	}
+
+	// A buffer smaller than the number of hits keeps the closest ones
+	dst := make([]RaycastHit, 2)
+	n := ps.CastRayGetHitsInto(origin, direction, dst)
+	if n != 2 {
+		t.Fatalf("n = %d, expected 2", n)
+	}
+	for i := 0; i < n; i++ {
+		if dst[i].BodyID != all[i].BodyID || dst[i].Fraction != all[i].Fraction {
+			t.Errorf("hit %d: %+v, expected %+v", i, dst[i], all[i])
+		}
+	}
+}
+
+func TestQueryIntoDoesNotAllocate(t *testing.T) {
+	ps := newQueryTestWorld(t)
+
+	sphere := CreateSphere(1.0)
+	defer sphere.Destroy()
+
+	rayHits := make([]RaycastHit, 8)
+	shapeHits := make([]CollisionHit, 8)
+	origins := []Vec3{{X: 0, Y: 10, Z: 0}, {X: 4, Y: 10, Z: 0}}
+	directions := []Vec3{{X: 0, Y: -20, Z: 0}, {X: 0, Y: -20, Z: 0}}
+
+	allocs := testing.AllocsPerRun(100, func() {
+		ps.CastRayGetHitsInto(Vec3{X: 0, Y: 10, Z: 0}, Vec3{X: 0, Y: -20, Z: 0}, rayHits)
+		ps.CollideShapeGetHitsInto(sphere, Vec3{X: 0, Y: 5, Z: 0}, shapeHits, 0)
+		ps.CastRayBatch(origins, directions, rayHits)
+	})
+	if allocs != 0 {
+		t.Errorf("Into queries allocated %.1f times per run, expected 0", allocs)
+	}
+}
+
+func TestQueryOptionsIgnoreBodiesAndSensors(t *testing.T) {
+	ps := newQueryTestWorld(t)
+	bi := ps.GetBodyInterface()
+
+	origin := Vec3{X: 0, Y: 10, Z: 0}
+	direction := Vec3{X: 0, Y: -20, Z: 0}
+
+	sphereHit, ok := ps.CastRay(origin, direction)
+	if !ok || math.Abs(float64(sphereHit.HitPoint.Y-6)) > 0.01 {
+		t.Fatalf("unfiltered ray hit %+v, expected the sphere at Y=6", sphereHit)
+	}
+
+	// Ignoring the sphere lets the ray through to the floor
+	opts := NewQueryOptions()
+	opts.IgnoreBodies = []BodyID{sphereHit.BodyID}
+	hit, ok := ps.CastRayWithOptions(origin, direction, opts)
+	if !ok || math.Abs(float64(hit.HitPoint.Y-0.5)) > 0.01 {
+		t.Errorf("ray ignoring the sphere hit %+v, expected the floor at Y=0.5", hit)
+	}
+
+	shapeHits := make([]CollisionHit, 8)
+	probe := CreateSphere(1.5)
+	defer probe.Destroy()
+	if n := ps.CollideShapeGetHitsIntoWithOptions(probe, Vec3{X: 0, Y: 5, Z: 0}, shapeHits, 0, opts); n != 0 {
+		t.Errorf("overlap ignoring the sphere returned %d hits, expected 0", n)
+	}
+
+	// A sensor above the sphere is hit unless sensors are ignored
+	sensorShape := CreateSphere(0.5)
+	defer sensorShape.Destroy()
+	sensor := bi.CreateBody(sensorShape, Vec3{X: 0, Y: 8, Z: 0}, MotionTypeStatic, true)
+
+	if hit, ok := ps.CastRay(origin, direction); !ok || hit.BodyID != sensor {
+		t.Errorf("unfiltered ray hit %v, expected the sensor", hit.BodyID)
+	}
+	opts = NewQueryOptions()
+	opts.IgnoreSensors = true
+	if hit, ok := ps.CastRayWithOptions(origin, direction, opts); !ok || hit.BodyID != sphereHit.BodyID {
+		t.Errorf("ray ignoring sensors hit %v, expected the sphere", hit.BodyID)
+	}
+}
+
+func TestQueryOptionsLiteralHitsAllLayers(t *testing.T) {
+	ps := newQueryTestWorld(t)
+
+	origin := Vec3{X: 0, Y: 10, Z: 0}
+	direction := Vec3{X: 0, Y: -20, Z: 0}
+	sphereHit, ok := ps.CastRay(origin, direction)
+	if !ok {
+		t.Fatal("unfiltered ray should hit the sphere")
+	}
+
+	// A literal leaves LayerMask at zero, which must not filter out every layer
+	opts := &QueryOptions{IgnoreBodies: []BodyID{sphereHit.BodyID}}
+	hit, ok := ps.CastRayWithOptions(origin, direction, opts)
+	if !ok || math.Abs(float64(hit.HitPoint.Y-0.5)) > 0.01 {
+		t.Errorf("ray with literal options hit %+v, expected the floor at Y=0.5", hit)
+	}
+
+	probe := CreateSphere(1.5)
+	defer probe.Destroy()
+	if !ps.CollideShapeWithOptions(probe, Vec3{X: 4, Y: 5, Z: 0}, 0, &QueryOptions{}) {
+		t.Error("overlap with zero options should hit the sphere at X=4")
+	}
+}
+
+func TestQueryOptionsAnyHit(t *testing.T) {
+	ps := newQueryTestWorld(t)
+
+	// Horizontal ray through all three spheres: any of them is a valid answer
+	origins := []Vec3{{X: -10, Y: 5, Z: 0}, {X: 20, Y: 20, Z: 0}}
+	directions := []Vec3{{X: 20, Y: 0, Z: 0}, {X: 0, Y: 1, Z: 0}}
+
+	opts := NewQueryOptions()
+	opts.AnyHit = true
+	out := make([]RaycastHit, len(origins))
+	if n := ps.CastRayBatchWithOptions(origins, directions, out, opts); n != 1 {
+		t.Fatalf("any hit batch returned %d hits, expected 1", n)
+	}
+	if out[0].BodyID.IsInvalid() || math.Abs(float64(out[0].HitPoint.Y-5)) > 0.01 {
+		t.Errorf("any hit ray 0 = %+v, expected a hit on one of the spheres", out[0])
+	}
+	if !out[1].BodyID.IsInvalid() {
+		t.Errorf("any hit ray 1 should have missed")
+	}
+}
+
+func TestQueryWithOptionsDoesNotAllocate(t *testing.T) {
+	ps := newQueryTestWorld(t)
+
+	opts := NewQueryOptions()
+	opts.LayerMask = ObjectLayerNonMoving.Mask()
+	opts.IgnoreSensors = true
+	opts.AnyHit = true
+
+	rayHits := make([]RaycastHit, 8)
+	origins := []Vec3{{X: 0, Y: 10, Z: 0}, {X: 4, Y: 10, Z: 0}}
+	directions := []Vec3{{X: 0, Y: -20, Z: 0}, {X: 0, Y: -20, Z: 0}}
+
+	allocs := testing.AllocsPerRun(100, func() {
+		ps.CastRayGetHitsIntoWithOptions(Vec3{X: 0, Y: 10, Z: 0}, Vec3{X: 0, Y: -20, Z: 0}, rayHits, opts)
+		ps.CastRayBatchWithOptions(origins, directions, rayHits, opts)
+	})
+	if allocs != 0 {
+		t.Errorf("queries with options allocated %.1f times per run, expected 0", allocs)
+	}
+}
+
+func TestCastShape(t *testing.T) {
+	ps := newQueryTestWorld(t)
+
+	ball := CreateSphere(0.5)
+	defer ball.Destroy()
+
+	// Dropping the ball onto the middle sphere: it touches when its center reaches Y=6.5
+	cast := NewShapeCast(ball, Vec3{X: 0, Y: 10, Z: 0}, Quat{}, Vec3{X: 0, Y: -20, Z: 0})
+	hit, ok := ps.CastShape(cast, nil, nil)
+	if !ok {
+		t.Fatal("shape cast missed the sphere")
+	}
+	if math.Abs(float64(hit.Fraction-0.175)) > 0.01 {
+		t.Errorf("fraction = %v, expected 0.175", hit.Fraction)
+	}
+	if math.Abs(float64(hit.ContactPoint.Y-6)) > 0.01 || hit.Normal.Y < 0.99 {
+		t.Errorf("contact %v normal %v, expected the top of the sphere facing up", hit.ContactPoint, hit.Normal)
+	}
+
+	// Ignoring the sphere lets the ball through to the floor
+	opts := NewQueryOptions()
+	opts.IgnoreBodies = []BodyID{hit.BodyID}
+	floorHit, ok := ps.CastShape(cast, nil, opts)
+	if !ok || math.Abs(float64(floorHit.ContactPoint.Y-0.5)) > 0.01 {
+		t.Errorf("shape cast ignoring the sphere hit %+v, expected the floor at Y=0.5", floorHit)
+	}
+
+	// Sweeping away from everything misses
+	cast.Direction = Vec3{X: 0, Y: 20, Z: 0}
+	if miss, ok := ps.CastShape(cast, nil, nil); ok || !miss.BodyID.IsInvalid() {
+		t.Errorf("upward shape cast hit %+v, expected a miss", miss)
+	}
+}
+
+func TestCastShapeBatchMatchesSingle(t *testing.T) {
+	ps := newQueryTestWorld(t)
+
+	ball := CreateSphere(0.5)
+	defer ball.Destroy()
+
+	// Enough sweeps to be split into several batches in parallel mode
+	casts := make([]ShapeCast, 0, 64)
+	for i := 0; i < cap(casts); i++ {
+		x := float32(i%16) - 8
+		casts = append(casts, NewShapeCast(ball, Vec3{X: x, Y: 10, Z: float32(i/16) - 2}, Quat{}, Vec3{X: 0, Y: -20, Z: 0}))
+	}
+	casts[len(casts)-1].Position.X = 30 // off the edge of the floor
+
+	for _, parallel := range []bool{false, true} {
+		out := make([]ShapeCastHit, len(casts))
+		var numHits int
+		if parallel {
+			numHits = ps.CastShapeBatchParallel(casts, out, nil, nil)
+		} else {
+			numHits = ps.CastShapeBatch(casts, out, nil, nil)
+		}
+		if numHits != len(casts)-1 {
+			t.Errorf("parallel=%v: %d hits, expected %d", parallel, numHits, len(casts)-1)
+		}
+
+		for i, cast := range casts {
+			single, ok := ps.CastShape(cast, nil, nil)
+			if ok != !out[i].BodyID.IsInvalid() || single.BodyID != out[i].BodyID ||
+				math.Abs(float64(single.Fraction-out[i].Fraction)) > 1e-5 {
+				t.Errorf("parallel=%v cast %d: batch %+v, single %+v", parallel, i, out[i], single)
+			}
+		}
+	}
+}
+
+func TestCastShapeGetHitsIntoSorted(t *testing.T) {
+	ps := newQueryTestWorld(t)
+
+	// A ball swept horizontally at sphere height passes through all three spheres
+	ball := CreateSphere(0.25)
+	defer ball.Destroy()
+	cast := NewShapeCast(ball, Vec3{X: -10, Y: 5, Z: 0}, Quat{}, Vec3{X: 20, Y: 0, Z: 0})
+
+	all := make([]ShapeCastHit, 16)
+	n := ps.CastShapeGetHitsInto(cast, all, nil, nil)
+	if n != 3 {
+		t.Fatalf("got %d hits, expected 3", n)
+	}
+	for i := 1; i < n; i++ {
+		if all[i].Fraction < all[i-1].Fraction {
+			t.Fatalf("hits not sorted by fraction: %v", all[:n])
+		}
+	}
+
+	// A smaller buffer keeps the closest hits, and reusing it doesn't allocate
+	dst := make([]ShapeCastHit, 2)
+	allocs := testing.AllocsPerRun(50, func() {
+		n = ps.CastShapeGetHitsInto(cast, dst, nil, nil)
+	})
+	if n != 2 || dst[0].BodyID != all[0].BodyID || dst[1].BodyID != all[1].BodyID {
+		t.Errorf("closest two hits = %+v, expected %+v", dst[:n], all[:2])
+	}
+	if allocs != 0 {
+		t.Errorf("CastShapeGetHitsInto allocated %.1f times per run, expected 0", allocs)
+	}
+}
+
+func TestBroadPhaseQueries(t *testing.T) {
+	ps := newQueryTestWorld(t)
+
+	// Only the sphere at X=-4 is inside the box
+	dst := make([]BodyID, 8)
+	n := ps.CollideAABoxBroadPhaseInto(Vec3{X: -5, Y: 4, Z: -1}, Vec3{X: -3, Y: 6, Z: 1}, dst, nil)
+	if n != 1 {
+		t.Fatalf("box query found %d bodies, expected 1", n)
+	}
+	left := dst[0]
+	if pos := ps.GetBodyInterface().GetPosition(left); pos.X != -4 {
+		t.Errorf("box query found the body at %v, expected the sphere at X=-4", pos)
+	}
+
+	// A large sphere covers the floor and all spheres
+	if n := ps.CollideSphereBroadPhaseInto(Vec3{X: 0, Y: 3, Z: 0}, 20, dst, nil); n != 4 {
+		t.Errorf("sphere query found %d bodies, expected 4", n)
+	}
+
+	// A full buffer stops the query
+	if n := ps.CollideSphereBroadPhaseInto(Vec3{X: 0, Y: 3, Z: 0}, 20, dst[:2], nil); n != 2 {
+		t.Errorf("sphere query into 2 slots found %d bodies, expected 2", n)
+	}
+
+	// Options apply to broadphase queries too
+	opts := NewQueryOptions()
+	opts.IgnoreBodies = []BodyID{left}
+	if n := ps.CollideAABoxBroadPhaseInto(Vec3{X: -5, Y: 4, Z: -1}, Vec3{X: -3, Y: 6, Z: 1}, dst, opts); n != 0 {
+		t.Errorf("box query ignoring the sphere found %d bodies, expected 0", n)
+	}
+}
+
+func TestCollideBroadPhaseRegionsMatchesSingle(t *testing.T) {
+	ps := newQueryTestWorld(t)
+
+	regions := make([]BroadPhaseRegion, 0, 64)
+	for i := 0; i < cap(regions); i++ {
+		center := Vec3{X: float32(i%16) - 8, Y: 5, Z: 0}
+		if i%2 == 0 {
+			regions = append(regions, SphereRegion(center, 1.5))
+		} else {
+			regions = append(regions, BoxRegion(center.Sub(Vec3{X: 1, Y: 5, Z: 1}), center.Add(Vec3{X: 1, Y: 1, Z: 1})))
+		}
+	}
+
+	// Start smaller than needed, the results grow to fit
+	results := NewBroadPhaseRegionResults(4, 8)
+	single := make([]BodyID, 8)
+	for _, parallel := range []bool{false, true} {
+		var total int
+		if parallel {
+			total = ps.CollideBroadPhaseRegionsParallel(regions, results, nil)
+		} else {
+			total = ps.CollideBroadPhaseRegions(regions, results, nil)
+		}
+		if results.NumRegions() != len(regions) {
+			t.Fatalf("results hold %d regions, expected %d", results.NumRegions(), len(regions))
+		}
+
+		sum := 0
+		for i, region := range regions {
+			var n int
+			if region.Radius > 0 {
+				n = ps.CollideSphereBroadPhaseInto(region.Center, region.Radius, single, nil)
+			} else {
+				n = ps.CollideAABoxBroadPhaseInto(region.Center.Sub(region.HalfExtent), region.Center.Add(region.HalfExtent), single, nil)
+			}
+			got := results.Region(i)
+			sum += len(got)
+			if len(got) != n {
+				t.Errorf("parallel=%v region %d: batch found %v, single found %v", parallel, i, got, single[:n])
+				continue
+			}
+			for j := range got {
+				if got[j] != single[j] {
+					t.Errorf("parallel=%v region %d: batch found %v, single found %v", parallel, i, got, single[:n])
+					break
+				}
+			}
+		}
+		if total != sum {
+			t.Errorf("parallel=%v: total = %d, sum of regions = %d", parallel, total, sum)
+		}
+	}
+
+	allocs := testing.AllocsPerRun(50, func() {
+		ps.CollideBroadPhaseRegions(regions, results, nil)
+	})
+	if allocs != 0 {
+		t.Errorf("CollideBroadPhaseRegions allocated %.1f times per run, expected 0", allocs)
+	}
+}
+
+func TestConcurrentQueries(t *testing.T) {
+	ps := newQueryTestWorld(t)
+
+	sphere := CreateSphere(1.0)
+	defer sphere.Destroy()
+
+	// Enough rays that every parallel batch is split across worker threads
+	var origins, directions []Vec3
+	for i := 0; i < 256; i++ {
+		origins = append(origins, Vec3{X: float32(i%32)/2 - 8, Y: 10, Z: float32(i/32)/4 - 1})
+		directions = append(directions, Vec3{X: 0, Y: -20, Z: 0})
+	}
+	expected := make([]RaycastHit, len(origins))
+	expectedHits := ps.CastRayBatch(origins, directions, expected)
+	expectedSphere := ps.CollideShapeGetHits(sphere, Vec3{X: 0, Y: 5, Z: 0}, 8, 0)
+
+	// More goroutines than the job system has barriers, locking and lock-free queries mixed
+	const numGoroutines = 16
+	errs := make(chan string, numGoroutines)
+	var wg sync.WaitGroup
+	for g := 0; g < numGoroutines; g++ {
+		wg.Add(1)
+		go func(noLock bool) {
+			defer wg.Done()
+			opts := NewQueryOptions()
+			opts.NoLock = noLock
+			rayHits := make([]RaycastHit, len(origins))
+			shapeHits := make([]CollisionHit, 8)
+
+			for i := 0; i < 20; i++ {
+				if n := ps.CastRayBatchParallelWithOptions(origins, directions, rayHits, opts); n != expectedHits {
+					errs <- "parallel batch hit count differs"
+					return
+				}
+				for j := range rayHits {
+					if rayHits[j] != expected[j] {
+						errs <- "parallel batch hit differs"
+						return
+					}
+				}
+				if hit, ok := ps.CastRayWithOptions(origins[0], directions[0], opts); !ok || hit != expected[0] {
+					errs <- "single ray hit differs"
+					return
+				}
+				n := ps.CollideShapeGetHitsIntoWithOptions(sphere, Vec3{X: 0, Y: 5, Z: 0}, shapeHits, 0, opts)
+				if n != len(expectedSphere) || shapeHits[0] != expectedSphere[0] {
+					errs <- "shape hit differs"
+					return
+				}
+			}
+		}(g%2 == 1)
+	}
+	wg.Wait()
+	close(errs)
+	for err := range errs {
+		t.Error(err)
+	}
+}
+
+func TestQueryOptionsNoLockMatchesLocking(t *testing.T) {
+	ps := newQueryTestWorld(t)
+	opts := NewQueryOptions()
+	opts.NoLock = true
+
+	locked := make([]RaycastHit, 8)
+	unlocked := make([]RaycastHit, 8)
+	n := ps.CastRayGetHitsInto(Vec3{X: 0, Y: 10, Z: 0}, Vec3{X: 0, Y: -20, Z: 0}, locked)
+	if n == 0 || ps.CastRayGetHitsIntoWithOptions(Vec3{X: 0, Y: 10, Z: 0}, Vec3{X: 0, Y: -20, Z: 0}, unlocked, opts) != n {
+		t.Fatalf("expected the same hits with and without body locks")
+	}
+	for i := 0; i < n; i++ {
+		if locked[i] != unlocked[i] {
+			t.Errorf("hit %d: locked %+v, lock-free %+v", i, locked[i], unlocked[i])
+		}
+	}
+
+	bodies := make([]BodyID, 8)
+	if got, want := ps.CollideSphereBroadPhaseInto(Vec3{X: 0, Y: 5, Z: 0}, 10, bodies, opts), ps.CollideSphereBroadPhaseInto(Vec3{X: 0, Y: 5, Z: 0}, 10, bodies, nil); got != want {
+		t.Errorf("lock-free broadphase query found %d bodies, locking one %d", got, want)
+	}
+}
+
+func TestQueries64(t *testing.T) {
+	ps := NewPhysicsSystem()
+	defer ps.Destroy()
+	bi := ps.GetBodyInterface()
+
+	floor := CreateBox(Vec3{X: 10, Y: 0.5, Z: 10})
+	defer floor.Destroy()
+	base := RVec3{X: 40000, Y: 0, Z: -12000}
+	floorID := bi.CreateBody64(floor, base, MotionTypeStatic, false, ObjectLayerFromMotionType)
+
+	hit, hasHit := ps.CastRay64(base.Add(Vec3{X: 2, Y: 10, Z: 1}), Vec3{Y: -20}, nil)
+	if !hasHit || hit.BodyID != floorID {
+		t.Fatalf("ray hit = %+v (%v), expected the floor", hit, hasHit)
+	}
+	if d := hit.HitPoint.Sub(base.Add(Vec3{X: 2, Y: 0.5, Z: 1})); d.Length() > 1e-2 {
+		t.Errorf("hit point = %+v, off by %+v", hit.HitPoint, d)
+	}
+	if hit.Normal.Y < 0.99 {
+		t.Errorf("normal = %+v, expected up", hit.Normal)
+	}
+
+	if _, hasHit := ps.CastRay64(base.Add(Vec3{X: 50, Y: 10}), Vec3{Y: -20}, nil); hasHit {
+		t.Error("ray beside the floor should miss")
+	}
+
+	sphere := CreateSphere(1)
+	defer sphere.Destroy()
+	center := base.Add(Vec3{X: -3, Y: 1, Z: 4})
+	if !ps.CollideShape64(sphere, center, 0, nil) {
+		t.Error("sphere resting in the floor should collide")
+	}
+
+	hits := make([]CollisionHit64, 4)
+	n := ps.CollideShapeGetHitsInto64(sphere, center, hits, 0, nil)
+	if n != 1 || hits[0].BodyID != floorID {
+		t.Fatalf("got %d hits %+v, expected the floor", n, hits[:n])
+	}
+	// Contact points come back in world space, next to the query position
+	if d := hits[0].ContactPoint.Sub(center); d.Length() > 1.1 {
+		t.Errorf("contact point = %+v, %v from the sphere center", hits[0].ContactPoint, d.Length())
+	}
+}
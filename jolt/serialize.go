@@ -0,0 +1,141 @@
+package jolt
+
+// #include "wrapper/serialize.h"
+// #include "wrapper/shape.h"
+import "C"
+import (
+	"fmt"
+	"unsafe"
+)
+
+// takeBuffer copies a wrapper buffer into Go memory and frees it
+func takeBuffer(buffer C.JoltBuffer) []byte {
+	defer C.JoltDestroyBuffer(buffer)
+
+	size := int(C.JoltBufferSize(buffer))
+	data := make([]byte, size)
+	if size > 0 {
+		copy(data, unsafe.Slice((*byte)(C.JoltBufferData(buffer)), size))
+	}
+	return data
+}
+
+// SaveBinary serializes the cooked shape, including its sub shapes and a mesh's bounding volume tree, to
+// Jolt's binary state format. RestoreShapeBinary loads it again without recomputing anything, which is
+// much faster than CreateMesh for large meshes, so terrain can be cooked at build time and shipped baked.
+//
+// The data is tied to the Jolt version and build options it was saved with; other builds reject it.
+//
+// Example usage:
+//
+//	terrain := jolt.CreateMesh(vertices, indices) // slow: builds the BVH
+//	data, err := terrain.SaveBinary()
+//	if err != nil {
+//	    return err
+//	}
+//	os.WriteFile("terrain.shape", data, 0o644)
+func (s *Shape) SaveBinary() ([]byte, error) {
+	buffer := C.JoltShapeSaveBinary(s.handle)
+	if buffer == nil {
+		return nil, fmt.Errorf("failed to save shape")
+	}
+	return takeBuffer(buffer), nil
+}
+
+// RestoreShapeBinary loads a shape saved with Shape.SaveBinary. The data is only read during the call and
+// is not retained, so it may be memory-mapped and unmapped right after. Release the shape with Destroy.
+//
+// Only restore trusted data: the stream is checked for truncation and version, not for malicious content.
+//
+// Example usage:
+//
+//	f, _ := os.Open("terrain.shape")
+//	info, _ := f.Stat()
+//	data, _ := syscall.Mmap(int(f.Fd()), 0, int(info.Size()), syscall.PROT_READ, syscall.MAP_SHARED)
+//	terrain, err := jolt.RestoreShapeBinary(data)
+//	syscall.Munmap(data)
+func RestoreShapeBinary(data []byte) (*Shape, error) {
+	if len(data) == 0 {
+		return nil, fmt.Errorf("no shape data")
+	}
+
+	handle := C.JoltShapeRestoreBinary(unsafe.Pointer(&data[0]), C.size_t(len(data)))
+	if handle == nil {
+		return nil, fmt.Errorf("invalid shape data or saved by a different Jolt build")
+	}
+	return &Shape{handle: handle}, nil
+}
+
+// SaveScene serializes every body in the world as it would be created: shape, position, rotation, motion type,
+// object layer, sensor flag and the other creation settings. Shapes shared by several bodies are stored once.
+// Velocities, sleep state and characters are not part of the scene.
+//
+// Use it to bake a level once and load it with LoadScene on every server start.
+// Must not be called while the physics system is updating.
+func (ps *PhysicsSystem) SaveScene() ([]byte, error) {
+	buffer := C.JoltPhysicsSystemSaveScene(ps.handle)
+	if buffer == nil {
+		return nil, fmt.Errorf("failed to save scene")
+	}
+	return takeBuffer(buffer), nil
+}
+
+// Scene is a set of bodies restored from SaveScene data. The shapes are restored once, so the same scene can
+// populate any number of worlds (e.g. one per match) without reading or cooking the level again.
+type Scene struct {
+	handle C.JoltScene
+}
+
+// LoadScene restores a scene saved with PhysicsSystem.SaveScene. The data is only read during the call and
+// is not retained, so it may be memory-mapped. Free the scene with Destroy; bodies created from it stay valid.
+//
+// Example usage:
+//
+//	scene, err := jolt.LoadScene(data)
+//	if err != nil {
+//	    return err
+//	}
+//	defer scene.Destroy()
+//
+//	ids := scene.CreateBodies(ps, true)
+//	ps.OptimizeBroadPhase()
+func LoadScene(data []byte) (*Scene, error) {
+	if len(data) == 0 {
+		return nil, fmt.Errorf("no scene data")
+	}
+
+	handle := C.JoltSceneRestoreBinary(unsafe.Pointer(&data[0]), C.size_t(len(data)))
+	if handle == nil {
+		return nil, fmt.Errorf("invalid scene data or saved by a different Jolt build")
+	}
+	return &Scene{handle: handle}, nil
+}
+
+// Destroy frees the scene
+func (s *Scene) Destroy() {
+	C.JoltDestroyScene(s.handle)
+}
+
+// NumBodies returns the number of bodies in the scene
+func (s *Scene) NumBodies() int {
+	return int(C.JoltSceneGetNumBodies(s.handle))
+}
+
+// CreateBodies creates the bodies of the scene in a world and adds them as one broadphase batch, like
+// BodyInterface.CreateBodies. Body IDs are assigned by the target world, so they are returned in scene order
+// (InvalidBodyID for bodies that could not be created, e.g. when the world is full).
+//
+// Parameters:
+//   - ps: The world to create the bodies in
+//   - activate: If true, the kinematic and dynamic bodies start active
+//
+// Returns: One ID per scene body
+func (s *Scene) CreateBodies(ps *PhysicsSystem, activate bool) []BodyID {
+	ids := make([]BodyID, s.NumBodies())
+	if len(ids) == 0 {
+		return ids
+	}
+
+	C.JoltSceneCreateBodies(s.handle, ps.handle, (*C.JoltBodyID)(unsafe.Pointer(&ids[0])), C.int(boolToInt(activate)))
+	return ids
+}
@@ -0,0 +1,88 @@
+package jolt
+
+import (
+	"math"
+	"testing"
+)
+
+func TestShapeSaveRestoreBinary(t *testing.T) {
+	// 20x20 quad at Y=0 made of two triangles
+	vertices := []Vec3{{X: -10, Y: 0, Z: -10}, {X: 10, Y: 0, Z: -10}, {X: 10, Y: 0, Z: 10}, {X: -10, Y: 0, Z: 10}}
+	mesh := CreateMesh(vertices, []int32{0, 2, 1, 0, 3, 2})
+	defer mesh.Destroy()
+
+	data, err := mesh.SaveBinary()
+	if err != nil {
+		t.Fatalf("SaveBinary: %v", err)
+	}
+
+	restored, err := RestoreShapeBinary(data)
+	if err != nil {
+		t.Fatalf("RestoreShapeBinary: %v", err)
+	}
+	defer restored.Destroy()
+
+	settings := DefaultRayCastSettings()
+	ray := RRayCast{Origin: Vec3{X: 3, Y: 5, Z: -2}, Direction: Vec3{X: 0, Y: -10, Z: 0}}
+	var original, loaded RayCastResult
+	if !mesh.CastRay(ray, settings, &original) || !restored.CastRay(ray, settings, &loaded) {
+		t.Fatal("ray should hit both the original and the restored mesh")
+	}
+	if math.Abs(float64(original.Fraction-loaded.Fraction)) > 1e-6 {
+		t.Errorf("restored mesh hit fraction %.4f, original %.4f", loaded.Fraction, original.Fraction)
+	}
+
+	// Truncated data and data of the wrong kind are rejected
+	if _, err := RestoreShapeBinary(data[:len(data)/2]); err == nil {
+		t.Error("restoring truncated shape data should fail")
+	}
+	if _, err := LoadScene(data); err == nil {
+		t.Error("loading shape data as a scene should fail")
+	}
+	if _, err := RestoreShapeBinary(nil); err == nil {
+		t.Error("restoring empty data should fail")
+	}
+}
+
+func TestSceneSaveLoad(t *testing.T) {
+	src := newQueryTestWorld(t)
+
+	data, err := src.SaveScene()
+	if err != nil {
+		t.Fatalf("SaveScene: %v", err)
+	}
+
+	scene, err := LoadScene(data)
+	if err != nil {
+		t.Fatalf("LoadScene: %v", err)
+	}
+	defer scene.Destroy()
+
+	if scene.NumBodies() != 4 {
+		t.Fatalf("NumBodies = %d, expected 4", scene.NumBodies())
+	}
+
+	// The same scene can populate several worlds
+	for i := 0; i < 2; i++ {
+		ps := NewPhysicsSystem()
+		t.Cleanup(ps.Destroy)
+
+		ids := scene.CreateBodies(ps, false)
+		if len(ids) != 4 {
+			t.Fatalf("world %d: CreateBodies returned %d IDs, expected 4", i, len(ids))
+		}
+		for _, id := range ids {
+			if id.IsInvalid() {
+				t.Fatalf("world %d: body could not be created", i)
+			}
+		}
+
+		// Same geometry as the source world: sphere top at Y=6, floor top at Y=0.5
+		for _, c := range []struct{ x, y float32 }{{-4, 6}, {0, 6}, {8, 0.5}} {
+			hit, ok := ps.CastRay(Vec3{X: c.x, Y: 10, Z: 0}, Vec3{X: 0, Y: -20, Z: 0})
+			if !ok || math.Abs(float64(hit.HitPoint.Y-c.y)) > 0.01 {
+				t.Errorf("world %d: ray at X=%.0f hit Y=%.2f (%v), expected %.2f", i, c.x, hit.HitPoint.Y, ok, c.y)
+			}
+		}
+	}
+}
@@ -2,6 +2,10 @@ package jolt
 
 // #include "wrapper/shape.h"
 import "C"
+import (
+	"fmt"
+	"unsafe"
+)
 
 // Shape represents collision geometry that can be used to create bodies
 type Shape struct {
@@ -42,18 +46,15 @@ func CreateCapsule(halfHeight, radius float32) *Shape {
 }
 
 // CreateConvexHullShape creates a convex hull collision shape from a set of points
-// points: slice of Vec3 vertices that define the convex hull
+// points: slice of Vec3 vertices that define the convex hull (read in place, Vec3 is three packed float32s)
 func CreateConvexHull(points []Vec3) *Shape {
-	// Flatten Vec3 slice to float array
-	floatPoints := make([]C.float, len(points)*3)
-	for i, p := range points {
-		floatPoints[i*3] = C.float(p.X)
-		floatPoints[i*3+1] = C.float(p.Y)
-		floatPoints[i*3+2] = C.float(p.Z)
+	var cPoints *C.float
+	if len(points) > 0 {
+		cPoints = (*C.float)(unsafe.Pointer(&points[0]))
 	}
 
 	handle := C.JoltCreateConvexHull(
-		&floatPoints[0],
+		cPoints,
 		C.int(len(points)),
 	)
 	return &Shape{handle: handle}
@@ -64,29 +65,90 @@ func CreateConvexHull(points []Vec3) *Shape {
 // indices: slice of triangle indices (must be multiple of 3, each triangle is 3 indices)
 // Note: Mesh shapes are typically used for static geometry (e.g., terrain, buildings)
 func CreateMesh(vertices []Vec3, indices []int32) *Shape {
-	// Flatten Vec3 slice to float array
-	floatVertices := make([]C.float, len(vertices)*3)
-	for i, v := range vertices {
-		floatVertices[i*3] = C.float(v.X)
-		floatVertices[i*3+1] = C.float(v.Y)
-		floatVertices[i*3+2] = C.float(v.Z)
-	}
-
-	// Convert int32 slice to C int array
-	cIndices := make([]C.int, len(indices))
-	for i, idx := range indices {
-		cIndices[i] = C.int(idx)
+	var cVertices *C.float
+	var cIndices *C.int
+	if len(vertices) > 0 && len(indices) > 0 {
+		// Both slices already have the C layout, so they are passed without conversion
+		cVertices = (*C.float)(unsafe.Pointer(&vertices[0]))
+		cIndices = (*C.int)(unsafe.Pointer(&indices[0]))
 	}
 
 	handle := C.JoltCreateMesh(
-		&floatVertices[0],
+		cVertices,
 		C.int(len(vertices)),
-		&cIndices[0],
+		cIndices,
 		C.int(len(indices)),
 	)
 	return &Shape{handle: handle}
 }
 
+// shapeErrorSize is the size of the buffer receiving a shape creation error message
+const shapeErrorSize = 256
+
+// CreateConvexHullFromPoints creates a convex hull collision shape from packed xyz coordinates, as loaded from
+// an asset file. Unlike CreateConvexHull it reports why Jolt rejected the points (e.g. too few, or all coplanar).
+//
+// Parameters:
+//   - points: x, y, z of each point (len must be a multiple of 3), read in place
+//
+// Returns: The shape, or an error with Jolt's message if no hull could be built
+func CreateConvexHullFromPoints(points []float32) (*Shape, error) {
+	if len(points) < 3 || len(points)%3 != 0 {
+		return nil, fmt.Errorf("convex hull needs xyz triples, got %d floats", len(points))
+	}
+
+	var errBuf [shapeErrorSize]C.char
+	handle := C.JoltCreateConvexHullWithError(
+		(*C.float)(unsafe.Pointer(&points[0])),
+		C.int(len(points)/3),
+		&errBuf[0], shapeErrorSize,
+	)
+	if handle == nil {
+		return nil, fmt.Errorf("failed to create convex hull: %s", C.GoString(&errBuf[0]))
+	}
+	return &Shape{handle: handle}, nil
+}
+
+// CreateIndexedMesh creates a mesh collision shape from an indexed triangle list, as loaded from an asset file.
+// Jolt consumes the vertex and index arrays directly instead of expanding them into one vertex triple per
+// triangle, which roughly halves peak memory when cooking large terrain. Neither slice is converted on the Go
+// side or retained after the call.
+//
+// Parameters:
+//   - vertices: x, y, z of each vertex (len must be a multiple of 3)
+//   - indices: three vertex indices per triangle, counter clockwise when seen from the front
+//
+// Returns: The shape, or an error for out of range indices or if Jolt rejects the mesh
+//
+// Example usage:
+//
+//	terrain, err := jolt.CreateIndexedMesh(asset.Positions, asset.Indices)
+//	if err != nil {
+//	    return err
+//	}
+//	defer terrain.Destroy()
+func CreateIndexedMesh(vertices []float32, indices []uint32) (*Shape, error) {
+	if len(vertices) == 0 || len(vertices)%3 != 0 {
+		return nil, fmt.Errorf("mesh needs xyz vertex triples, got %d floats", len(vertices))
+	}
+	if len(indices) == 0 || len(indices)%3 != 0 {
+		return nil, fmt.Errorf("mesh needs three indices per triangle, got %d indices", len(indices))
+	}
+
+	var errBuf [shapeErrorSize]C.char
+	handle := C.JoltCreateIndexedMesh(
+		(*C.float)(unsafe.Pointer(&vertices[0])),
+		C.int(len(vertices)/3),
+		(*C.uint)(unsafe.Pointer(&indices[0])),
+		C.int(len(indices)),
+		&errBuf[0], shapeErrorSize,
+	)
+	if handle == nil {
+		return nil, fmt.Errorf("failed to create mesh: %s", C.GoString(&errBuf[0]))
+	}
+	return &Shape{handle: handle}, nil
+}
+
 // RRayCast represents a ray for raycasting against shapes
 type RRayCast struct {
 	Origin    Vec3 // Starting point of the ray
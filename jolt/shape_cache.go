@@ -0,0 +1,113 @@
+package jolt
+
+// #include "wrapper/shape_cache.h"
+import "C"
+import "unsafe"
+
+// ShapeCache deduplicates shapes: asking for a shape with the same parameters returns the same Jolt shape,
+// so thousands of identical props share one shape instead of each building their own. Convex hulls and
+// meshes are keyed by a 64-bit hash of their input data, so identical input is only built once. The cache
+// keeps a copy of that input and compares it on every hit, so a hash collision never returns another mesh.
+//
+// Every shape returned by the cache holds its own reference and must be released with Destroy, exactly like
+// shapes from CreateSphere and friends. The cache keeps one reference of its own until the shape is purged
+// or the cache is destroyed. A ShapeCache is safe to use from multiple goroutines.
+//
+// Example usage:
+//
+//	cache := jolt.NewShapeCache()
+//	defer cache.Destroy()
+//
+//	for _, crate := range level.Crates {
+//	    shape := cache.Box(crate.HalfExtent) // built once per distinct size
+//	    bi.CreateBody(shape, crate.Position, jolt.MotionTypeDynamic, false)
+//	    shape.Destroy() // the body keeps its own reference
+//	}
+type ShapeCache struct {
+	handle C.JoltShapeCache
+}
+
+// NewShapeCache creates an empty shape cache
+func NewShapeCache() *ShapeCache {
+	return &ShapeCache{handle: C.JoltCreateShapeCache()}
+}
+
+// Destroy releases the cache's references. Shapes handed out by the cache stay valid until they are destroyed.
+func (c *ShapeCache) Destroy() {
+	C.JoltDestroyShapeCache(c.handle)
+}
+
+// cachedShape wraps a shape returned by the cache (nil if it could not be created)
+func cachedShape(handle C.JoltShape) *Shape {
+	if handle == nil {
+		return nil
+	}
+	return &Shape{handle: handle}
+}
+
+// Sphere returns the cached sphere shape with the given radius (nil if the radius is invalid)
+func (c *ShapeCache) Sphere(radius float32) *Shape {
+	return cachedShape(C.JoltShapeCacheGetSphere(c.handle, C.float(radius)))
+}
+
+// Box returns the cached box shape with the given half extents (nil if they are invalid)
+func (c *ShapeCache) Box(halfExtent Vec3) *Shape {
+	return cachedShape(C.JoltShapeCacheGetBox(
+		c.handle,
+		C.float(halfExtent.X),
+		C.float(halfExtent.Y),
+		C.float(halfExtent.Z),
+	))
+}
+
+// Capsule returns the cached capsule shape with the given half height and radius (nil if they are invalid)
+func (c *ShapeCache) Capsule(halfHeight, radius float32) *Shape {
+	return cachedShape(C.JoltShapeCacheGetCapsule(c.handle, C.float(halfHeight), C.float(radius)))
+}
+
+// ConvexHull returns the cached convex hull of points, building it the first time these exact points are seen
+// (nil if no hull can be built from them)
+func (c *ShapeCache) ConvexHull(points []Vec3) *Shape {
+	if len(points) == 0 {
+		return nil
+	}
+
+	// Vec3 is three packed float32s, so the points are hashed and read in place
+	return cachedShape(C.JoltShapeCacheGetConvexHull(
+		c.handle,
+		(*C.float)(unsafe.Pointer(&points[0])),
+		C.int(len(points)),
+	))
+}
+
+// Mesh returns the cached mesh shape for vertices and indices, building it the first time this exact input is
+// seen (nil if no mesh can be built from it)
+func (c *ShapeCache) Mesh(vertices []Vec3, indices []int32) *Shape {
+	if len(vertices) == 0 || len(indices) == 0 {
+		return nil
+	}
+
+	return cachedShape(C.JoltShapeCacheGetMesh(
+		c.handle,
+		(*C.float)(unsafe.Pointer(&vertices[0])),
+		C.int(len(vertices)),
+		(*C.int)(unsafe.Pointer(&indices[0])),
+		C.int(len(indices)),
+	))
+}
+
+// Len returns the number of shapes in the cache
+func (c *ShapeCache) Len() int {
+	return int(C.JoltShapeCacheCount(c.handle))
+}
+
+// Purge drops the shapes that are no longer referenced by anything but the cache (no bodies, characters
+// or unreleased handles), e.g. after unloading a level. Returns the number of shapes dropped.
+func (c *ShapeCache) Purge() int {
+	return int(C.JoltShapeCachePurge(c.handle))
+}
+
+// SameShape reports whether two shape handles refer to the same Jolt shape
+func (s *Shape) SameShape(other *Shape) bool {
+	return s.handle == other.handle
+}
@@ -0,0 +1,76 @@
+package jolt
+
+import "testing"
+
+func TestShapeCacheDeduplicates(t *testing.T) {
+	cache := NewShapeCache()
+	defer cache.Destroy()
+
+	a := cache.Box(Vec3{X: 1, Y: 2, Z: 3})
+	b := cache.Box(Vec3{X: 1, Y: 2, Z: 3})
+	c := cache.Box(Vec3{X: 1, Y: 2, Z: 4})
+	defer a.Destroy()
+	defer b.Destroy()
+	defer c.Destroy()
+	if !a.SameShape(b) {
+		t.Error("identical boxes should share a shape")
+	}
+	if a.SameShape(c) {
+		t.Error("different boxes should not share a shape")
+	}
+
+	// A sphere and a capsule with the same numbers are different shapes
+	sphere := cache.Sphere(1)
+	capsule := cache.Capsule(1, 1)
+	defer sphere.Destroy()
+	defer capsule.Destroy()
+	if sphere.SameShape(capsule) {
+		t.Error("sphere and capsule should not share a shape")
+	}
+
+	points := []Vec3{{X: 0, Y: 0, Z: 0}, {X: 1, Y: 0, Z: 0}, {X: 0, Y: 1, Z: 0}, {X: 0, Y: 0, Z: 1}}
+	hull1 := cache.ConvexHull(points)
+	hull2 := cache.ConvexHull(append([]Vec3(nil), points...))
+	defer hull1.Destroy()
+	defer hull2.Destroy()
+	if !hull1.SameShape(hull2) {
+		t.Error("hulls from identical points should share a shape")
+	}
+
+	vertices := []Vec3{{X: 0, Y: 0, Z: 0}, {X: 1, Y: 0, Z: 0}, {X: 0, Y: 0, Z: 1}}
+	mesh1 := cache.Mesh(vertices, []int32{0, 1, 2})
+	mesh2 := cache.Mesh(vertices, []int32{0, 2, 1})
+	defer mesh1.Destroy()
+	defer mesh2.Destroy()
+	if mesh1.SameShape(mesh2) {
+		t.Error("meshes with different winding should not share a shape")
+	}
+
+	if cache.Sphere(-1) != nil {
+		t.Error("sphere with a negative radius should fail")
+	}
+}
+
+func TestShapeCachePurge(t *testing.T) {
+	cache := NewShapeCache()
+	defer cache.Destroy()
+
+	ps := NewPhysicsSystem()
+	defer ps.Destroy()
+
+	// One shape is held by a body, the other one is released
+	used := cache.Sphere(0.5)
+	ps.GetBodyInterface().CreateBody(used, Vec3{X: 0, Y: 0, Z: 0}, MotionTypeStatic, false)
+	used.Destroy()
+	cache.Sphere(2).Destroy()
+
+	if n := cache.Len(); n != 2 {
+		t.Fatalf("cache holds %d shapes, expected 2", n)
+	}
+	if n := cache.Purge(); n != 1 {
+		t.Errorf("Purge dropped %d shapes, expected 1", n)
+	}
+	if n := cache.Len(); n != 1 {
+		t.Errorf("cache holds %d shapes after Purge, expected 1", n)
+	}
+}
@@ -276,3 +276,48 @@ func TestTransformedShapeWithBox(t *testing.T) {
 		}
 	})
 }
+
+func TestCreateIndexedMesh(t *testing.T) {
+	// 20x20 quad at Y=0 made of two triangles sharing an edge
+	vertices := []float32{-10, 0, -10, 10, 0, -10, 10, 0, 10, -10, 0, 10}
+	mesh, err := CreateIndexedMesh(vertices, []uint32{0, 2, 1, 0, 3, 2})
+	if err != nil {
+		t.Fatalf("CreateIndexedMesh: %v", err)
+	}
+	defer mesh.Destroy()
+
+	ray := RRayCast{Origin: Vec3{X: -5, Y: 5, Z: 5}, Direction: Vec3{X: 0, Y: -10, Z: 0}}
+	var result RayCastResult
+	if !mesh.CastRay(ray, DefaultRayCastSettings(), &result) {
+		t.Fatal("ray should hit the mesh")
+	}
+	if math.Abs(float64(result.Fraction-0.5)) > 1e-4 {
+		t.Errorf("hit fraction = %.4f, expected 0.5", result.Fraction)
+	}
+
+	if _, err := CreateIndexedMesh(vertices, []uint32{0, 1, 4}); err == nil {
+		t.Error("out of range index should fail")
+	}
+	if _, err := CreateIndexedMesh(vertices, []uint32{0, 1}); err == nil {
+		t.Error("incomplete triangle should fail")
+	}
+	if _, err := CreateIndexedMesh(vertices[:4], []uint32{0, 1, 2}); err == nil {
+		t.Error("incomplete vertex should fail")
+	}
+}
+
+func TestCreateConvexHullFromPoints(t *testing.T) {
+	hull, err := CreateConvexHullFromPoints([]float32{0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1})
+	if err != nil {
+		t.Fatalf("CreateConvexHullFromPoints: %v", err)
+	}
+	hull.Destroy()
+
+	// Jolt rejects a hull of identical points and the message is passed through
+	if _, err := CreateConvexHullFromPoints([]float32{1, 1, 1, 1, 1, 1, 1, 1, 1}); err == nil {
+		t.Error("degenerate hull should fail")
+	}
+	if _, err := CreateConvexHullFromPoints(nil); err == nil {
+		t.Error("empty hull should fail")
+	}
+}
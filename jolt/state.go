@@ -0,0 +1,104 @@
+package jolt
+
+// #include "wrapper/state.h"
+import "C"
+import (
+	"fmt"
+	"unsafe"
+)
+
+// StateFlags selects the parts of the simulation state SaveState records
+type StateFlags int
+
+const (
+	StateGlobal      StateFlags = C.JOLT_STATE_GLOBAL      // Gravity
+	StateBodies      StateFlags = C.JOLT_STATE_BODIES      // Body transforms, velocities and sleep state
+	StateContacts    StateFlags = C.JOLT_STATE_CONTACTS    // Contact cache, needed to continue the simulation exactly
+	StateConstraints StateFlags = C.JOLT_STATE_CONSTRAINTS // Constraint state
+	StateAll         StateFlags = C.JOLT_STATE_ALL         // Everything, what rollback needs
+)
+
+// SaveState records the simulation state of the world (body transforms, velocities and sleep state, the
+// contact cache, constraint state and gravity) into dst and returns the snapshot, which uses dst's memory
+// when it is big enough. Reuse the returned slice for the next snapshot and saving costs no allocations.
+//
+// Parameters:
+//   - dst: Buffer to save into (can be nil); it grows if the state doesn't fit
+//   - flags: The parts of the state to save, StateAll for rollback
+//   - activeBodiesOnly: Only save the awake bodies and their contacts. Much smaller for worlds that are
+//     mostly static or asleep, but restoring the snapshot leaves bodies that were asleep when it was taken
+//     alone, so bodies woken up since keep their new state.
+//
+// A snapshot is not a scene: it holds no shapes or body settings and is only restored into the same world,
+// with the same bodies. Characters are saved separately with CharacterVirtual.SaveState. Events, stats and
+// the FixedTimestep accumulator are not part of the state. Must not be called during Update.
+//
+// Example usage:
+//
+//	// Rollback: resimulate from the last confirmed tick with the corrected inputs
+//	snapshot = ps.SaveState(snapshot, jolt.StateAll, false) // at the confirmed tick
+//	...
+//	if err := ps.RestoreState(snapshot); err != nil {
+//	    return err
+//	}
+//	for tick := confirmed; tick < now; tick++ {
+//	    applyInputs(tick)
+//	    ps.Update(dt)
+//	}
+func (ps *PhysicsSystem) SaveState(dst []byte, flags StateFlags, activeBodiesOnly bool) []byte {
+	return saveInto(dst, func(data unsafe.Pointer, capacity C.size_t) C.size_t {
+		return C.JoltPhysicsSystemSaveState(ps.handle, C.int(flags), C.int(boolToInt(activeBodiesOnly)), data, capacity)
+	})
+}
+
+// RestoreState restores a snapshot taken with SaveState. The world must hold the same bodies as when the
+// snapshot was taken; bodies left out of the snapshot keep their current state. The data is only read during
+// the call. Must not be called during Update.
+func (ps *PhysicsSystem) RestoreState(data []byte) error {
+	if len(data) == 0 {
+		return fmt.Errorf("no state data")
+	}
+	if C.JoltPhysicsSystemRestoreState(ps.handle, unsafe.Pointer(&data[0]), C.size_t(len(data))) == 0 {
+		return fmt.Errorf("state does not match the physics system")
+	}
+	return nil
+}
+
+// SaveState records the state of the character (position, rotation, velocity, ground and contact state)
+// into dst, like PhysicsSystem.SaveState. Save and restore the characters together with their world.
+func (cv *CharacterVirtual) SaveState(dst []byte) []byte {
+	return saveInto(dst, func(data unsafe.Pointer, capacity C.size_t) C.size_t {
+		return C.JoltCharacterVirtualSaveState(cv.handle, data, capacity)
+	})
+}
+
+// RestoreState restores a character state saved with CharacterVirtual.SaveState
+func (cv *CharacterVirtual) RestoreState(data []byte) error {
+	if len(data) == 0 {
+		return fmt.Errorf("no state data")
+	}
+	if C.JoltCharacterVirtualRestoreState(cv.handle, unsafe.Pointer(&data[0]), C.size_t(len(data))) == 0 {
+		return fmt.Errorf("truncated character state")
+	}
+	return nil
+}
+
+// saveInto runs a wrapper save function on dst's full capacity, growing dst and saving again if the state
+// didn't fit. The save functions return the size they needed.
+func saveInto(dst []byte, save func(data unsafe.Pointer, capacity C.size_t) C.size_t) []byte {
+	for {
+		dst = dst[:cap(dst)]
+		var data unsafe.Pointer
+		if len(dst) > 0 {
+			data = unsafe.Pointer(&dst[0])
+		}
+
+		size := int(save(data, C.size_t(len(dst))))
+		if size <= len(dst) {
+			return dst[:size]
+		}
+
+		// Leave some headroom, snapshots of a running world grow and shrink a little with its contacts
+		dst = make([]byte, size+size/8)
+	}
+}
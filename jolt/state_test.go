@@ -0,0 +1,118 @@
+package jolt
+
+import "testing"
+
+// newStateTestWorld creates a static floor with a stack of dynamic boxes falling onto it
+func newStateTestWorld(t *testing.T) (*PhysicsSystem, []BodyID) {
+	t.Helper()
+
+	ps := NewPhysicsSystem()
+	t.Cleanup(ps.Destroy)
+	bi := ps.GetBodyInterface()
+
+	floor := CreateBox(Vec3{X: 20, Y: 0.5, Z: 20})
+	defer floor.Destroy()
+	box := CreateBox(Vec3{X: 0.5, Y: 0.5, Z: 0.5})
+	defer box.Destroy()
+
+	settings := []BodyCreationSettings{NewBodyCreationSettings(floor, Vec3{}, MotionTypeStatic)}
+	for i := 0; i < 8; i++ {
+		settings = append(settings, NewBodyCreationSettings(box, Vec3{X: float32(i%2) * 0.3, Y: 1.5 + float32(i)*1.1, Z: 0}, MotionTypeDynamic))
+	}
+	ids := bi.CreateBodies(settings, true)
+	return ps, ids[1:]
+}
+
+func TestSaveRestoreStateResimulatesExactly(t *testing.T) {
+	ps, boxes := newStateTestWorld(t)
+	bi := ps.GetBodyInterface()
+	const dt = float32(1.0 / 60.0)
+
+	// Let the stack make contact so the contact cache is part of the state
+	for i := 0; i < 30; i++ {
+		ps.Update(dt)
+	}
+	snapshot := ps.SaveState(nil, StateAll, false)
+
+	type transform struct {
+		position Vec3
+		rotation Quat
+	}
+	simulate := func() []transform {
+		for i := 0; i < 60; i++ {
+			ps.Update(dt)
+		}
+		out := make([]transform, len(boxes))
+		for i, id := range boxes {
+			out[i] = transform{bi.GetPosition(id), bi.GetRotation(id)}
+		}
+		return out
+	}
+
+	first := simulate()
+	if err := ps.RestoreState(snapshot); err != nil {
+		t.Fatal(err)
+	}
+	second := simulate()
+
+	// Rolling back and stepping again must reproduce the same bits
+	for i := range first {
+		if first[i] != second[i] {
+			t.Fatalf("box %d after rollback = %+v, first run %+v", i, second[i], first[i])
+		}
+	}
+}
+
+func TestSaveStateReusesBuffer(t *testing.T) {
+	ps, _ := newStateTestWorld(t)
+	ps.Update(1.0 / 60.0)
+
+	snapshot := ps.SaveState(nil, StateAll, false)
+	if len(snapshot) == 0 {
+		t.Fatal("empty snapshot")
+	}
+
+	allocs := testing.AllocsPerRun(10, func() {
+		snapshot = ps.SaveState(snapshot, StateAll, false)
+		if err := ps.RestoreState(snapshot); err != nil {
+			t.Fatal(err)
+		}
+	})
+	if allocs != 0 {
+		t.Errorf("save and restore allocated %v times per run, expected 0", allocs)
+	}
+
+	// The static floor is left out of an active-only snapshot
+	active := ps.SaveState(nil, StateAll, true)
+	if len(active) == 0 || len(active) >= len(snapshot) {
+		t.Errorf("active-only snapshot is %d bytes, full snapshot %d", len(active), len(snapshot))
+	}
+	if err := ps.RestoreState(active); err != nil {
+		t.Errorf("restoring an active-only snapshot: %v", err)
+	}
+
+	if err := ps.RestoreState(snapshot[:len(snapshot)/2]); err == nil {
+		t.Error("expected an error for a truncated snapshot")
+	}
+}
+
+func TestCharacterSaveRestoreState(t *testing.T) {
+	ps, capsule := newCharacterTestWorld(t)
+	character := ps.CreateCharacterVirtual(NewCharacterVirtualSettings(capsule), Vec3{X: 0, Y: 1, Z: 0})
+	defer character.Destroy()
+
+	character.SetLinearVelocity(Vec3{X: 2, Y: 0, Z: 0})
+	state := character.SaveState(nil)
+
+	character.SetPosition(Vec3{X: 10, Y: 5, Z: 10})
+	character.SetLinearVelocity(Vec3{})
+	if err := character.RestoreState(state); err != nil {
+		t.Fatal(err)
+	}
+	if p := character.GetPosition(); p != (Vec3{X: 0, Y: 1, Z: 0}) {
+		t.Errorf("position = %+v after restore", p)
+	}
+	if v := character.GetLinearVelocity(); v != (Vec3{X: 2, Y: 0, Z: 0}) {
+		t.Errorf("velocity = %+v after restore", v)
+	}
+}
@@ -0,0 +1,164 @@
+package jolt
+
+// #include <stdlib.h>
+// #include "wrapper/stats.h"
+import "C"
+import (
+	"fmt"
+	"time"
+	"unsafe"
+)
+
+// PhaseTiming is the time spent in one kind of physics job during the last update.
+// Jolt splits an update into jobs per phase (broadphase update, find collisions, solve velocity
+// constraints, ...); the time of all jobs with the same name is summed over all threads, so a phase
+// that ran on 4 threads for 1ms reports about 4ms.
+type PhaseTiming struct {
+	// Name is Jolt's job name, e.g. "FindCollisions" or "SolveVelocityConstraints"
+	Name string
+
+	// Time is the CPU time of the phase's jobs, summed over all threads
+	Time time.Duration
+
+	// Jobs is the number of jobs of this phase that ran
+	Jobs int
+}
+
+// PhysicsStats describes the last update of a physics system
+type PhysicsStats struct {
+	// StepTime is the wall time of the last Update call (all of its collision steps)
+	StepTime time.Duration
+
+	// CollisionSteps is the number of collision steps of the last update
+	CollisionSteps int
+
+	// UpdateErrors holds the error flags of the last update
+	UpdateErrors PhysicsUpdateError
+
+	// NumBodies is the number of bodies in the system, including ones not added to the world
+	NumBodies int
+
+	// NumActiveBodies is the number of awake rigid bodies
+	NumActiveBodies int
+
+	// MaxBodies is the body capacity of the system
+	MaxBodies int
+
+	// ContactManifolds is the number of contact manifolds of the last update. Each one uses a contact
+	// constraint, so compare it with MaxContactConstraints. Only counted while stats are enabled.
+	ContactManifolds int
+
+	// MaxContactConstraints is the contact constraint capacity of the system
+	MaxContactConstraints int
+
+	// BodyPairsInContact is the number of distinct body pairs that touched in the last update. Jolt also
+	// caches pairs whose bounds overlap without touching, so this is a lower bound of the body pair use.
+	// Only counted while stats are enabled.
+	BodyPairsInContact int
+
+	// MaxBodyPairs is the body pair capacity of the system
+	MaxBodyPairs int
+
+	// Phases holds the timings of the update's job phases in the order they first ran.
+	// Empty while stats are disabled.
+	Phases []PhaseTiming
+}
+
+// ContactConstraintUsage returns the fraction [0, 1] of the contact constraint capacity used by the last update
+func (s *PhysicsStats) ContactConstraintUsage() float32 {
+	if s.MaxContactConstraints == 0 {
+		return 0
+	}
+	return float32(s.ContactManifolds) / float32(s.MaxContactConstraints)
+}
+
+// BodyPairUsage returns the fraction [0, 1] of the body pair capacity used by the last update (a lower bound,
+// see BodyPairsInContact)
+func (s *PhysicsStats) BodyPairUsage() float32 {
+	if s.MaxBodyPairs == 0 {
+		return 0
+	}
+	return float32(s.BodyPairsInContact) / float32(s.MaxBodyPairs)
+}
+
+// EnableStats turns per-phase timings and contact counts on or off. The wall time, error flags and body
+// counts of the last update are always available; the rest costs a little time on every update, so it is
+// off by default. Call it between updates.
+func (ps *PhysicsSystem) EnableStats(enabled bool) {
+	C.JoltPhysicsSystemSetStatsEnabled(ps.handle, C.int(boolToInt(enabled)))
+}
+
+// Stats returns the statistics of the last update (Update, UpdateWithCollisionSteps or the last step of
+// FixedTimestep.Advance). Call it between updates.
+//
+// Example usage:
+//
+//	ps.EnableStats(true)
+//	ps.Update(1.0 / 60.0)
+//	stats := ps.Stats()
+//	if stats.StepTime > 4*time.Millisecond || stats.ContactConstraintUsage() > 0.8 {
+//	    log.Printf("slow step: %v, %d/%d contacts", stats.StepTime, stats.ContactManifolds, stats.MaxContactConstraints)
+//	    for _, phase := range stats.Phases {
+//	        log.Printf("  %s: %v (%d jobs)", phase.Name, phase.Time, phase.Jobs)
+//	    }
+//	}
+func (ps *PhysicsSystem) Stats() PhysicsStats {
+	var cStats C.JoltPhysicsStats
+	C.JoltPhysicsSystemGetStats(ps.handle, &cStats)
+
+	stats := PhysicsStats{
+		StepTime:              time.Duration(float64(cStats.stepSeconds) * float64(time.Second)),
+		CollisionSteps:        int(cStats.collisionSteps),
+		UpdateErrors:          PhysicsUpdateError(cStats.updateErrors),
+		NumBodies:             int(cStats.numBodies),
+		NumActiveBodies:       int(cStats.numActiveBodies),
+		MaxBodies:             int(cStats.maxBodies),
+		ContactManifolds:      int(cStats.numContactManifolds),
+		MaxContactConstraints: int(cStats.maxContactConstraints),
+		BodyPairsInContact:    int(cStats.numBodyPairsInContact),
+		MaxBodyPairs:          int(cStats.maxBodyPairs),
+	}
+
+	if n := int(cStats.numPhases); n > 0 {
+		stats.Phases = make([]PhaseTiming, n)
+		for i := range stats.Phases {
+			phase := &cStats.phases[i]
+			stats.Phases[i] = PhaseTiming{
+				Name: C.GoString(phase.name),
+				Time: time.Duration(float64(phase.seconds) * float64(time.Second)),
+				Jobs: int(phase.numJobs),
+			}
+		}
+	}
+	return stats
+}
+
+// ProfileNextUpdate makes the next update of this system dump Jolt's profiler output to
+// profile_chart_<tag>.html and profile_list_<tag>.html in the working directory. The profiler is shared by
+// all worlds, so samples of other worlds updating at the same time end up in the same dump.
+//
+// Returns an error if the profiler isn't running: Jolt was not initialized with InitOptions.EnableProfiler,
+// or the native library was built without the profiler (JPH_PROFILE_ENABLED), as the jolt_perf variant is.
+//
+// Example usage:
+//
+//	opts := jolt.NewInitOptions()
+//	opts.EnableProfiler = true
+//	jolt.InitWithOptions(opts)
+//	...
+//	if stats := ps.Stats(); stats.StepTime > 10*time.Millisecond {
+//	    if err := ps.ProfileNextUpdate(fmt.Sprintf("tick%d", tick)); err != nil {
+//	        log.Println(err)
+//	    }
+//	}
+func (ps *PhysicsSystem) ProfileNextUpdate(tag string) error {
+	cTag := C.CString(tag)
+	defer C.free(unsafe.Pointer(cTag))
+	if C.JoltPhysicsSystemProfileNextUpdate(ps.handle, cTag) == 0 {
+		if PerfBuild {
+			return fmt.Errorf("the jolt_perf libraries are built without the profiler")
+		}
+		return fmt.Errorf("profiler is not running, initialize Jolt with InitOptions.EnableProfiler")
+	}
+	return nil
+}
@@ -0,0 +1,104 @@
+package jolt
+
+import (
+	"os"
+	"testing"
+)
+
+func TestPhysicsStats(t *testing.T) {
+	ps, _, _ := newEventTestWorld(t, 256, EventMaskDefault, EventOverflowDropNewest)
+
+	// Wall time and body counts are recorded without enabling stats
+	ps.Update(1.0 / 60.0)
+	stats := ps.Stats()
+	if stats.StepTime <= 0 || stats.CollisionSteps != 1 {
+		t.Errorf("step time %v, %d collision steps, expected a measured single step", stats.StepTime, stats.CollisionSteps)
+	}
+	if stats.NumBodies != 2 || stats.NumActiveBodies != 1 || stats.MaxBodies == 0 {
+		t.Errorf("bodies %d/%d active of max %d, expected 2 bodies with 1 active", stats.NumBodies, stats.NumActiveBodies, stats.MaxBodies)
+	}
+	if len(stats.Phases) != 0 || stats.ContactManifolds != 0 {
+		t.Errorf("phases and contacts should only be counted while stats are enabled, got %+v", stats)
+	}
+
+	ps.EnableStats(true)
+	events := make([]ContactEvent, 256)
+	var maxManifolds, maxPairs, numAdded int
+	for i := 0; i < 60; i++ {
+		ps.UpdateWithCollisionSteps(1.0/60.0, 2)
+		n, _ := ps.DrainEvents(events)
+		for _, ev := range events[:n] {
+			if ev.Type == ContactEventAdded {
+				numAdded++
+			}
+		}
+
+		stats = ps.Stats()
+		maxManifolds = max(maxManifolds, stats.ContactManifolds)
+		maxPairs = max(maxPairs, stats.BodyPairsInContact)
+	}
+
+	if stats.CollisionSteps != 2 {
+		t.Errorf("collision steps = %d, expected 2", stats.CollisionSteps)
+	}
+	if len(stats.Phases) == 0 {
+		t.Fatal("expected phase timings while stats are enabled")
+	}
+	for _, phase := range stats.Phases {
+		if phase.Name == "" || phase.Jobs <= 0 || phase.Time < 0 {
+			t.Errorf("invalid phase timing %+v", phase)
+		}
+	}
+	if maxManifolds == 0 || maxPairs != 1 {
+		t.Errorf("max %d manifolds and %d body pairs, expected the ball to touch the floor", maxManifolds, maxPairs)
+	}
+	if stats.MaxContactConstraints == 0 || stats.MaxBodyPairs == 0 || stats.BodyPairUsage() > 1 {
+		t.Errorf("invalid capacities in %+v", stats)
+	}
+
+	// The stats listener sits in front of the event recorder and must not swallow its events
+	if numAdded == 0 {
+		t.Error("expected contact added events while stats are enabled")
+	}
+
+	ps.EnableStats(false)
+	ps.Update(1.0 / 60.0)
+	if stats = ps.Stats(); len(stats.Phases) != 0 {
+		t.Errorf("got %d phases after disabling stats", len(stats.Phases))
+	}
+}
+
+func TestProfileNextUpdate(t *testing.T) {
+	ps := NewPhysicsSystem()
+	err := ps.ProfileNextUpdate("off")
+	ps.Destroy()
+	if err == nil {
+		t.Error("profiling should fail while the profiler isn't running")
+	}
+	if PerfBuild {
+		return
+	}
+
+	opts := NewInitOptions()
+	opts.EnableProfiler = true
+	reinit(t, opts)
+
+	dir, err := os.Getwd()
+	if err != nil {
+		t.Fatal(err)
+	}
+	if err := os.Chdir(t.TempDir()); err != nil {
+		t.Fatal(err)
+	}
+	defer os.Chdir(dir)
+
+	ps = newQueryTestWorld(t)
+	if err := ps.ProfileNextUpdate("test"); err != nil {
+		t.Fatal(err)
+	}
+	ps.Update(1.0 / 60.0)
+	ps.Update(1.0 / 60.0)
+	if _, err := os.Stat("profile_list_test.html"); err != nil {
+		t.Errorf("expected a profile dump: %v", err)
+	}
+}
@@ -42,6 +42,34 @@ func (v Vec3) Normalize() Vec3 {
 	return Vec3{X: v.X / length, Y: v.Y / length, Z: v.Z / length}
 }
 
+// RVec3 converts this vector to a double-precision position
+func (v Vec3) RVec3() RVec3 {
+	return RVec3{X: float64(v.X), Y: float64(v.Y), Z: float64(v.Z)}
+}
+
+// RVec3 represents a position in world space with double precision.
+// The *64 methods take and return positions as RVec3. With the jolt_double build tag the native library stores
+// positions as doubles, so worlds can span far more than the few kilometers float32 positions are accurate for;
+// other builds round them to float32 inside the library.
+type RVec3 struct {
+	X, Y, Z float64
+}
+
+// Add returns this position moved by an offset
+func (v RVec3) Add(offset Vec3) RVec3 {
+	return RVec3{X: v.X + float64(offset.X), Y: v.Y + float64(offset.Y), Z: v.Z + float64(offset.Z)}
+}
+
+// Sub returns the offset from another position to this one
+func (v RVec3) Sub(other RVec3) Vec3 {
+	return Vec3{X: float32(v.X - other.X), Y: float32(v.Y - other.Y), Z: float32(v.Z - other.Z)}
+}
+
+// Vec3 returns this position rounded to single precision
+func (v RVec3) Vec3() Vec3 {
+	return Vec3{X: float32(v.X), Y: float32(v.Y), Z: float32(v.Z)}
+}
+
 // Quat represents a quaternion for rotations
 type Quat struct {
 	X, Y, Z, W float32
@@ -9,16 +9,15 @@
 #include <Jolt/Physics/Body/Body.h>
 #include <Jolt/Physics/Body/BodyCreationSettings.h>
 #include <Jolt/Physics/Body/BodyInterface.h>
-#include <memory>
+#include <Jolt/Physics/Body/BodyLock.h>
+#include <Jolt/Physics/Body/BodyLockMulti.h>
+#include <algorithm>
+#include <vector>
 
 using namespace JPH;
 
-// Collision layers (defined in physics.cpp)
-namespace Layers
-{
-	static constexpr ObjectLayer NON_MOVING = 0;
-	static constexpr ObjectLayer MOVING = 1;
-};
+// JoltBodyID arrays are reinterpreted as BodyID arrays for the bulk functions
+static_assert(sizeof(BodyID) == sizeof(JoltBodyID), "BodyID must be a plain 32-bit value");
 
 JoltBodyInterface JoltPhysicsSystemGetBodyInterface(JoltPhysicsSystem system)
 {
@@ -30,63 +29,325 @@ JoltBodyInterface JoltPhysicsSystemGetBodyInterface(JoltPhysicsSystem system)
 }
 
 void JoltGetBodyPosition(const JoltBodyInterface bodyInterface,
-						 const JoltBodyID bodyID,
-						 float *x, float *y, float *z)
+						 JoltBodyID bodyID,
+						 double *x, double *y, double *z)
 {
 	const BodyInterface *bi = static_cast<const BodyInterface *>(bodyInterface);
-	const BodyID *bid = static_cast<const BodyID *>(bodyID);
+	BodyID bid(bodyID);
 
-	RVec3 pos = bi->GetPosition(*bid);
-	*x = static_cast<float>(pos.GetX());
-	*y = static_cast<float>(pos.GetY());
-	*z = static_cast<float>(pos.GetZ());
+	RVec3 pos = bi->GetPosition(bid);
+	*x = pos.GetX();
+	*y = pos.GetY();
+	*z = pos.GetZ();
 }
 
 void JoltSetBodyPosition(JoltBodyInterface bodyInterface,
 						 JoltBodyID bodyID,
-						 float x, float y, float z)
+						 double x, double y, double z)
 {
 	BodyInterface *bi = static_cast<BodyInterface *>(bodyInterface);
-	const BodyID *bid = static_cast<const BodyID *>(bodyID);
+	BodyID bid(bodyID);
 
-	bi->SetPosition(*bid, RVec3(x, y, z), EActivation::DontActivate);
+	bi->SetPosition(bid, RVec3(Real(x), Real(y), Real(z)), EActivation::DontActivate);
 }
 
-JoltBodyID JoltCreateBody(JoltBodyInterface bodyInterface,
-						  JoltShape shape,
-						  float x, float y, float z,
-						  JoltMotionType motionType,
-						  int isSensor)
+static EActivation ToActivation(int activate)
+{
+	return activate != 0 ? EActivation::Activate : EActivation::DontActivate;
+}
+
+Quat ToRotation(float x, float y, float z, float w)
+{
+	Quat q(x, y, z, w);
+	return q.LengthSq() > 0.0f ? q.Normalized() : Quat::sIdentity();
+}
+
+static Quat ToRotation(const float* q)
+{
+	return ToRotation(q[0], q[1], q[2], q[3]);
+}
+
+// Positions arrive as float or double triples (RVec3 is double precision in JPH_DOUBLE_PRECISION builds)
+template <class T>
+static RVec3 ToPosition(const T* v)
+{
+	return RVec3(Real(v[0]), Real(v[1]), Real(v[2]));
+}
+
+static Vec3 ToVec3(const float* v)
+{
+	return Vec3(v[0], v[1], v[2]);
+}
+
+static void StoreVec3(Vec3Arg v, float* x, float* y, float* z)
+{
+	*x = v.GetX();
+	*y = v.GetY();
+	*z = v.GetZ();
+}
+
+void JoltGetBodyRotation(const JoltBodyInterface bodyInterface,
+						 JoltBodyID bodyID,
+						 float* x, float* y, float* z, float* w)
+{
+	const BodyInterface *bi = static_cast<const BodyInterface *>(bodyInterface);
+
+	Quat rot = bi->GetRotation(BodyID(bodyID));
+	*x = rot.GetX();
+	*y = rot.GetY();
+	*z = rot.GetZ();
+	*w = rot.GetW();
+}
+
+void JoltSetBodyRotation(JoltBodyInterface bodyInterface,
+						 JoltBodyID bodyID,
+						 float x, float y, float z, float w,
+						 int activate)
 {
 	BodyInterface *bi = static_cast<BodyInterface *>(bodyInterface);
-	const Shape *s = static_cast<const Shape *>(shape);
 
-	// Convert motion type
+	bi->SetRotation(BodyID(bodyID), ToRotation(x, y, z, w), ToActivation(activate));
+}
+
+void JoltSetBodyPositionAndRotation(JoltBodyInterface bodyInterface,
+									JoltBodyID bodyID,
+									double posX, double posY, double posZ,
+									float rotX, float rotY, float rotZ, float rotW,
+									int activate)
+{
+	BodyInterface *bi = static_cast<BodyInterface *>(bodyInterface);
+
+	bi->SetPositionAndRotation(BodyID(bodyID), RVec3(Real(posX), Real(posY), Real(posZ)), ToRotation(rotX, rotY, rotZ, rotW), ToActivation(activate));
+}
+
+void JoltSetBodyPositionAndRotationWhenChanged(JoltBodyInterface bodyInterface,
+											   JoltBodyID bodyID,
+											   double posX, double posY, double posZ,
+											   float rotX, float rotY, float rotZ, float rotW,
+											   int activate)
+{
+	BodyInterface *bi = static_cast<BodyInterface *>(bodyInterface);
+
+	bi->SetPositionAndRotationWhenChanged(BodyID(bodyID), RVec3(Real(posX), Real(posY), Real(posZ)), ToRotation(rotX, rotY, rotZ, rotW), ToActivation(activate));
+}
+
+void JoltMoveKinematic(JoltBodyInterface bodyInterface,
+					   JoltBodyID bodyID,
+					   double posX, double posY, double posZ,
+					   float rotX, float rotY, float rotZ, float rotW,
+					   float deltaTime)
+{
+	BodyInterface *bi = static_cast<BodyInterface *>(bodyInterface);
+
+	bi->MoveKinematic(BodyID(bodyID), RVec3(Real(posX), Real(posY), Real(posZ)), ToRotation(rotX, rotY, rotZ, rotW), deltaTime);
+}
+
+void JoltGetBodyLinearVelocity(const JoltBodyInterface bodyInterface, JoltBodyID bodyID,
+							   float* x, float* y, float* z)
+{
+	const BodyInterface *bi = static_cast<const BodyInterface *>(bodyInterface);
+	StoreVec3(bi->GetLinearVelocity(BodyID(bodyID)), x, y, z);
+}
+
+void JoltSetBodyLinearVelocity(JoltBodyInterface bodyInterface, JoltBodyID bodyID,
+							   float x, float y, float z)
+{
+	BodyInterface *bi = static_cast<BodyInterface *>(bodyInterface);
+	bi->SetLinearVelocity(BodyID(bodyID), Vec3(x, y, z));
+}
+
+void JoltGetBodyAngularVelocity(const JoltBodyInterface bodyInterface, JoltBodyID bodyID,
+								float* x, float* y, float* z)
+{
+	const BodyInterface *bi = static_cast<const BodyInterface *>(bodyInterface);
+	StoreVec3(bi->GetAngularVelocity(BodyID(bodyID)), x, y, z);
+}
+
+void JoltSetBodyAngularVelocity(JoltBodyInterface bodyInterface, JoltBodyID bodyID,
+								float x, float y, float z)
+{
+	BodyInterface *bi = static_cast<BodyInterface *>(bodyInterface);
+	bi->SetAngularVelocity(BodyID(bodyID), Vec3(x, y, z));
+}
+
+void JoltAddBodyForce(JoltBodyInterface bodyInterface, JoltBodyID bodyID,
+					  float x, float y, float z)
+{
+	BodyInterface *bi = static_cast<BodyInterface *>(bodyInterface);
+	bi->AddForce(BodyID(bodyID), Vec3(x, y, z));
+}
+
+void JoltAddBodyImpulse(JoltBodyInterface bodyInterface, JoltBodyID bodyID,
+						float x, float y, float z)
+{
+	BodyInterface *bi = static_cast<BodyInterface *>(bodyInterface);
+	bi->AddImpulse(BodyID(bodyID), Vec3(x, y, z));
+}
+
+// The batched setters go through the locking BodyInterface per body: it keeps the broadphase and the
+// active body list up to date exactly like the single-body calls, while the whole batch is one cgo call
+
+template <class T>
+static void SetBodyTransforms(BodyInterface* bi, const JoltBodyID* ids, int count,
+							  const T* positions, const float* rotations,
+							  EActivation activation, int onlyWhenChanged)
+{
+	for (int i = 0; i < count; i++)
+	{
+		BodyID id(ids[i]);
+		RVec3 position = ToPosition(positions + i * 3);
+
+		if (rotations == nullptr)
+		{
+			bi->SetPosition(id, position, activation);
+		}
+		else if (onlyWhenChanged != 0)
+		{
+			bi->SetPositionAndRotationWhenChanged(id, position, ToRotation(rotations + i * 4), activation);
+		}
+		else
+		{
+			bi->SetPositionAndRotation(id, position, ToRotation(rotations + i * 4), activation);
+		}
+	}
+}
+
+template <class T>
+static void MoveKinematicBodies(BodyInterface* bi, const JoltBodyID* ids, int count,
+								const T* positions, const float* rotations, float deltaTime)
+{
+	for (int i = 0; i < count; i++)
+	{
+		bi->MoveKinematic(BodyID(ids[i]), ToPosition(positions + i * 3), ToRotation(rotations + i * 4), deltaTime);
+	}
+}
+
+void JoltSetBodyTransforms(JoltBodyInterface bodyInterface,
+						   const JoltBodyID* ids, int count,
+						   const float* positions, const float* rotations,
+						   int activate, int onlyWhenChanged)
+{
+	SetBodyTransforms(static_cast<BodyInterface *>(bodyInterface), ids, count, positions, rotations,
+					  ToActivation(activate), onlyWhenChanged);
+}
+
+void JoltSetBodyTransforms64(JoltBodyInterface bodyInterface,
+							 const JoltBodyID* ids, int count,
+							 const double* positions, const float* rotations,
+							 int activate, int onlyWhenChanged)
+{
+	SetBodyTransforms(static_cast<BodyInterface *>(bodyInterface), ids, count, positions, rotations,
+					  ToActivation(activate), onlyWhenChanged);
+}
+
+void JoltMoveKinematicBodies(JoltBodyInterface bodyInterface,
+							 const JoltBodyID* ids, int count,
+							 const float* positions, const float* rotations,
+							 float deltaTime)
+{
+	MoveKinematicBodies(static_cast<BodyInterface *>(bodyInterface), ids, count, positions, rotations, deltaTime);
+}
+
+void JoltMoveKinematicBodies64(JoltBodyInterface bodyInterface,
+							   const JoltBodyID* ids, int count,
+							   const double* positions, const float* rotations,
+							   float deltaTime)
+{
+	MoveKinematicBodies(static_cast<BodyInterface *>(bodyInterface), ids, count, positions, rotations, deltaTime);
+}
+
+void JoltSetBodyVelocities(JoltBodyInterface bodyInterface,
+						   const JoltBodyID* ids, int count,
+						   const float* linearVelocities, const float* angularVelocities)
+{
+	BodyInterface *bi = static_cast<BodyInterface *>(bodyInterface);
+
+	for (int i = 0; i < count; i++)
+	{
+		BodyID id(ids[i]);
+		if (linearVelocities != nullptr && angularVelocities != nullptr)
+		{
+			// One lock for both velocities
+			bi->SetLinearAndAngularVelocity(id, ToVec3(linearVelocities + i * 3), ToVec3(angularVelocities + i * 3));
+		}
+		else if (linearVelocities != nullptr)
+		{
+			bi->SetLinearVelocity(id, ToVec3(linearVelocities + i * 3));
+		}
+		else if (angularVelocities != nullptr)
+		{
+			bi->SetAngularVelocity(id, ToVec3(angularVelocities + i * 3));
+		}
+	}
+}
+
+void JoltAddBodyForces(JoltBodyInterface bodyInterface, const JoltBodyID* ids, int count, const float* forces)
+{
+	BodyInterface *bi = static_cast<BodyInterface *>(bodyInterface);
+
+	for (int i = 0; i < count; i++)
+	{
+		bi->AddForce(BodyID(ids[i]), ToVec3(forces + i * 3));
+	}
+}
+
+void JoltAddBodyImpulses(JoltBodyInterface bodyInterface, const JoltBodyID* ids, int count, const float* impulses)
+{
+	BodyInterface *bi = static_cast<BodyInterface *>(bodyInterface);
+
+	for (int i = 0; i < count; i++)
+	{
+		bi->AddImpulse(BodyID(ids[i]), ToVec3(impulses + i * 3));
+	}
+}
+
+// Convert a wrapper motion type to Jolt's motion type, and resolve the object layer
+// (JOLT_OBJECT_LAYER_FROM_MOTION_TYPE picks the default layer for bodies of that type)
+static EMotionType ToMotionTypeAndLayer(JoltMotionType motionType, int objectLayer, ObjectLayer& outLayer)
+{
 	EMotionType joltMotionType;
-	ObjectLayer layer;
 	switch (motionType)
 	{
-	case JoltMotionTypeStatic:
-		joltMotionType = EMotionType::Static;
-		layer = Layers::NON_MOVING;
-		break;
 	case JoltMotionTypeKinematic:
 		joltMotionType = EMotionType::Kinematic;
-		layer = Layers::MOVING;
 		break;
 	case JoltMotionTypeDynamic:
 		joltMotionType = EMotionType::Dynamic;
-		layer = Layers::MOVING;
 		break;
+	case JoltMotionTypeStatic:
 	default:
 		joltMotionType = EMotionType::Static;
-		layer = Layers::NON_MOVING;
 		break;
 	}
 
+	if (objectLayer == JOLT_OBJECT_LAYER_FROM_MOTION_TYPE)
+	{
+		outLayer = joltMotionType == EMotionType::Static ? JOLT_OBJECT_LAYER_NON_MOVING : JOLT_OBJECT_LAYER_MOVING;
+	}
+	else
+	{
+		outLayer = static_cast<ObjectLayer>(objectLayer);
+	}
+	return joltMotionType;
+}
+
+JoltBodyID JoltCreateBody(JoltBodyInterface bodyInterface,
+						  JoltShape shape,
+						  double x, double y, double z,
+						  JoltMotionType motionType,
+						  int isSensor,
+						  int objectLayer)
+{
+	BodyInterface *bi = static_cast<BodyInterface *>(bodyInterface);
+	const Shape *s = static_cast<const Shape *>(shape);
+
+	// Convert motion type
+	ObjectLayer layer;
+	EMotionType joltMotionType = ToMotionTypeAndLayer(motionType, objectLayer, layer);
+
 	BodyCreationSettings body_settings(
 		s,
-		RVec3(x, y, z),
+		RVec3(Real(x), Real(y), Real(z)),
 		Quat::sIdentity(),
 		joltMotionType,
 		layer);
@@ -97,31 +358,124 @@ JoltBodyID JoltCreateBody(JoltBodyInterface bodyInterface,
 	Body *body = bi->CreateBody(body_settings);
 	if (!body)
 	{
-		return nullptr;
+		return JOLT_INVALID_BODY_ID;
 	}
 
 	// Don't activate yet - caller will activate when ready
 	bi->AddBody(body->GetID(), EActivation::DontActivate);
 
-	// Use smart pointer for exception safety, then release to caller
-	auto bodyIDPtr = std::make_unique<BodyID>(body->GetID());
-	return static_cast<JoltBodyID>(bodyIDPtr.release());
+	return body->GetID().GetIndexAndSequenceNumber();
+}
+
+void AddBodiesBatch(BodyInterface* bi, std::vector<BodyID>& ids, EActivation activation)
+{
+	if (ids.empty())
+	{
+		return;
+	}
+
+	int count = static_cast<int>(ids.size());
+	BodyInterface::AddState state = bi->AddBodiesPrepare(ids.data(), count);
+	bi->AddBodiesFinalize(ids.data(), count, state, activation);
+}
+
+BodyCreationSettings ToBodyCreationSettings(const JoltBodyCreationSettings& in)
+{
+	ObjectLayer layer;
+	EMotionType joltMotionType = ToMotionTypeAndLayer(in.motionType, in.objectLayer, layer);
+
+	BodyCreationSettings body_settings(
+		static_cast<const Shape *>(in.shape),
+		RVec3(Real(in.positionX), Real(in.positionY), Real(in.positionZ)),
+		ToRotation(in.rotationX, in.rotationY, in.rotationZ, in.rotationW),
+		joltMotionType,
+		layer);
+	body_settings.mIsSensor = (in.isSensor != 0);
+	return body_settings;
+}
+
+void CreateBodiesSplit(BodyInterface* bi, const JoltBodyCreationSettings* settings, int count, JoltBodyID* outIDs,
+					   std::vector<BodyID>& outStaticIDs, std::vector<BodyID>& outMovingIDs)
+{
+	for (int i = 0; i < count; i++)
+	{
+		Body *body = bi->CreateBody(ToBodyCreationSettings(settings[i]));
+		if (!body)
+		{
+			outIDs[i] = JOLT_INVALID_BODY_ID;
+			continue;
+		}
+
+		outIDs[i] = body->GetID().GetIndexAndSequenceNumber();
+		(body->IsStatic() ? outStaticIDs : outMovingIDs).push_back(body->GetID());
+	}
+}
+
+int JoltCreateBodies(JoltBodyInterface bodyInterface,
+					 const JoltBodyCreationSettings* settings, int count,
+					 JoltBodyID* outIDs,
+					 int activate)
+{
+	BodyInterface *bi = static_cast<BodyInterface *>(bodyInterface);
+
+	// Static and moving bodies are added as separate batches so only the moving ones get activated
+	// (scratch buffers keep their capacity between calls on this thread)
+	static thread_local std::vector<BodyID> staticIDs;
+	static thread_local std::vector<BodyID> movingIDs;
+	staticIDs.clear();
+	movingIDs.clear();
+
+	CreateBodiesSplit(bi, settings, count, outIDs, staticIDs, movingIDs);
+
+	AddBodiesBatch(bi, staticIDs, EActivation::DontActivate);
+	AddBodiesBatch(bi, movingIDs, activate != 0 ? EActivation::Activate : EActivation::DontActivate);
+
+	return static_cast<int>(staticIDs.size() + movingIDs.size());
+}
+
+void JoltRemoveBodies(JoltBodyInterface bodyInterface, const JoltBodyID* ids, int count)
+{
+	BodyInterface *bi = static_cast<BodyInterface *>(bodyInterface);
+
+	if (count <= 0)
+	{
+		return;
+	}
+
+	// RemoveBodies reorders its input, so work on a copy rather than the caller's array
+	static thread_local std::vector<BodyID> scratch;
+	const BodyID *bids = reinterpret_cast<const BodyID *>(ids);
+	scratch.assign(bids, bids + count);
+
+	bi->RemoveBodies(scratch.data(), count);
+}
+
+void JoltDestroyBodies(JoltBodyInterface bodyInterface, const JoltBodyID* ids, int count)
+{
+	BodyInterface *bi = static_cast<BodyInterface *>(bodyInterface);
+
+	if (count <= 0)
+	{
+		return;
+	}
+
+	bi->DestroyBodies(reinterpret_cast<const BodyID *>(ids), count);
 }
 
 void JoltActivateBody(JoltBodyInterface bodyInterface, JoltBodyID bodyID)
 {
 	BodyInterface *bi = static_cast<BodyInterface *>(bodyInterface);
-	const BodyID *bid = static_cast<const BodyID *>(bodyID);
+	BodyID bid(bodyID);
 
-	bi->ActivateBody(*bid);
+	bi->ActivateBody(bid);
 }
 
 void JoltDeactivateBody(JoltBodyInterface bodyInterface, JoltBodyID bodyID)
 {
 	BodyInterface *bi = static_cast<BodyInterface *>(bodyInterface);
-	const BodyID *bid = static_cast<const BodyID *>(bodyID);
+	BodyID bid(bodyID);
 
-	bi->DeactivateBody(*bid);
+	bi->DeactivateBody(bid);
 }
 
 void JoltSetBodyShape(JoltBodyInterface bodyInterface,
@@ -130,14 +484,137 @@ void JoltSetBodyShape(JoltBodyInterface bodyInterface,
 					 int updateMassProperties)
 {
 	BodyInterface *bi = static_cast<BodyInterface *>(bodyInterface);
-	const BodyID *bid = static_cast<const BodyID *>(bodyID);
+	BodyID bid(bodyID);
 	const Shape *s = static_cast<const Shape *>(shape);
 
-	bi->SetShape(*bid, s, updateMassProperties != 0, EActivation::Activate);
+	bi->SetShape(bid, s, updateMassProperties != 0, EActivation::Activate);
 }
 
-void JoltDestroyBodyID(JoltBodyID bodyID)
+// Write the state of one body (or a default state for a missing body) to slot i of the output arrays
+static void StoreBodyState(const Body* body, int i,
+						   float* outPositions, float* outRotations,
+						   float* outLinearVelocities, float* outAngularVelocities)
 {
-	BodyID *bid = static_cast<BodyID *>(bodyID);
-	delete bid;
+	RVec3 pos = body ? body->GetPosition() : RVec3::sZero();
+	Quat rot = body ? body->GetRotation() : Quat::sIdentity();
+	Vec3 linVel = body ? body->GetLinearVelocity() : Vec3::sZero();
+	Vec3 angVel = body ? body->GetAngularVelocity() : Vec3::sZero();
+
+	if (outPositions)
+	{
+		outPositions[i * 3] = static_cast<float>(pos.GetX());
+		outPositions[i * 3 + 1] = static_cast<float>(pos.GetY());
+		outPositions[i * 3 + 2] = static_cast<float>(pos.GetZ());
+	}
+	if (outRotations)
+	{
+		outRotations[i * 4] = rot.GetX();
+		outRotations[i * 4 + 1] = rot.GetY();
+		outRotations[i * 4 + 2] = rot.GetZ();
+		outRotations[i * 4 + 3] = rot.GetW();
+	}
+	if (outLinearVelocities)
+	{
+		outLinearVelocities[i * 3] = linVel.GetX();
+		outLinearVelocities[i * 3 + 1] = linVel.GetY();
+		outLinearVelocities[i * 3 + 2] = linVel.GetZ();
+	}
+	if (outAngularVelocities)
+	{
+		outAngularVelocities[i * 3] = angVel.GetX();
+		outAngularVelocities[i * 3 + 1] = angVel.GetY();
+		outAngularVelocities[i * 3 + 2] = angVel.GetZ();
+	}
+}
+
+// Read bodies under a single multi-body read lock (each body mutex is taken once, not once per body)
+static int ReadBodyStatesLocked(PhysicsSystem* ps, const BodyID* ids, int count,
+								float* outPositions, float* outRotations,
+								float* outLinearVelocities, float* outAngularVelocities)
+{
+	BodyLockMultiRead lock(ps->GetBodyLockInterface(), ids, count);
+
+	int numFound = 0;
+	for (int i = 0; i < count; i++)
+	{
+		const Body* body = lock.GetBody(i);
+		if (body)
+		{
+			numFound++;
+		}
+		StoreBodyState(body, i, outPositions, outRotations, outLinearVelocities, outAngularVelocities);
+	}
+	return numFound;
+}
+
+int JoltReadBodyPositions64(JoltPhysicsSystem system, const JoltBodyID* ids, int count, double* outPositions)
+{
+	PhysicsSystem* ps = GetPhysicsSystem(static_cast<PhysicsSystemWrapper*>(system));
+
+	if (count <= 0)
+	{
+		return 0;
+	}
+
+	BodyLockMultiRead lock(ps->GetBodyLockInterface(), reinterpret_cast<const BodyID*>(ids), count);
+
+	int numFound = 0;
+	for (int i = 0; i < count; i++)
+	{
+		const Body* body = lock.GetBody(i);
+		RVec3 pos = RVec3::sZero();
+		if (body)
+		{
+			pos = body->GetPosition();
+			numFound++;
+		}
+		outPositions[i * 3] = pos.GetX();
+		outPositions[i * 3 + 1] = pos.GetY();
+		outPositions[i * 3 + 2] = pos.GetZ();
+	}
+	return numFound;
+}
+
+int JoltReadBodyStates(JoltPhysicsSystem system,
+					   const JoltBodyID* ids, int count,
+					   float* outPositions, float* outRotations,
+					   float* outLinearVelocities, float* outAngularVelocities)
+{
+	PhysicsSystemWrapper* wrapper = static_cast<PhysicsSystemWrapper*>(system);
+	PhysicsSystem* ps = GetPhysicsSystem(wrapper);
+
+	if (count <= 0)
+	{
+		return 0;
+	}
+
+	return ReadBodyStatesLocked(ps, reinterpret_cast<const BodyID*>(ids), count,
+								outPositions, outRotations, outLinearVelocities, outAngularVelocities);
+}
+
+int JoltReadActiveBodyStates(JoltPhysicsSystem system,
+							 JoltBodyID* outIDs, int maxBodies,
+							 float* outPositions, float* outRotations,
+							 float* outLinearVelocities, float* outAngularVelocities)
+{
+	PhysicsSystemWrapper* wrapper = static_cast<PhysicsSystemWrapper*>(system);
+	PhysicsSystem* ps = GetPhysicsSystem(wrapper);
+
+	// The active body list is only stable between updates, which is when the caller is allowed to use this
+	int numActive = static_cast<int>(ps->GetNumActiveBodies(EBodyType::RigidBody));
+	const BodyID* activeIDs = ps->GetActiveBodiesUnsafe(EBodyType::RigidBody);
+
+	int count = std::min(numActive, maxBodies);
+	if (count <= 0)
+	{
+		return numActive;
+	}
+
+	// Copy the IDs out first, the state arrays are indexed the same way
+	BodyID* ids = reinterpret_cast<BodyID*>(outIDs);
+	std::copy(activeIDs, activeIDs + count, ids);
+
+	ReadBodyStatesLocked(ps, ids, count, outPositions, outRotations, outLinearVelocities, outAngularVelocities);
+
+	return numActive;
 }
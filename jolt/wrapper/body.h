@@ -15,9 +15,12 @@ extern "C" {
 
 // Opaque pointer types
 typedef void* JoltBodyInterface;
-typedef void* JoltBodyID;
 typedef void* JoltShape;
 
+// Body IDs are passed by value as Jolt's packed index/sequence number (BodyID::GetIndexAndSequenceNumber)
+typedef unsigned int JoltBodyID;
+#define JOLT_INVALID_BODY_ID 0xffffffffu
+
 // Motion type enum (matches Jolt's EMotionType)
 typedef enum {
     JoltMotionTypeStatic = 0,    // Immovable, zero velocity
@@ -25,25 +28,151 @@ typedef enum {
     JoltMotionTypeDynamic = 2    // Affected by forces
 } JoltMotionType;
 
+// Object layer argument that picks the layer from the motion type: JOLT_OBJECT_LAYER_NON_MOVING for static
+// bodies, JOLT_OBJECT_LAYER_MOVING otherwise (see physics.h)
+#define JOLT_OBJECT_LAYER_FROM_MOTION_TYPE (-1)
+
+// Per-body settings for bulk creation (see JoltCreateBodies)
+typedef struct {
+    JoltShape shape;
+    double positionX, positionY, positionZ;
+    float rotationX, rotationY, rotationZ, rotationW;  // A zero quaternion is treated as identity, others are normalized
+    JoltMotionType motionType;
+    int isSensor;                // bool as int (0 or 1)
+    int objectLayer;             // Object layer of the body, or JOLT_OBJECT_LAYER_FROM_MOTION_TYPE
+} JoltBodyCreationSettings;
+
 // Get the body interface for creating/manipulating bodies
 JoltBodyInterface JoltPhysicsSystemGetBodyInterface(JoltPhysicsSystem system);
 
 // Get the position of a body
+// The single-body position functions take and return double in every build; they keep full precision with
+// JPH_DOUBLE_PRECISION. The batched functions using float arrays (JoltReadBodyStates, JoltSetBodyTransforms, ...)
+// round positions to float; use their 64 variants where there is one.
 void JoltGetBodyPosition(const JoltBodyInterface bodyInterface,
-                        const JoltBodyID bodyID,
-                        float* x, float* y, float* z);
+                        JoltBodyID bodyID,
+                        double* x, double* y, double* z);
 
 // Set the position of a body
 void JoltSetBodyPosition(JoltBodyInterface bodyInterface,
                         JoltBodyID bodyID,
+                        double x, double y, double z);
+
+// Get the rotation of a body as a quaternion
+void JoltGetBodyRotation(const JoltBodyInterface bodyInterface,
+                         JoltBodyID bodyID,
+                         float* x, float* y, float* z, float* w);
+
+// Set the rotation of a body (a zero quaternion is treated as identity, others are normalized)
+// activate: if non-zero, the body is woken up
+void JoltSetBodyRotation(JoltBodyInterface bodyInterface,
+                         JoltBodyID bodyID,
+                         float x, float y, float z, float w,
+                         int activate);
+
+// Teleport a body to a new position and rotation
+// activate: if non-zero, the body is woken up
+void JoltSetBodyPositionAndRotation(JoltBodyInterface bodyInterface,
+                                    JoltBodyID bodyID,
+                                    double posX, double posY, double posZ,
+                                    float rotX, float rotY, float rotZ, float rotW,
+                                    int activate);
+
+// Like JoltSetBodyPositionAndRotation, but does nothing (and doesn't wake the body) if the transform didn't change
+void JoltSetBodyPositionAndRotationWhenChanged(JoltBodyInterface bodyInterface,
+                                               JoltBodyID bodyID,
+                                               double posX, double posY, double posZ,
+                                               float rotX, float rotY, float rotZ, float rotW,
+                                               int activate);
+
+// Move a kinematic body so it reaches the target transform after deltaTime seconds
+// The velocities are set accordingly, so contacts with dynamic bodies respond properly (unlike teleporting)
+void JoltMoveKinematic(JoltBodyInterface bodyInterface,
+                       JoltBodyID bodyID,
+                       double posX, double posY, double posZ,
+                       float rotX, float rotY, float rotZ, float rotW,
+                       float deltaTime);
+
+// Get/set the velocity of a body (setting a non-zero velocity wakes the body, static bodies are ignored)
+void JoltGetBodyLinearVelocity(const JoltBodyInterface bodyInterface, JoltBodyID bodyID,
+                               float* x, float* y, float* z);
+void JoltSetBodyLinearVelocity(JoltBodyInterface bodyInterface, JoltBodyID bodyID,
+                               float x, float y, float z);
+void JoltGetBodyAngularVelocity(const JoltBodyInterface bodyInterface, JoltBodyID bodyID,
+                                float* x, float* y, float* z);
+void JoltSetBodyAngularVelocity(JoltBodyInterface bodyInterface, JoltBodyID bodyID,
+                                float x, float y, float z);
+
+// Add a force (applied during the next update) or an impulse (applied immediately) at the center of mass
+// Both wake the body and only affect dynamic bodies
+void JoltAddBodyForce(JoltBodyInterface bodyInterface, JoltBodyID bodyID,
+                      float x, float y, float z);
+void JoltAddBodyImpulse(JoltBodyInterface bodyInterface, JoltBodyID bodyID,
                         float x, float y, float z);
 
-// Create a body with specific motion type and sensor flag
+// Batched forms of the functions above: entry i of each array belongs to ids[i]
+// Vectors are count packed (x, y, z) triples and rotations count packed (x, y, z, w) quaternions, as in
+// JoltReadBodyStates. Bodies that no longer exist are skipped.
+
+// Set the transform of many bodies
+// rotations: may be NULL to only set the positions
+// onlyWhenChanged: if non-zero, bodies whose transform didn't change are left alone (see JoltSetBodyPositionAndRotationWhenChanged)
+void JoltSetBodyTransforms(JoltBodyInterface bodyInterface,
+                           const JoltBodyID* ids, int count,
+                           const float* positions, const float* rotations,
+                           int activate, int onlyWhenChanged);
+
+// Move many kinematic bodies towards their targets (see JoltMoveKinematic)
+void JoltMoveKinematicBodies(JoltBodyInterface bodyInterface,
+                             const JoltBodyID* ids, int count,
+                             const float* positions, const float* rotations,
+                             float deltaTime);
+
+// JoltSetBodyTransforms and JoltMoveKinematicBodies with count packed (x, y, z) double positions
+void JoltSetBodyTransforms64(JoltBodyInterface bodyInterface,
+                             const JoltBodyID* ids, int count,
+                             const double* positions, const float* rotations,
+                             int activate, int onlyWhenChanged);
+void JoltMoveKinematicBodies64(JoltBodyInterface bodyInterface,
+                               const JoltBodyID* ids, int count,
+                               const double* positions, const float* rotations,
+                               float deltaTime);
+
+// Set the velocities of many bodies (either array may be NULL to leave that velocity unchanged)
+void JoltSetBodyVelocities(JoltBodyInterface bodyInterface,
+                           const JoltBodyID* ids, int count,
+                           const float* linearVelocities, const float* angularVelocities);
+
+// Add a force or an impulse to many bodies
+void JoltAddBodyForces(JoltBodyInterface bodyInterface, const JoltBodyID* ids, int count, const float* forces);
+void JoltAddBodyImpulses(JoltBodyInterface bodyInterface, const JoltBodyID* ids, int count, const float* impulses);
+
+// Create a body with specific motion type, sensor flag and object layer
+// objectLayer: object layer of the body, or JOLT_OBJECT_LAYER_FROM_MOTION_TYPE
+// Returns JOLT_INVALID_BODY_ID if the body could not be created
 JoltBodyID JoltCreateBody(JoltBodyInterface bodyInterface,
                           JoltShape shape,
-                          float x, float y, float z,
+                          double x, double y, double z,
                           JoltMotionType motionType,
-                          int isSensor);
+                          int isSensor,
+                          int objectLayer);
+
+// Create many bodies and add them to the broadphase as a batch (AddBodiesPrepare/AddBodiesFinalize)
+// This is much faster than calling JoltCreateBody per body and produces a better balanced broadphase tree
+// settings: count body descriptions
+// outIDs: receives count IDs in the same order as settings (JOLT_INVALID_BODY_ID if a body could not be created)
+// activate: if non-zero, the non-static bodies are activated
+// Returns: number of bodies created
+int JoltCreateBodies(JoltBodyInterface bodyInterface,
+                     const JoltBodyCreationSettings* settings, int count,
+                     JoltBodyID* outIDs,
+                     int activate);
+
+// Remove many bodies from the physics system in one call (the bodies are not destroyed)
+void JoltRemoveBodies(JoltBodyInterface bodyInterface, const JoltBodyID* ids, int count);
+
+// Destroy many bodies in one call (the bodies must have been removed first)
+void JoltDestroyBodies(JoltBodyInterface bodyInterface, const JoltBodyID* ids, int count);
 
 // Activate a body (makes it participate in simulation)
 void JoltActivateBody(JoltBodyInterface bodyInterface, JoltBodyID bodyID);
@@ -57,11 +186,58 @@ void JoltSetBodyShape(JoltBodyInterface bodyInterface,
                      JoltShape shape,
                      int updateMassProperties);
 
-// Destroy a body ID
-void JoltDestroyBodyID(JoltBodyID bodyID);
+// Read the state of many bodies in a single call, taking each body lock once
+// ids: count body IDs to read
+// outPositions, outLinearVelocities, outAngularVelocities: count packed (x, y, z) triples
+// outRotations: count packed (x, y, z, w) quaternions
+// Any output array may be NULL to skip that part of the state.
+// Bodies that no longer exist read as zero position/velocity and identity rotation.
+// Returns: number of bodies that were found
+int JoltReadBodyStates(JoltPhysicsSystem system,
+                       const JoltBodyID* ids, int count,
+                       float* outPositions, float* outRotations,
+                       float* outLinearVelocities, float* outAngularVelocities);
+
+// Read the positions of many bodies as count packed (x, y, z) doubles, taking each body lock once
+// Bodies that no longer exist read as zero. Returns: number of bodies that were found
+int JoltReadBodyPositions64(JoltPhysicsSystem system, const JoltBodyID* ids, int count, double* outPositions);
+
+// Read the state of all active (awake) rigid bodies, skipping sleeping and static bodies
+// outIDs: receives the IDs of the active bodies, in the same order as the state arrays
+// maxBodies: capacity of the output arrays
+// Output arrays are laid out as in JoltReadBodyStates and may be NULL (except outIDs when maxBodies > 0).
+// Must not be called while the physics system is updating.
+// Returns: total number of active bodies; if this is more than maxBodies only the first maxBodies are written
+int JoltReadActiveBodyStates(JoltPhysicsSystem system,
+                             JoltBodyID* outIDs, int maxBodies,
+                             float* outPositions, float* outRotations,
+                             float* outLinearVelocities, float* outAngularVelocities);
 
 #ifdef __cplusplus
 }
+
+// C++ only: body creation and batch insertion shared by JoltCreateBodies, scene loading (see serialize.h)
+// and body groups (see body_group.h)
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/Body/BodyCreationSettings.h>
+#include <Jolt/Physics/Body/BodyInterface.h>
+#include <vector>
+
+JPH::BodyCreationSettings ToBodyCreationSettings(const JoltBodyCreationSettings& settings);
+
+// Rotations from the caller are normalized, and the zero quaternion (an unset Go Quat) means identity
+// Shared with queries (see query.cpp) so bodies and shape casts read a rotation the same way
+JPH::Quat ToRotation(float x, float y, float z, float w);
+
+// Create bodies without adding them, sorting the created IDs into static and moving ones
+// (so only the moving batch gets activated). outIDs receives count IDs in order (JOLT_INVALID_BODY_ID on failure).
+void CreateBodiesSplit(JPH::BodyInterface* bi, const JoltBodyCreationSettings* settings, int count, JoltBodyID* outIDs,
+					   std::vector<JPH::BodyID>& outStaticIDs, std::vector<JPH::BodyID>& outMovingIDs);
+
+// Add a batch of created bodies to the broadphase in one go
+// AddBodiesPrepare reorders the array, so callers pass a scratch copy of their IDs
+void AddBodiesBatch(JPH::BodyInterface* bi, std::vector<JPH::BodyID>& ids, JPH::EActivation activation);
+
 #endif
 
 #endif // JOLT_WRAPPER_BODY_H
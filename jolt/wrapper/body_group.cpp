@@ -0,0 +1,152 @@
+/*
+ * Jolt Physics C Wrapper - Body Groups Implementation
+ */
+
+#include "body_group.h"
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/Body/BodyInterface.h>
+#include <vector>
+
+using namespace JPH;
+
+struct BodyGroupWrapper
+{
+	enum class State
+	{
+		Removed,    // Bodies exist but are not in the broadphase
+		Prepared,   // Broadphase insert prepared, waiting for commit
+		Added,      // Bodies are in the broadphase
+	};
+
+	// One batch per activation mode, so only the moving bodies get activated
+	struct Batch
+	{
+		std::vector<BodyID> ids;    // Reordered by AddBodiesPrepare, kept that way until finalize/abort
+		BodyInterface::AddState state = nullptr;
+	};
+
+	BodyInterface* bodyInterface;
+	Batch staticBatch;
+	Batch movingBatch;
+	State state = State::Removed;
+
+	void Prepare()
+	{
+		for (Batch* batch : { &staticBatch, &movingBatch })
+		{
+			if (!batch->ids.empty())
+			{
+				batch->state = bodyInterface->AddBodiesPrepare(batch->ids.data(), static_cast<int>(batch->ids.size()));
+			}
+		}
+		state = State::Prepared;
+	}
+};
+
+static void FinalizeBatch(BodyInterface* bi, BodyGroupWrapper::Batch& batch, EActivation activation)
+{
+	if (!batch.ids.empty())
+	{
+		bi->AddBodiesFinalize(batch.ids.data(), static_cast<int>(batch.ids.size()), batch.state, activation);
+		batch.state = nullptr;
+	}
+}
+
+static void AbortBatch(BodyInterface* bi, BodyGroupWrapper::Batch& batch)
+{
+	if (!batch.ids.empty())
+	{
+		bi->AddBodiesAbort(batch.ids.data(), static_cast<int>(batch.ids.size()), batch.state);
+		batch.state = nullptr;
+	}
+}
+
+static void RemoveBatch(BodyInterface* bi, BodyGroupWrapper::Batch& batch)
+{
+	if (!batch.ids.empty())
+	{
+		bi->RemoveBodies(batch.ids.data(), static_cast<int>(batch.ids.size()));
+	}
+}
+
+JoltBodyGroup JoltCreateBodyGroup(JoltBodyInterface bodyInterface,
+								  const JoltBodyCreationSettings* settings, int count,
+								  JoltBodyID* outIDs)
+{
+	BodyGroupWrapper* group = new BodyGroupWrapper();
+	group->bodyInterface = static_cast<BodyInterface *>(bodyInterface);
+
+	if (count > 0)
+	{
+		CreateBodiesSplit(group->bodyInterface, settings, count, outIDs, group->staticBatch.ids, group->movingBatch.ids);
+	}
+
+	// Building the broadphase subtrees is the expensive part of adding, and doesn't touch the live broadphase
+	group->Prepare();
+	return group;
+}
+
+void JoltBodyGroupCommit(JoltBodyGroup group, int activate)
+{
+	BodyGroupWrapper* g = static_cast<BodyGroupWrapper *>(group);
+
+	if (g->state == BodyGroupWrapper::State::Added)
+	{
+		return;
+	}
+	if (g->state == BodyGroupWrapper::State::Removed)
+	{
+		g->Prepare();
+	}
+
+	FinalizeBatch(g->bodyInterface, g->staticBatch, EActivation::DontActivate);
+	FinalizeBatch(g->bodyInterface, g->movingBatch, activate != 0 ? EActivation::Activate : EActivation::DontActivate);
+	g->state = BodyGroupWrapper::State::Added;
+}
+
+void JoltBodyGroupRemove(JoltBodyGroup group)
+{
+	BodyGroupWrapper* g = static_cast<BodyGroupWrapper *>(group);
+
+	if (g->state == BodyGroupWrapper::State::Prepared)
+	{
+		AbortBatch(g->bodyInterface, g->staticBatch);
+		AbortBatch(g->bodyInterface, g->movingBatch);
+	}
+	else if (g->state == BodyGroupWrapper::State::Added)
+	{
+		RemoveBatch(g->bodyInterface, g->staticBatch);
+		RemoveBatch(g->bodyInterface, g->movingBatch);
+	}
+	g->state = BodyGroupWrapper::State::Removed;
+}
+
+int JoltBodyGroupIsAdded(JoltBodyGroup group)
+{
+	return static_cast<BodyGroupWrapper *>(group)->state == BodyGroupWrapper::State::Added ? 1 : 0;
+}
+
+int JoltBodyGroupGetNumBodies(JoltBodyGroup group)
+{
+	BodyGroupWrapper* g = static_cast<BodyGroupWrapper *>(group);
+	return static_cast<int>(g->staticBatch.ids.size() + g->movingBatch.ids.size());
+}
+
+void JoltDestroyBodyGroup(JoltBodyGroup group)
+{
+	BodyGroupWrapper* g = static_cast<BodyGroupWrapper *>(group);
+	if (g == nullptr)
+	{
+		return;
+	}
+
+	JoltBodyGroupRemove(group);
+	for (BodyGroupWrapper::Batch* batch : { &g->staticBatch, &g->movingBatch })
+	{
+		if (!batch->ids.empty())
+		{
+			g->bodyInterface->DestroyBodies(batch->ids.data(), static_cast<int>(batch->ids.size()));
+		}
+	}
+	delete g;
+}
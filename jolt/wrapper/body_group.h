@@ -0,0 +1,51 @@
+/*
+ * Jolt Physics C Wrapper - Body Groups
+ *
+ * A body group is a set of bodies (e.g. one streamed map chunk) that is
+ * added to and removed from the broadphase as a whole. The bodies are
+ * created and the broadphase subtree is built up front with
+ * AddBodiesPrepare, which can run on a loader thread while the world keeps
+ * simulating; committing the group is then a single AddBodiesFinalize.
+ */
+
+#ifndef JOLT_WRAPPER_BODY_GROUP_H
+#define JOLT_WRAPPER_BODY_GROUP_H
+
+#include "body.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Opaque pointer type
+typedef void* JoltBodyGroup;
+
+// Create the bodies of a group and prepare their broadphase insert, without adding them to the world
+// Safe to call from any thread, also while the physics system is updating
+// outIDs: receives count IDs in the same order as settings (JOLT_INVALID_BODY_ID if a body could not be created)
+JoltBodyGroup JoltCreateBodyGroup(JoltBodyInterface bodyInterface,
+                                  const JoltBodyCreationSettings* settings, int count,
+                                  JoltBodyID* outIDs);
+
+// Add all bodies of the group to the world at once (prepares the insert again if the group was removed)
+// activate: if non-zero, the kinematic and dynamic bodies are activated
+// Call from the thread that updates the physics system, between updates
+void JoltBodyGroupCommit(JoltBodyGroup group, int activate);
+
+// Remove all bodies of the group from the world in one call; they are kept and can be committed again
+void JoltBodyGroupRemove(JoltBodyGroup group);
+
+// Returns 1 if the group's bodies are in the world, 0 otherwise
+int JoltBodyGroupIsAdded(JoltBodyGroup group);
+
+// Number of bodies in the group (bodies that failed to be created are not counted)
+int JoltBodyGroupGetNumBodies(JoltBodyGroup group);
+
+// Remove the group's bodies if added (or abort the prepared insert), destroy them and free the group
+void JoltDestroyBodyGroup(JoltBodyGroup group);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // JOLT_WRAPPER_BODY_GROUP_H
@@ -5,20 +5,20 @@
 #include "character.h"
 #include "physics.h"
 #include "core.h"
+#include "layers.h"
+#include "character_grid.h"
 #include <Jolt/Jolt.h>
 #include <Jolt/Core/TempAllocator.h>
+#include <Jolt/Core/JobSystem.h>
 #include <Jolt/Physics/Collision/Shape/CapsuleShape.h>
 #include <Jolt/Physics/Character/CharacterVirtual.h>
 #include <memory>
+#include <vector>
+#include <atomic>
+#include <algorithm>
 
 using namespace JPH;
 
-// Collision layers (defined in physics.cpp)
-namespace Layers
-{
-	static constexpr ObjectLayer MOVING = 1;
-};
-
 // Adapter: converts ObjectVsBroadPhaseLayerFilter to BroadPhaseLayerFilter for character collision
 class BroadPhaseLayerFilterAdapter : public BroadPhaseLayerFilter
 {
@@ -31,6 +31,8 @@ public:
 		return m_filter->ShouldCollide(m_object_layer, inLayer);
 	}
 
+	void SetLayer(ObjectLayer layer) { m_object_layer = layer; }
+
 private:
 	const ObjectVsBroadPhaseLayerFilter* m_filter;
 	ObjectLayer m_object_layer;
@@ -48,14 +50,65 @@ public:
 		return m_filter->ShouldCollide(m_object_layer, inLayer);
 	}
 
+	void SetLayer(ObjectLayer layer) { m_object_layer = layer; }
+
 private:
 	const ObjectLayerPairFilter* m_filter;
 	ObjectLayer m_object_layer;
 };
 
+// CharacterVirtual with its layer filters and extended update settings bound at creation,
+// so updates don't rebuild them on every call. Handles point at the CharacterVirtual base.
+class WrappedCharacterVirtual final : public CharacterVirtual
+{
+public:
+	WrappedCharacterVirtual(const CharacterVirtualSettings* settings, RVec3Arg position,
+							PhysicsSystemWrapper* wrapper, ObjectLayer layer)
+		: CharacterVirtual(settings, position, Quat::sIdentity(), GetPhysicsSystem(wrapper)),
+		  m_layer(layer),
+		  m_broad_phase_filter(GetObjectVsBroadPhaseLayerFilter(wrapper), layer),
+		  m_object_layer_filter(GetObjectLayerPairFilter(wrapper), layer) {}
+
+	ObjectLayer GetObjectLayer() const { return m_layer; }
+
+	void SetObjectLayer(ObjectLayer layer)
+	{
+		m_layer = layer;
+		m_broad_phase_filter.SetLayer(layer);
+		m_object_layer_filter.SetLayer(layer);
+	}
+
+	// Collide as a body in the character's object layer would
+	const BroadPhaseLayerFilter& GetBroadPhaseLayerFilter() const { return m_broad_phase_filter; }
+	const ObjectLayerFilter& GetObjectLayerFilter() const { return m_object_layer_filter; }
+
+	ExtendedUpdateSettings& GetExtendedUpdateSettings() { return m_extended_update_settings; }
+
+private:
+	ObjectLayer m_layer;
+	BroadPhaseLayerFilterAdapter m_broad_phase_filter;
+	ObjectLayerFilterAdapter m_object_layer_filter;
+	ExtendedUpdateSettings m_extended_update_settings;
+};
+
+static WrappedCharacterVirtual* ToWrapped(JoltCharacterVirtual character)
+{
+	return static_cast<WrappedCharacterVirtual*>(static_cast<CharacterVirtual*>(character));
+}
+
+static void ToExtendedUpdateSettings(const JoltExtendedUpdateSettings& in, CharacterVirtual::ExtendedUpdateSettings& out)
+{
+	out.mStickToFloorStepDown = Vec3(in.stickToFloorStepDownX, in.stickToFloorStepDownY, in.stickToFloorStepDownZ);
+	out.mWalkStairsStepUp = Vec3(in.walkStairsStepUpX, in.walkStairsStepUpY, in.walkStairsStepUpZ);
+	out.mWalkStairsMinStepForward = in.walkStairsMinStepForward;
+	out.mWalkStairsStepForwardTest = in.walkStairsStepForwardTest;
+	out.mWalkStairsCosAngleForwardContact = in.walkStairsCosAngleForwardContact;
+	out.mWalkStairsStepDownExtra = Vec3(in.walkStairsStepDownExtraX, in.walkStairsStepDownExtraY, in.walkStairsStepDownExtraZ);
+}
+
 JoltCharacterVirtual JoltCreateCharacterVirtual(JoltPhysicsSystem system,
 											 const JoltCharacterVirtualSettings* goSettings,
-											 float x, float y, float z)
+											 double x, double y, double z)
 {
 	PhysicsSystemWrapper *wrapper = static_cast<PhysicsSystemWrapper *>(system);
 	const Shape* s = static_cast<const Shape*>(goSettings->shape);
@@ -80,14 +133,15 @@ JoltCharacterVirtual JoltCreateCharacterVirtual(JoltPhysicsSystem system,
 	settings.mEnhancedInternalEdgeRemoval = goSettings->enhancedInternalEdgeRemoval != 0;
 
 	// Create at specified position using smart pointer for exception safety
-	auto character = std::make_unique<CharacterVirtual>(&settings, RVec3(x, y, z), Quat::sIdentity(), GetPhysicsSystem(wrapper));
-	return static_cast<JoltCharacterVirtual>(character.release());
+	auto character = std::make_unique<WrappedCharacterVirtual>(&settings, RVec3(Real(x), Real(y), Real(z)), wrapper,
+															   static_cast<ObjectLayer>(goSettings->objectLayer));
+	ToExtendedUpdateSettings(goSettings->extendedUpdate, character->GetExtendedUpdateSettings());
+	return static_cast<JoltCharacterVirtual>(static_cast<CharacterVirtual*>(character.release()));
 }
 
 void JoltDestroyCharacterVirtual(JoltCharacterVirtual character)
 {
-	CharacterVirtual* cv = static_cast<CharacterVirtual*>(character);
-	delete cv;
+	delete ToWrapped(character);
 }
 
 void JoltCharacterVirtualUpdate(JoltCharacterVirtual character,
@@ -95,22 +149,19 @@ void JoltCharacterVirtualUpdate(JoltCharacterVirtual character,
 								float deltaTime,
 								float gravityX, float gravityY, float gravityZ)
 {
-	CharacterVirtual* cv = static_cast<CharacterVirtual*>(character);
+	WrappedCharacterVirtual* cv = ToWrapped(character);
 	PhysicsSystemWrapper* wrapper = static_cast<PhysicsSystemWrapper*>(system);
 
-	// Use MOVING layer for character (same as dynamic bodies)
-	BroadPhaseLayerFilterAdapter broad_phase_filter(GetObjectVsBroadPhaseLayerFilter(wrapper), Layers::MOVING);
-	ObjectLayerFilterAdapter object_layer_filter(GetObjectLayerPairFilter(wrapper), Layers::MOVING);
-
-	// Call basic Update with gravity vector and layer filters
+	// Call basic Update with gravity vector and the character's layer filters
+	auto allocatorLock = LockTempAllocator(wrapper);
 	cv->Update(
 		deltaTime,
 		Vec3(gravityX, gravityY, gravityZ),
-		broad_phase_filter,
-		object_layer_filter,
+		cv->GetBroadPhaseLayerFilter(),
+		cv->GetObjectLayerFilter(),
 		{}, // Empty BodyFilter (collides with all bodies)
 		{}, // Empty ShapeFilter (collides with all shapes)
-		*gTempAllocator.get()
+		*GetTempAllocator(wrapper)
 	);
 }
 
@@ -119,29 +170,33 @@ void JoltCharacterVirtualExtendedUpdate(JoltCharacterVirtual character,
 										float deltaTime,
 										float gravityX, float gravityY, float gravityZ)
 {
-	CharacterVirtual* cv = static_cast<CharacterVirtual*>(character);
+	WrappedCharacterVirtual* cv = ToWrapped(character);
 	PhysicsSystemWrapper* wrapper = static_cast<PhysicsSystemWrapper*>(system);
 
-	// Use default extended update settings
-	CharacterVirtual::ExtendedUpdateSettings settings;
-
-	// Use MOVING layer for character (same as dynamic bodies)
-	BroadPhaseLayerFilterAdapter broad_phase_filter(GetObjectVsBroadPhaseLayerFilter(wrapper), Layers::MOVING);
-	ObjectLayerFilterAdapter object_layer_filter(GetObjectLayerPairFilter(wrapper), Layers::MOVING);
-
-	// Call ExtendedUpdate with gravity vector and layer filters
+	// Call ExtendedUpdate with gravity vector and the character's settings and layer filters
+	auto allocatorLock = LockTempAllocator(wrapper);
 	cv->ExtendedUpdate(
 		deltaTime,
 		Vec3(gravityX, gravityY, gravityZ),
-		settings,
-		broad_phase_filter,
-		object_layer_filter,
+		cv->GetExtendedUpdateSettings(),
+		cv->GetBroadPhaseLayerFilter(),
+		cv->GetObjectLayerFilter(),
 		{}, // Empty BodyFilter (collides with all bodies)
 		{}, // Empty ShapeFilter (collides with all shapes)
-		*gTempAllocator.get()
+		*GetTempAllocator(wrapper)
 	);
 }
 
+void JoltCharacterVirtualSetObjectLayer(JoltCharacterVirtual character, unsigned int objectLayer)
+{
+	ToWrapped(character)->SetObjectLayer(static_cast<ObjectLayer>(objectLayer));
+}
+
+void JoltCharacterVirtualSetExtendedUpdateSettings(JoltCharacterVirtual character, const JoltExtendedUpdateSettings* settings)
+{
+	ToExtendedUpdateSettings(*settings, ToWrapped(character)->GetExtendedUpdateSettings());
+}
+
 void JoltCharacterVirtualSetLinearVelocity(JoltCharacterVirtual character,
 										   float x, float y, float z)
 {
@@ -170,20 +225,20 @@ void JoltCharacterVirtualGetGroundVelocity(const JoltCharacterVirtual character,
 }
 
 void JoltCharacterVirtualSetPosition(JoltCharacterVirtual character,
-									 float x, float y, float z)
+									 double x, double y, double z)
 {
 	CharacterVirtual* cv = static_cast<CharacterVirtual*>(character);
-	cv->SetPosition(RVec3(x, y, z));
+	cv->SetPosition(RVec3(Real(x), Real(y), Real(z)));
 }
 
 void JoltCharacterVirtualGetPosition(const JoltCharacterVirtual character,
-									 float* x, float* y, float* z)
+									 double* x, double* y, double* z)
 {
 	const CharacterVirtual* cv = static_cast<const CharacterVirtual*>(character);
 	RVec3 pos = cv->GetPosition();
-	*x = static_cast<float>(pos.GetX());
-	*y = static_cast<float>(pos.GetY());
-	*z = static_cast<float>(pos.GetZ());
+	*x = static_cast<double>(pos.GetX());
+	*y = static_cast<double>(pos.GetY());
+	*z = static_cast<double>(pos.GetZ());
 }
 
 JoltGroundState JoltCharacterVirtualGetGroundState(const JoltCharacterVirtual character)
@@ -204,23 +259,20 @@ void JoltCharacterVirtualSetShape(JoltCharacterVirtual character,
 								  float maxPenetrationDepth,
 								  JoltPhysicsSystem system)
 {
-	CharacterVirtual* cv = static_cast<CharacterVirtual*>(character);
+	WrappedCharacterVirtual* cv = ToWrapped(character);
 	const Shape* s = static_cast<const Shape*>(shape);
 	PhysicsSystemWrapper* wrapper = static_cast<PhysicsSystemWrapper*>(system);
 
-	// Use MOVING layer for character (same as dynamic bodies)
-	BroadPhaseLayerFilterAdapter broad_phase_filter(GetObjectVsBroadPhaseLayerFilter(wrapper), Layers::MOVING);
-	ObjectLayerFilterAdapter object_layer_filter(GetObjectLayerPairFilter(wrapper), Layers::MOVING);
-
-	// Call SetShape with required filters
+	// Call SetShape with the character's layer filters
+	auto allocatorLock = LockTempAllocator(wrapper);
 	cv->SetShape(
 		s,
 		maxPenetrationDepth,
-		broad_phase_filter,
-		object_layer_filter,
+		cv->GetBroadPhaseLayerFilter(),
+		cv->GetObjectLayerFilter(),
 		{}, // Empty BodyFilter (collides with all bodies)
 		{}, // Empty ShapeFilter (collides with all shapes)
-		*gTempAllocator.get()
+		*GetTempAllocator(wrapper)
 	);
 }
 
@@ -244,13 +296,13 @@ void JoltCharacterVirtualGetGroundNormal(const JoltCharacterVirtual character,
 
 // Get the position of the ground contact point
 void JoltCharacterVirtualGetGroundPosition(const JoltCharacterVirtual character,
-										   float* x, float* y, float* z)
+										   double* x, double* y, double* z)
 {
 	const CharacterVirtual* cv = static_cast<const CharacterVirtual*>(character);
 	RVec3 pos = cv->GetGroundPosition();
-	*x = static_cast<float>(pos.GetX());
-	*y = static_cast<float>(pos.GetY());
-	*z = static_cast<float>(pos.GetZ());
+	*x = static_cast<double>(pos.GetX());
+	*y = static_cast<double>(pos.GetY());
+	*z = static_cast<double>(pos.GetZ());
 }
 
 // Get the active contacts for the character
@@ -292,15 +344,8 @@ int JoltCharacterVirtualGetActiveContacts(const JoltCharacterVirtual character,
 		contacts[i].distance = c.mDistance;
 		contacts[i].fraction = c.mFraction;
 
-		// Create a copy of the BodyID for the Go layer
-		if (c.mBodyB.IsInvalid())
-		{
-			contacts[i].bodyB = nullptr;
-		}
-		else
-		{
-			contacts[i].bodyB = new BodyID(c.mBodyB);
-		}
+		// Body IDs cross the C boundary by value (invalid IDs stay JOLT_INVALID_BODY_ID)
+		contacts[i].bodyB = c.mBodyB.GetIndexAndSequenceNumber();
 
 		contacts[i].userData = c.mUserData;
 
@@ -313,3 +358,187 @@ int JoltCharacterVirtualGetActiveContacts(const JoltCharacterVirtual character,
 
 	return numToReturn;
 }
+
+// Scratch memory of each concurrent batch of a group update (character updates allocate per call and free
+// before returning, so this only needs to hold the working set of one character)
+static constexpr uint cGroupTempAllocatorSize = 1024 * 1024;
+
+// Smallest number of characters handed to a single job
+static constexpr int cMinCharactersPerBatch = 4;
+
+struct CharacterGroupWrapper
+{
+	PhysicsSystemWrapper* system;
+	std::vector<CharacterVirtual*> characters;
+	std::vector<ObjectLayer> layers;  // Layer of each character, refreshed before building the collision grid
+
+	// One allocator per concurrent batch, so workers never contend on gTempAllocatorMutex
+	std::vector<std::unique_ptr<TempAllocatorImpl>> allocators;
+
+	// Character vs character collision between the members (null if disabled)
+	std::unique_ptr<CharacterGridCollision> collision;
+};
+
+JoltCharacterGroup JoltCreateCharacterGroup(JoltPhysicsSystem system)
+{
+	auto group = std::make_unique<CharacterGroupWrapper>();
+	group->system = static_cast<PhysicsSystemWrapper*>(system);
+	return static_cast<JoltCharacterGroup>(group.release());
+}
+
+void JoltDestroyCharacterGroup(JoltCharacterGroup group)
+{
+	delete static_cast<CharacterGroupWrapper*>(group);
+}
+
+int JoltCharacterGroupAdd(JoltCharacterGroup group, JoltCharacterVirtual character)
+{
+	CharacterGroupWrapper* g = static_cast<CharacterGroupWrapper*>(group);
+	CharacterVirtual* cv = static_cast<CharacterVirtual*>(character);
+	g->characters.push_back(cv);
+	g->layers.push_back(ToWrapped(cv)->GetObjectLayer());
+	if (g->collision)
+	{
+		cv->SetCharacterVsCharacterCollision(g->collision.get());
+	}
+	return static_cast<int>(g->characters.size()) - 1;
+}
+
+void JoltCharacterGroupRemove(JoltCharacterGroup group, int index)
+{
+	CharacterGroupWrapper* g = static_cast<CharacterGroupWrapper*>(group);
+	if (index < 0 || index >= static_cast<int>(g->characters.size()))
+	{
+		return;
+	}
+
+	if (g->collision)
+	{
+		g->characters[index]->SetCharacterVsCharacterCollision(nullptr);
+	}
+
+	// Swap with the last character so the arrays stay packed
+	g->characters[index] = g->characters.back();
+	g->layers[index] = g->layers.back();
+	g->characters.pop_back();
+	g->layers.pop_back();
+}
+
+void JoltCharacterGroupSetCollision(JoltCharacterGroup group, int enabled, float cellSize)
+{
+	CharacterGroupWrapper* g = static_cast<CharacterGroupWrapper*>(group);
+
+	if (enabled == 0)
+	{
+		for (CharacterVirtual* cv : g->characters)
+		{
+			cv->SetCharacterVsCharacterCollision(nullptr);
+		}
+		g->collision.reset();
+		return;
+	}
+
+	if (g->collision)
+	{
+		g->collision->SetCellSize(cellSize);
+		return;
+	}
+
+	g->collision = std::make_unique<CharacterGridCollision>(GetLayerTable(g->system), cellSize);
+	for (CharacterVirtual* cv : g->characters)
+	{
+		cv->SetCharacterVsCharacterCollision(g->collision.get());
+	}
+}
+
+int JoltCharacterGroupUpdate(JoltCharacterGroup group,
+							 float deltaTime,
+							 float gravityX, float gravityY, float gravityZ,
+							 const float* velocities, int numVelocities,
+							 JoltCharacterState* outStates, int maxStates,
+							 int extended, int multithreaded)
+{
+	CharacterGroupWrapper* g = static_cast<CharacterGroupWrapper*>(group);
+	PhysicsSystemWrapper* wrapper = g->system;
+	int numCharacters = static_cast<int>(g->characters.size());
+
+	// Jolt's character vs character contacts read the other character's velocity (and user data) while it
+	// updates, so colliding groups run on this thread: splitting them would race on those reads
+	JobSystem* jobSystem = multithreaded != 0 && !g->collision ? GetJobSystem(wrapper) : nullptr;
+
+	// RunParallelBatches never starts more batches than the job system's max concurrency
+	size_t numAllocators = jobSystem != nullptr ? static_cast<size_t>(std::max(jobSystem->GetMaxConcurrency(), 1)) : 1;
+	while (g->allocators.size() < numAllocators)
+	{
+		g->allocators.push_back(std::make_unique<TempAllocatorImpl>(cGroupTempAllocatorSize));
+	}
+	std::atomic<size_t> nextAllocator(0);
+
+	// Apply the input velocities before any character updates, so every collision sees the new inputs
+	if (velocities != nullptr)
+	{
+		int numInputs = std::min(numCharacters, numVelocities);
+		for (int i = 0; i < numInputs; i++)
+		{
+			g->characters[i]->SetLinearVelocity(Vec3(velocities[i * 3], velocities[i * 3 + 1], velocities[i * 3 + 2]));
+		}
+	}
+
+	// Characters collide with the other characters where they were before this update. Their velocities
+	// are read live, so the result depends on the (fixed) update order, which keeps it deterministic.
+	if (g->collision)
+	{
+		for (size_t i = 0; i < g->characters.size(); i++)
+		{
+			g->layers[i] = ToWrapped(g->characters[i])->GetObjectLayer();
+		}
+		g->collision->Build(g->characters, g->layers);
+	}
+
+	Vec3 gravity(gravityX, gravityY, gravityZ);
+
+	auto updateRange = [&](int begin, int end)
+	{
+		TempAllocator& allocator = *g->allocators[nextAllocator++];
+
+		for (int i = begin; i < end; i++)
+		{
+			WrappedCharacterVirtual* cv = ToWrapped(g->characters[i]);
+
+			if (extended != 0)
+			{
+				cv->ExtendedUpdate(deltaTime, gravity, cv->GetExtendedUpdateSettings(),
+								   cv->GetBroadPhaseLayerFilter(), cv->GetObjectLayerFilter(), {}, {}, allocator);
+			}
+			else
+			{
+				cv->Update(deltaTime, gravity, cv->GetBroadPhaseLayerFilter(), cv->GetObjectLayerFilter(), {}, {}, allocator);
+			}
+
+			if (outStates != nullptr && i < maxStates)
+			{
+				JoltCharacterState& state = outStates[i];
+				RVec3 position = cv->GetPosition();
+				Vec3 velocity = cv->GetLinearVelocity();
+				state.positionX = static_cast<float>(position.GetX());
+				state.positionY = static_cast<float>(position.GetY());
+				state.positionZ = static_cast<float>(position.GetZ());
+				state.velocityX = velocity.GetX();
+				state.velocityY = velocity.GetY();
+				state.velocityZ = velocity.GetZ();
+				state.groundState = static_cast<int>(cv->GetGroundState());
+			}
+		}
+	};
+
+	if (jobSystem != nullptr)
+	{
+		RunParallelBatches(jobSystem, numCharacters, cMinCharactersPerBatch, updateRange);
+	}
+	else
+	{
+		updateRange(0, numCharacters);
+	}
+
+	return outStates != nullptr ? std::min(numCharacters, std::max(maxStates, 0)) : 0;
+}
@@ -13,9 +13,10 @@ extern "C" {
 
 // Opaque pointer types
 typedef void* JoltCharacterVirtual;
+typedef void* JoltCharacterGroup;
 typedef void* JoltPhysicsSystem;
 typedef void* JoltShape;
-typedef void* JoltBodyID;
+typedef unsigned int JoltBodyID;   // Packed index/sequence number, see body.h
 
 // Ground state enum (matches Jolt's EGroundState)
 typedef enum {
@@ -45,7 +46,7 @@ typedef struct {
     float surfaceNormalX, surfaceNormalY, surfaceNormalZ;     // Surface normal of the contact
     float distance;                                     // Distance to contact (<= 0 means actual contact, > 0 means predictive)
     float fraction;                                     // Fraction along the path where this contact takes place
-    JoltBodyID bodyB;                                   // ID of body we're colliding with
+    JoltBodyID bodyB;                                   // ID of body we're colliding with (JOLT_INVALID_BODY_ID if none)
     unsigned long long userData;                        // User data of B
     int isSensorB;                                      // If B is a sensor (bool as int)
     int hadCollision;                                   // If the character actually collided (bool as int)
@@ -53,6 +54,16 @@ typedef struct {
     int canPushCharacter;                               // When true, velocity can push character (bool as int)
 } JoltCharacterContact;
 
+// Extended update settings (matches Jolt's CharacterVirtual::ExtendedUpdateSettings)
+typedef struct {
+    float stickToFloorStepDownX, stickToFloorStepDownY, stickToFloorStepDownZ;  // Floor probe when leaving the ground (zero disables StickToFloor)
+    float walkStairsStepUpX, walkStairsStepUpY, walkStairsStepUpZ;              // Max stair step up (zero disables WalkStairs)
+    float walkStairsMinStepForward;          // Distance to move forward after stepping up
+    float walkStairsStepForwardTest;         // Distance to test ahead for a floor after stepping up
+    float walkStairsCosAngleForwardContact;  // Cos of the max angle between the contact normal and the movement direction
+    float walkStairsStepDownExtraX, walkStairsStepDownExtraY, walkStairsStepDownExtraZ;  // Extra step down after a stair step
+} JoltExtendedUpdateSettings;
+
 // Character virtual settings structure
 typedef struct {
     JoltShape shape;
@@ -72,12 +83,15 @@ typedef struct {
     float hitReductionCosMaxAngle;
     float penetrationRecoverySpeed;
     int enhancedInternalEdgeRemoval;  // bool as int (0 or 1)
+    unsigned int objectLayer;         // Object layer the character collides as (see physics.h)
+    JoltExtendedUpdateSettings extendedUpdate;  // Used by JoltCharacterVirtualExtendedUpdate and group updates
 } JoltCharacterVirtualSettings;
 
 // Create a new virtual character with settings at initial position (x, y, z)
+// The layer filters and extended update settings are bound here, so updates do no per-call setup
 JoltCharacterVirtual JoltCreateCharacterVirtual(JoltPhysicsSystem system,
                                               const JoltCharacterVirtualSettings* settings,
-                                              float x, float y, float z);
+                                              double x, double y, double z);
 
 // Destroy a virtual character
 void JoltDestroyCharacterVirtual(JoltCharacterVirtual character);
@@ -90,12 +104,19 @@ void JoltCharacterVirtualUpdate(JoltCharacterVirtual character,
                                 float gravityX, float gravityY, float gravityZ);
 
 // Update virtual character with extended update (combines Update, StickToFloor, WalkStairs)
+// using the character's extended update settings
 // gravityX/Y/Z: gravity vector applied when character stands on another object
 void JoltCharacterVirtualExtendedUpdate(JoltCharacterVirtual character,
                                         JoltPhysicsSystem system,
                                         float deltaTime,
                                         float gravityX, float gravityY, float gravityZ);
 
+// Change the object layer the character collides as (rebinds the character's layer filters)
+void JoltCharacterVirtualSetObjectLayer(JoltCharacterVirtual character, unsigned int objectLayer);
+
+// Change the settings used by the character's extended updates
+void JoltCharacterVirtualSetExtendedUpdateSettings(JoltCharacterVirtual character, const JoltExtendedUpdateSettings* settings);
+
 // Set the linear velocity of a virtual character
 void JoltCharacterVirtualSetLinearVelocity(JoltCharacterVirtual character,
                                            float x, float y, float z);
@@ -110,11 +131,11 @@ void JoltCharacterVirtualGetGroundVelocity(const JoltCharacterVirtual character,
 
 // Set the position of a virtual character
 void JoltCharacterVirtualSetPosition(JoltCharacterVirtual character,
-                                     float x, float y, float z);
+                                     double x, double y, double z);
 
 // Get the position of a virtual character
 void JoltCharacterVirtualGetPosition(const JoltCharacterVirtual character,
-                                     float* x, float* y, float* z);
+                                     double* x, double* y, double* z);
 
 // Get the ground state of a virtual character
 JoltGroundState JoltCharacterVirtualGetGroundState(const JoltCharacterVirtual character);
@@ -140,7 +161,7 @@ void JoltCharacterVirtualGetGroundNormal(const JoltCharacterVirtual character,
 
 // Get the position of the ground contact point
 void JoltCharacterVirtualGetGroundPosition(const JoltCharacterVirtual character,
-                                           float* x, float* y, float* z);
+                                           double* x, double* y, double* z);
 
 // Get the active contacts for the character
 // contacts: pointer to array to store contacts (must be pre-allocated)
@@ -150,6 +171,50 @@ int JoltCharacterVirtualGetActiveContacts(const JoltCharacterVirtual character,
                                           JoltCharacterContact* contacts,
                                           int maxContacts);
 
+// State of a character after a group update
+typedef struct {
+    float positionX, positionY, positionZ;
+    float velocityX, velocityY, velocityZ;
+    int groundState;                       // JoltGroundState
+} JoltCharacterState;
+
+// Create a group of characters that are updated together (characters are added with JoltCharacterGroupAdd)
+JoltCharacterGroup JoltCreateCharacterGroup(JoltPhysicsSystem system);
+
+// Destroy a character group (the characters themselves are not destroyed; with collision enabled,
+// characters still in the group may not be updated after it is destroyed)
+void JoltDestroyCharacterGroup(JoltCharacterGroup group);
+
+// Add a character to a group
+// Returns: index of the character in the group
+int JoltCharacterGroupAdd(JoltCharacterGroup group, JoltCharacterVirtual character);
+
+// Remove the character at index from a group; the last character moves into its index
+void JoltCharacterGroupRemove(JoltCharacterGroup group, int index);
+
+// Enable or disable collision between the characters of a group
+// Characters are bucketed into a uniform grid once per JoltCharacterGroupUpdate, so each character only
+// tests the characters in nearby cells. Pairs whose object layers don't collide are skipped.
+// cellSize: edge length of a grid cell, about the size of a character (<= 0 for the default of 2)
+// Calling it again while enabled only changes the cell size.
+void JoltCharacterGroupSetCollision(JoltCharacterGroup group, int enabled, float cellSize);
+
+// Update every character of a group in a single call
+// velocities: numVelocities packed (x, y, z) velocities set on the first characters before the update
+//             (NULL or fewer than the group size: the other characters keep their velocity)
+// outStates: receives the state of the first maxStates characters after the update (can be NULL)
+// extended: if non-zero, runs ExtendedUpdate (with each character's extended update settings) instead of Update
+// multithreaded: if non-zero, the characters are split across the job system worker threads, each
+//                batch using its own temp allocator. Ignored while collision is enabled: Jolt reads the
+//                velocity of the other character of a contact, so colliding groups update on the calling thread
+// Returns: number of states written to outStates
+int JoltCharacterGroupUpdate(JoltCharacterGroup group,
+                             float deltaTime,
+                             float gravityX, float gravityY, float gravityZ,
+                             const float* velocities, int numVelocities,
+                             JoltCharacterState* outStates, int maxStates,
+                             int extended, int multithreaded);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,214 @@
+/*
+ * Jolt Physics C Wrapper - Grid Based Character vs Character Collision Implementation
+ */
+
+#include "character_grid.h"
+#include "layers.h"
+#include <Jolt/Physics/Collision/CollisionDispatch.h>
+#include <Jolt/Physics/Collision/CollideShape.h>
+#include <Jolt/Physics/Collision/ShapeCast.h>
+#include <algorithm>
+#include <cmath>
+
+using namespace JPH;
+
+// Characters whose bounds touch more cells than this are tested by every query instead of being put into the grid
+static constexpr int cMaxCellsPerCharacter = 64;
+
+// Queries touching more cells than this (e.g. a very long sweep) test every character instead of walking the grid
+static constexpr int cMaxCellsPerQuery = 256;
+
+// Cell coordinates are packed into 21 bits per axis
+static constexpr int cCellCoordinateLimit = (1 << 20) - 1;
+
+static uint64 CellKey(int x, int y, int z)
+{
+	auto pack = [](int v) { return static_cast<uint64>(v + cCellCoordinateLimit + 1) & 0x1fffff; };
+	return (pack(x) << 42) | (pack(y) << 21) | pack(z);
+}
+
+CharacterGridCollision::CharacterGridCollision(const LayerTable& layers, float cellSize)
+	: m_layers(layers)
+{
+	SetCellSize(cellSize);
+}
+
+void CharacterGridCollision::SetCellSize(float cellSize)
+{
+	m_cell_size = cellSize > 0.0f ? cellSize : 2.0f;
+	m_inv_cell_size = 1.0f / m_cell_size;
+}
+
+void CharacterGridCollision::CellRange(const AABox& bounds, int outMin[3], int outMax[3]) const
+{
+	for (int axis = 0; axis < 3; axis++)
+	{
+		float lo = std::floor(bounds.mMin[axis] * m_inv_cell_size);
+		float hi = std::floor(bounds.mMax[axis] * m_inv_cell_size);
+		outMin[axis] = static_cast<int>(std::clamp(lo, -float(cCellCoordinateLimit), float(cCellCoordinateLimit)));
+		outMax[axis] = static_cast<int>(std::clamp(hi, -float(cCellCoordinateLimit), float(cCellCoordinateLimit)));
+	}
+}
+
+void CharacterGridCollision::Build(const std::vector<CharacterVirtual*>& characters, const std::vector<ObjectLayer>& layers)
+{
+	m_entries.clear();
+	m_cells.clear();
+	m_large.clear();
+	m_characters.clear();
+
+	for (size_t i = 0; i < characters.size(); i++)
+	{
+		const CharacterVirtual* character = characters[i];
+		int index = static_cast<int>(m_entries.size());
+
+		Entry entry;
+		entry.character = character;
+		entry.transform = character->GetCenterOfMassTransform();
+		entry.bounds = character->GetShape()->GetWorldSpaceBounds(entry.transform, Vec3::sOne());
+		entry.bounds.ExpandBy(Vec3::sReplicate(character->GetCharacterPadding()));
+		entry.layer = layers[i];
+
+		int cellMax[3];
+		CellRange(entry.bounds, entry.cellMin, cellMax);
+		m_entries.push_back(entry);
+		m_characters.push_back({ character, index });
+
+		int64 numCells = int64(cellMax[0] - entry.cellMin[0] + 1) * (cellMax[1] - entry.cellMin[1] + 1) * (cellMax[2] - entry.cellMin[2] + 1);
+		if (numCells > cMaxCellsPerCharacter)
+		{
+			m_large.push_back(index);
+			continue;
+		}
+
+		for (int x = entry.cellMin[0]; x <= cellMax[0]; x++)
+			for (int y = entry.cellMin[1]; y <= cellMax[1]; y++)
+				for (int z = entry.cellMin[2]; z <= cellMax[2]; z++)
+					m_cells.push_back({ CellKey(x, y, z), index });
+	}
+
+	std::sort(m_cells.begin(), m_cells.end());
+	std::sort(m_characters.begin(), m_characters.end());
+}
+
+template <class Visitor>
+void CharacterGridCollision::ForEachCandidate(const CharacterVirtual* inCharacter, const AABox& queryBounds, const Visitor& visit) const
+{
+	// Layer of the querying character (characters outside the group collide with every layer)
+	auto self = std::lower_bound(m_characters.begin(), m_characters.end(), CharacterRef{ inCharacter, 0 });
+	bool inGroup = self != m_characters.end() && self->character == inCharacter;
+	ObjectLayer selfLayer = inGroup ? m_entries[self->entry].layer : ObjectLayer(0);
+
+	auto test = [&](int index)
+	{
+		const Entry& entry = m_entries[index];
+		if (entry.character != inCharacter
+			&& (!inGroup || m_layers.ShouldCollide(selfLayer, entry.layer))
+			&& entry.bounds.Overlaps(queryBounds))
+		{
+			visit(entry);
+		}
+	};
+
+	int queryMin[3], queryMax[3];
+	CellRange(queryBounds, queryMin, queryMax);
+	int64 numCells = int64(queryMax[0] - queryMin[0] + 1) * (queryMax[1] - queryMin[1] + 1) * (queryMax[2] - queryMin[2] + 1);
+
+	if (numCells > cMaxCellsPerQuery)
+	{
+		for (int index = 0; index < static_cast<int>(m_entries.size()); index++)
+		{
+			test(index);
+		}
+		return;
+	}
+
+	for (int x = queryMin[0]; x <= queryMax[0]; x++)
+		for (int y = queryMin[1]; y <= queryMax[1]; y++)
+			for (int z = queryMin[2]; z <= queryMax[2]; z++)
+			{
+				auto cell = std::lower_bound(m_cells.begin(), m_cells.end(), CellRef{ CellKey(x, y, z), 0 });
+				for (; cell != m_cells.end() && cell->key == CellKey(x, y, z); ++cell)
+				{
+					// A character touching several query cells is only tested in the first cell both ranges share
+					const Entry& entry = m_entries[cell->entry];
+					if (x == std::max(entry.cellMin[0], queryMin[0])
+						&& y == std::max(entry.cellMin[1], queryMin[1])
+						&& z == std::max(entry.cellMin[2], queryMin[2]))
+					{
+						test(cell->entry);
+					}
+				}
+			}
+
+	for (int index : m_large)
+	{
+		test(index);
+	}
+}
+
+void CharacterGridCollision::CollideCharacter(const CharacterVirtual* inCharacter, RMat44Arg inCenterOfMassTransform,
+											  const CollideShapeSettings& inCollideShapeSettings, RVec3Arg inBaseOffset,
+											  CollideShapeCollector& ioCollector) const
+{
+	const Shape* shape = inCharacter->GetShape();
+
+	AABox queryBounds = shape->GetWorldSpaceBounds(inCenterOfMassTransform, Vec3::sOne());
+	queryBounds.ExpandBy(Vec3::sReplicate(inCollideShapeSettings.mMaxSeparationDistance));
+
+	// Make the shapes relative to inBaseOffset (as CharacterVsCharacterCollisionSimple does)
+	Mat44 transform1 = inCenterOfMassTransform.PostTranslated(-inBaseOffset).ToMat44();
+	CollideShapeSettings settings = inCollideShapeSettings;
+
+	ForEachCandidate(inCharacter, queryBounds, [&](const Entry& entry)
+	{
+		if (ioCollector.ShouldEarlyOut())
+		{
+			return;
+		}
+
+		// Collector needs to know which character we're colliding with
+		ioCollector.SetUserData(reinterpret_cast<uint64>(entry.character));
+
+		// Add the padding of the other character so that we detect collision with its outer shell
+		Mat44 transform2 = entry.transform.PostTranslated(-inBaseOffset).ToMat44();
+		settings.mMaxSeparationDistance = inCollideShapeSettings.mMaxSeparationDistance + entry.character->GetCharacterPadding();
+		CollisionDispatch::sCollideShapeVsShape(shape, entry.character->GetShape(), Vec3::sOne(), Vec3::sOne(),
+												transform1, transform2, SubShapeIDCreator(), SubShapeIDCreator(),
+												settings, ioCollector);
+	});
+
+	ioCollector.SetUserData(0);
+}
+
+void CharacterGridCollision::CastCharacter(const CharacterVirtual* inCharacter, RMat44Arg inCenterOfMassTransform,
+										   Vec3Arg inDirection, const ShapeCastSettings& inShapeCastSettings,
+										   RVec3Arg inBaseOffset, CastShapeCollector& ioCollector) const
+{
+	// Bounds of the whole sweep
+	AABox queryBounds = inCharacter->GetShape()->GetWorldSpaceBounds(inCenterOfMassTransform, Vec3::sOne());
+	AABox endBounds = queryBounds;
+	endBounds.Translate(inDirection);
+	queryBounds.Encapsulate(endBounds);
+
+	// Make the shape cast relative to inBaseOffset (as CharacterVsCharacterCollisionSimple does)
+	Mat44 transform1 = inCenterOfMassTransform.PostTranslated(-inBaseOffset).ToMat44();
+	ShapeCast shapeCast(inCharacter->GetShape(), Vec3::sOne(), transform1, inDirection);
+
+	ForEachCandidate(inCharacter, queryBounds, [&](const Entry& entry)
+	{
+		if (ioCollector.ShouldEarlyOut())
+		{
+			return;
+		}
+
+		// Collector needs to know which character we're colliding with
+		ioCollector.SetUserData(reinterpret_cast<uint64>(entry.character));
+
+		Mat44 transform2 = entry.transform.PostTranslated(-inBaseOffset).ToMat44();
+		CollisionDispatch::sCastShapeVsShapeWorldSpace(shapeCast, inShapeCastSettings, entry.character->GetShape(), Vec3::sOne(),
+													   {}, transform2, SubShapeIDCreator(), SubShapeIDCreator(), ioCollector);
+	});
+
+	ioCollector.SetUserData(0);
+}
@@ -0,0 +1,85 @@
+/*
+ * Jolt Physics C Wrapper - Grid Based Character vs Character Collision (C++ only)
+ *
+ * Jolt's CharacterVsCharacterCollisionSimple tests every character against
+ * every other one. This implementation snapshots the characters of a group
+ * into a uniform grid once per update, so each character only tests the
+ * characters in the cells its bounds touch.
+ *
+ * The snapshot is immutable while the characters update, which also makes it
+ * safe for the group's worker threads to query it concurrently.
+ */
+
+#ifndef JOLT_WRAPPER_CHARACTER_GRID_H
+#define JOLT_WRAPPER_CHARACTER_GRID_H
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Geometry/AABox.h>
+#include <Jolt/Physics/Collision/ObjectLayer.h>
+#include <Jolt/Physics/Character/CharacterVirtual.h>
+#include <vector>
+
+class LayerTable;
+
+class CharacterGridCollision final : public JPH::CharacterVsCharacterCollision
+{
+public:
+	CharacterGridCollision(const LayerTable& layers, float cellSize);
+
+	void SetCellSize(float cellSize);
+
+	// Snapshot the transforms and bounds of the characters (single threaded, before they update)
+	void Build(const std::vector<JPH::CharacterVirtual*>& characters, const std::vector<JPH::ObjectLayer>& layers);
+
+	// CharacterVsCharacterCollision
+	virtual void CollideCharacter(const JPH::CharacterVirtual* inCharacter, JPH::RMat44Arg inCenterOfMassTransform,
+								  const JPH::CollideShapeSettings& inCollideShapeSettings, JPH::RVec3Arg inBaseOffset,
+								  JPH::CollideShapeCollector& ioCollector) const override;
+	virtual void CastCharacter(const JPH::CharacterVirtual* inCharacter, JPH::RMat44Arg inCenterOfMassTransform,
+							   JPH::Vec3Arg inDirection, const JPH::ShapeCastSettings& inShapeCastSettings,
+							   JPH::RVec3Arg inBaseOffset, JPH::CastShapeCollector& ioCollector) const override;
+
+private:
+	struct Entry
+	{
+		const JPH::CharacterVirtual* character;
+		JPH::RMat44 transform;      // Center of mass transform at snapshot time
+		JPH::AABox bounds;          // World space bounds including the character padding
+		JPH::ObjectLayer layer;
+		int cellMin[3];             // First cell the bounds touch (used to report each pair only once)
+	};
+
+	struct CellRef
+	{
+		JPH::uint64 key;
+		int entry;
+
+		bool operator<(const CellRef& other) const { return key < other.key || (key == other.key && entry < other.entry); }
+	};
+
+	struct CharacterRef
+	{
+		const JPH::CharacterVirtual* character;
+		int entry;
+
+		bool operator<(const CharacterRef& other) const { return character < other.character; }
+	};
+
+	void CellRange(const JPH::AABox& bounds, int outMin[3], int outMax[3]) const;
+
+	// Call visit(entry) once for every snapshot character whose bounds overlap the query bounds and
+	// whose layer collides with the querying character's layer
+	template <class Visitor>
+	void ForEachCandidate(const JPH::CharacterVirtual* inCharacter, const JPH::AABox& queryBounds, const Visitor& visit) const;
+
+	const LayerTable& m_layers;
+	float m_cell_size;
+	float m_inv_cell_size;
+
+	std::vector<Entry> m_entries;
+	std::vector<CellRef> m_cells;           // Sorted by cell key
+	std::vector<int> m_large;               // Entries that span too many cells to be put into the grid
+	std::vector<CharacterRef> m_characters; // Sorted by pointer, to find the querying character's entry
+};
+
+#endif // JOLT_WRAPPER_CHARACTER_GRID_H
@@ -6,12 +6,22 @@
 #include <Jolt/Jolt.h>
 #include <Jolt/RegisterTypes.h>
 #include <Jolt/Core/Factory.h>
+#include <Jolt/Core/Profiler.h>
 #include <Jolt/Core/TempAllocator.h>
 #include <Jolt/Core/JobSystemThreadPool.h>
+#include <Jolt/Core/JobSystemSingleThreaded.h>
 #include <Jolt/Physics/PhysicsSettings.h>
 #include <iostream>
 #include <memory>
+#include <algorithm>
 #include <cstdarg>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 using namespace JPH;
 
@@ -38,11 +48,49 @@ static bool AssertFailedImpl(const char *inExpression, const char *inMessage, co
 // Global Jolt resources (shared by all PhysicsSystems)
 // Using smart pointers for automatic cleanup and exception safety
 std::unique_ptr<TempAllocatorImpl> gTempAllocator;
-std::unique_ptr<JobSystemThreadPool> gJobSystem;
+std::unique_ptr<JobSystem> gJobSystem;
+
+#ifdef JPH_PROFILE_ENABLED
+// Whether JoltInit created the profiler (and must delete it on shutdown)
+static bool gOwnsProfiler = false;
+#endif
+std::mutex gTempAllocatorMutex;
 static std::unique_ptr<Factory> gFactory;
 
+// Pin the calling thread to a single CPU (no-op on platforms without thread affinity)
+static void PinCurrentThread(int cpu)
+{
+#ifdef __linux__
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(cpu, &set);
+	pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+	(void)cpu;
+#endif
+}
+
 int JoltInit()
 {
+	JoltInitSettings settings;
+	settings.numThreads = -1;
+	settings.maxJobs = cMaxPhysicsJobs;
+	settings.maxBarriers = cMaxPhysicsBarriers;
+	settings.tempAllocatorSize = 10 * 1024 * 1024;
+	settings.singleThreaded = 0;
+	settings.cpuAffinity = nullptr;
+	settings.numCpuAffinity = 0;
+	settings.enableProfiler = 0;
+	return JoltInitWithSettings(&settings);
+}
+
+int JoltInitWithSettings(const JoltInitSettings* settings)
+{
+	if (settings->maxJobs == 0 || settings->maxBarriers == 0 || settings->tempAllocatorSize == 0)
+	{
+		return 0;
+	}
+
 	Trace = TraceImpl;
 	JPH_IF_ENABLE_ASSERTS(AssertFailed = AssertFailedImpl;)
 
@@ -50,9 +98,42 @@ int JoltInit()
 	Factory::sInstance = gFactory.get();
 	RegisterTypes();
 
-	gTempAllocator = std::make_unique<TempAllocatorImpl>(10 * 1024 * 1024);
-	gJobSystem = std::make_unique<JobSystemThreadPool>(cMaxPhysicsJobs, cMaxPhysicsBarriers,
-													   std::thread::hardware_concurrency() - 1);
+	gTempAllocator = std::make_unique<TempAllocatorImpl>(settings->tempAllocatorSize);
+
+#ifdef JPH_PROFILE_ENABLED
+	// Only on request: every registered thread gets a sample buffer and every profile scope records a sample.
+	// Created before the job system so its worker threads register themselves (see stats.h).
+	if (settings->enableProfiler != 0 && Profiler::sInstance == nullptr)
+	{
+		JPH_PROFILE_START("Main");
+		gOwnsProfiler = true;
+	}
+#endif
+
+	if (settings->singleThreaded != 0)
+	{
+		// Tiny worlds: handing jobs to other threads costs more than it saves
+		gJobSystem = std::make_unique<JobSystemSingleThreaded>(settings->maxJobs);
+		return 1;
+	}
+
+	int numThreads = settings->numThreads;
+	if (numThreads < 0)
+	{
+		numThreads = std::max(static_cast<int>(std::thread::hardware_concurrency()) - 1, 0);
+	}
+
+	auto pool = std::make_unique<JobSystemThreadPool>();
+	if (settings->cpuAffinity != nullptr && settings->numCpuAffinity > 0)
+	{
+		// Must be set before the worker threads are started by Init
+		std::vector<int> cpus(settings->cpuAffinity, settings->cpuAffinity + settings->numCpuAffinity);
+		pool->SetThreadInitFunction([cpus](int threadIndex) {
+			PinCurrentThread(cpus[static_cast<size_t>(threadIndex) % cpus.size()]);
+		});
+	}
+	pool->Init(settings->maxJobs, settings->maxBarriers, numThreads);
+	gJobSystem = std::move(pool);
 
 	return 1;
 }
@@ -61,6 +142,80 @@ void JoltShutdown()
 {
 	gJobSystem.reset();
 	gTempAllocator.reset();
+
+#ifdef JPH_PROFILE_ENABLED
+	if (gOwnsProfiler)
+	{
+		JPH_PROFILE_END();
+		gOwnsProfiler = false;
+	}
+#endif
+
+	// Unregister so a later JoltInit can register the types again
+	if (Factory::sInstance != nullptr)
+	{
+		UnregisterTypes();
+	}
 	gFactory.reset();
 	Factory::sInstance = nullptr;
 }
+
+int JoltIsDoublePrecision()
+{
+#ifdef JPH_DOUBLE_PRECISION
+	return 1;
+#else
+	return 0;
+#endif
+}
+
+void RunParallelBatches(JobSystem* jobSystem, int count, int minBatchSize,
+                        BatchFunction work, const void* context)
+{
+	if (count <= 0)
+	{
+		return;
+	}
+
+	int numBatches = 1;
+	if (jobSystem != nullptr)
+	{
+		int maxBatches = (count + std::max(minBatchSize, 1) - 1) / std::max(minBatchSize, 1);
+		numBatches = std::min(jobSystem->GetMaxConcurrency(), maxBatches);
+	}
+
+	if (numBatches <= 1)
+	{
+		work(context, 0, count);
+		return;
+	}
+
+	int batchSize = (count + numBatches - 1) / numBatches;
+
+	// Jobs capture a single pointer and their range, small enough for the JobFunction to store inline
+	struct Batch
+	{
+		BatchFunction work;
+		const void* context;
+	};
+	const Batch batch = { work, context };
+	const Batch* batchPtr = &batch;
+
+	// Every concurrent wait needs a barrier; when all are taken by other callers, run on this thread instead
+	JobSystem::Barrier* barrier = jobSystem->CreateBarrier();
+	if (barrier == nullptr)
+	{
+		work(context, 0, count);
+		return;
+	}
+
+	for (int begin = 0; begin < count; begin += batchSize)
+	{
+		int end = std::min(begin + batchSize, count);
+		JobSystem::JobHandle job = jobSystem->CreateJob("WrapperBatch", Color::sGreen,
+			[batchPtr, begin, end]() { batchPtr->work(batchPtr->context, begin, end); });
+		barrier->AddJob(job);
+	}
+	jobSystem->WaitForJobs(barrier);
+	jobSystem->DestroyBarrier(barrier);
+}
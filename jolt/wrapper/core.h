@@ -11,26 +11,69 @@
 extern "C" {
 #endif
 
+// Options for the shared resources created by JoltInitWithSettings
+typedef struct {
+    int numThreads;                 // Worker threads in the shared pool (-1 = one less than the number of CPUs)
+    unsigned int maxJobs;           // Max number of jobs that can be in flight
+    unsigned int maxBarriers;       // Max number of barriers (concurrent waits on the job system)
+    unsigned int tempAllocatorSize; // Bytes of scratch memory in the shared temp allocator
+    int singleThreaded;             // bool as int: run all jobs on the calling thread (no worker threads)
+    const int* cpuAffinity;         // Optional CPU list: worker i is pinned to cpuAffinity[i % numCpuAffinity] (Linux only)
+    int numCpuAffinity;             // Number of entries in cpuAffinity (0 = no pinning)
+    int enableProfiler;             // bool as int: start Jolt's profiler so JoltPhysicsSystemProfileNextUpdate can dump updates
+} JoltInitSettings;
+
 // Initialize Jolt Physics (call once at startup)
 // Returns 1 on success, 0 on failure
 int JoltInit();
 
+// Initialize Jolt Physics with explicit job system and allocator options (call once at startup, instead of JoltInit)
+// Returns 1 on success, 0 on failure
+int JoltInitWithSettings(const JoltInitSettings* settings);
+
 // Shutdown Jolt Physics (call once at exit)
 void JoltShutdown();
 
+// Returns 1 if the library was built with JPH_DOUBLE_PRECISION (positions are stored as doubles), 0 otherwise
+int JoltIsDoublePrecision();
+
 #ifdef __cplusplus
 }
 
 // C++ only: Access to global resources
 #include <memory>
+#include <mutex>
 
 namespace JPH {
     class TempAllocatorImpl;
-    class JobSystemThreadPool;
+    class JobSystem;
 }
 
 extern std::unique_ptr<JPH::TempAllocatorImpl> gTempAllocator;
-extern std::unique_ptr<JPH::JobSystemThreadPool> gJobSystem;
+extern std::unique_ptr<JPH::JobSystem> gJobSystem;  // JobSystemThreadPool, or JobSystemSingleThreaded
+
+// TempAllocatorImpl is not thread safe: hold this while using gTempAllocator
+extern std::mutex gTempAllocatorMutex;
+
+// Batch callback for RunParallelBatches: context is the pointer passed along with it
+typedef void (*BatchFunction)(const void* context, int begin, int end);
+
+// Split [0, count) into at most one range per worker thread (each at least minBatchSize long)
+// and run work(context, begin, end) for every range on the job system. Blocks until all ranges are done;
+// the calling thread helps execute them. Runs inline when the work doesn't warrant splitting.
+// Allocates nothing: jobs and barriers come from the job system's preallocated pools.
+void RunParallelBatches(JPH::JobSystem* jobSystem, int count, int minBatchSize,
+                        BatchFunction work, const void* context);
+
+// RunParallelBatches for a callable taking (begin, end), usually a [&] lambda. The callable is passed
+// by pointer rather than wrapped in a std::function, which would allocate for larger captures.
+template <class Work>
+inline void RunParallelBatches(JPH::JobSystem* jobSystem, int count, int minBatchSize, const Work& work)
+{
+    RunParallelBatches(jobSystem, count, minBatchSize,
+        [](const void* context, int begin, int end) { (*static_cast<const Work*>(context))(begin, end); },
+        &work);
+}
 
 #endif
 
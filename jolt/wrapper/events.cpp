@@ -0,0 +1,251 @@
+/*
+ * Jolt Physics C Wrapper - Contact and Activation Events Implementation
+ *
+ * Listener callbacks run on Jolt's job threads, so recording an event must be
+ * lock-free. Each event claims a slot by bumping an atomic write counter and
+ * then publishes the slot's sequence number, so the reader (which runs between
+ * updates) can tell which slots hold the event it expects.
+ */
+
+#include "events.h"
+#include "physics.h"
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/PhysicsSystem.h>
+#include <Jolt/Physics/Body/Body.h>
+#include <Jolt/Physics/Body/BodyActivationListener.h>
+#include <Jolt/Physics/Collision/ContactListener.h>
+#include <atomic>
+#include <algorithm>
+#include <memory>
+#include <cstdint>
+
+using namespace JPH;
+
+class EventRecorder final : public ContactListener, public BodyActivationListener
+{
+public:
+	EventRecorder(unsigned int capacity, unsigned int mask, int overflowPolicy)
+		: m_slots(new Slot[capacity]), m_capacity(capacity), m_mask(mask),
+		  m_overwrite(overflowPolicy == JoltEventOverflowOverwrite) {}
+
+	// ContactListener
+	virtual void OnContactAdded(const Body& inBody1, const Body& inBody2,
+								const ContactManifold& inManifold, ContactSettings& ioSettings) override
+	{
+		RecordContact(JoltContactEventAdded, inBody1, inBody2, inManifold);
+	}
+
+	virtual void OnContactPersisted(const Body& inBody1, const Body& inBody2,
+									const ContactManifold& inManifold, ContactSettings& ioSettings) override
+	{
+		RecordContact(JoltContactEventPersisted, inBody1, inBody2, inManifold);
+	}
+
+	virtual void OnContactRemoved(const SubShapeIDPair& inSubShapePair) override
+	{
+		if (!IsEnabled(JoltContactEventRemoved))
+		{
+			return;
+		}
+
+		JoltContactEvent event = {};
+		event.type = JoltContactEventRemoved;
+		event.bodyID1 = inSubShapePair.GetBody1ID().GetIndexAndSequenceNumber();
+		event.bodyID2 = inSubShapePair.GetBody2ID().GetIndexAndSequenceNumber();
+		Push(event);
+	}
+
+	// BodyActivationListener
+	virtual void OnBodyActivated(const BodyID& inBodyID, uint64 inBodyUserData) override
+	{
+		RecordActivation(JoltContactEventActivated, inBodyID);
+	}
+
+	virtual void OnBodyDeactivated(const BodyID& inBodyID, uint64 inBodyUserData) override
+	{
+		RecordActivation(JoltContactEventDeactivated, inBodyID);
+	}
+
+	// Copy completed events to outEvents, oldest first (single reader)
+	int Drain(JoltContactEvent* outEvents, int maxEvents, unsigned long long* outDropped)
+	{
+		uint64_t head = m_head.load(std::memory_order_acquire);
+		uint64_t read = m_tail;
+
+		// In overwrite mode anything older than the last capacity events is gone
+		if (head - read > m_capacity)
+		{
+			m_dropped.fetch_add(head - m_capacity - read, std::memory_order_relaxed);
+			read = head - m_capacity;
+		}
+
+		int numEvents = 0;
+		while (read < head && numEvents < maxEvents)
+		{
+			// A slot that doesn't hold this exact index was lapped by a newer event, or its writer found the
+			// slot busy and gave up (overwrite mode); either way the event at this index was lost
+			const Slot& slot = m_slots[read % m_capacity];
+			if (slot.seq.load(std::memory_order_acquire) == read + 1)
+			{
+				outEvents[numEvents++] = slot.event;
+			}
+			else
+			{
+				m_dropped.fetch_add(1, std::memory_order_relaxed);
+			}
+			read++;
+		}
+		m_tail = read;
+
+		// Publish the read position for the drop-newest capacity check
+		m_published_tail.store(read, std::memory_order_release);
+
+		if (outDropped)
+		{
+			*outDropped = m_dropped.exchange(0, std::memory_order_relaxed);
+		}
+		return numEvents;
+	}
+
+private:
+	struct Slot
+	{
+		std::atomic<uint64_t> seq{0};      // Write index + 1 of the event in this slot (0 = never written)
+		std::atomic<bool> busy{false};     // Set while a writer owns the slot (overwrite mode)
+		JoltContactEvent event;
+	};
+
+	bool IsEnabled(JoltContactEventType type) const
+	{
+		return (m_mask & JOLT_EVENT_MASK(type)) != 0;
+	}
+
+	void RecordContact(JoltContactEventType type, const Body& inBody1, const Body& inBody2, const ContactManifold& inManifold)
+	{
+		if (!IsEnabled(type))
+		{
+			return;
+		}
+
+		JoltContactEvent event;
+		event.type = type;
+		event.bodyID1 = inBody1.GetID().GetIndexAndSequenceNumber();
+		event.bodyID2 = inBody2.GetID().GetIndexAndSequenceNumber();
+
+		RVec3 point = inManifold.mRelativeContactPointsOn1.empty()
+			? inManifold.mBaseOffset : inManifold.GetWorldSpaceContactPointOn1(0);
+		event.contactPointX = static_cast<float>(point.GetX());
+		event.contactPointY = static_cast<float>(point.GetY());
+		event.contactPointZ = static_cast<float>(point.GetZ());
+
+		event.normalX = inManifold.mWorldSpaceNormal.GetX();
+		event.normalY = inManifold.mWorldSpaceNormal.GetY();
+		event.normalZ = inManifold.mWorldSpaceNormal.GetZ();
+		event.penetrationDepth = inManifold.mPenetrationDepth;
+		Push(event);
+	}
+
+	void RecordActivation(JoltContactEventType type, const BodyID& inBodyID)
+	{
+		if (!IsEnabled(type))
+		{
+			return;
+		}
+
+		JoltContactEvent event = {};
+		event.type = type;
+		event.bodyID1 = inBodyID.GetIndexAndSequenceNumber();
+		event.bodyID2 = BodyID::cInvalidBodyID;
+		Push(event);
+	}
+
+	void Push(const JoltContactEvent& event)
+	{
+		if (m_overwrite)
+		{
+			PushOverwrite(event);
+		}
+		else
+		{
+			PushDropNewest(event);
+		}
+	}
+
+	// Claim the next index only if the buffer has room, otherwise count the event as dropped
+	void PushDropNewest(const JoltContactEvent& event)
+	{
+		uint64_t index = m_head.load(std::memory_order_relaxed);
+		do
+		{
+			if (index - m_published_tail.load(std::memory_order_acquire) >= m_capacity)
+			{
+				m_dropped.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+		}
+		while (!m_head.compare_exchange_weak(index, index + 1, std::memory_order_acq_rel, std::memory_order_relaxed));
+
+		Slot& slot = m_slots[index % m_capacity];
+		slot.event = event;
+		slot.seq.store(index + 1, std::memory_order_release);
+	}
+
+	// Always claim the next index; if the slot is still owned by a writer one lap behind, this event is
+	// dropped (the reader counts it, since the slot won't carry this index)
+	void PushOverwrite(const JoltContactEvent& event)
+	{
+		uint64_t index = m_head.fetch_add(1, std::memory_order_acq_rel);
+
+		Slot& slot = m_slots[index % m_capacity];
+		if (slot.busy.exchange(true, std::memory_order_acquire))
+		{
+			return;
+		}
+
+		slot.event = event;
+		slot.seq.store(index + 1, std::memory_order_release);
+		slot.busy.store(false, std::memory_order_release);
+	}
+
+	std::unique_ptr<Slot[]> m_slots;
+	uint64_t m_capacity;
+	unsigned int m_mask;
+	bool m_overwrite;
+
+	std::atomic<uint64_t> m_head{0};            // Number of indices claimed by writers
+	uint64_t m_tail = 0;                        // Next index to read (reader only)
+	std::atomic<uint64_t> m_published_tail{0};  // Copy of m_tail visible to writers
+	std::atomic<uint64_t> m_dropped{0};         // Events lost since the last drain
+};
+
+EventRecorder* CreateEventRecorder(PhysicsSystem* system, unsigned int capacity, unsigned int mask, int overflowPolicy)
+{
+	auto recorder = std::make_unique<EventRecorder>(capacity, mask, overflowPolicy);
+	system->SetContactListener(recorder.get());
+	system->SetBodyActivationListener(recorder.get());
+	return recorder.release();
+}
+
+void DestroyEventRecorder(EventRecorder* recorder)
+{
+	delete recorder;
+}
+
+int JoltPhysicsSystemDrainEvents(JoltPhysicsSystem system,
+								 JoltContactEvent* outEvents, int maxEvents,
+								 unsigned long long* outDropped)
+{
+	PhysicsSystemWrapper* wrapper = static_cast<PhysicsSystemWrapper*>(system);
+	EventRecorder* recorder = GetEventRecorder(wrapper);
+
+	if (recorder == nullptr || maxEvents < 0)
+	{
+		if (outDropped)
+		{
+			*outDropped = 0;
+		}
+		return 0;
+	}
+
+	return recorder->Drain(outEvents, maxEvents, outDropped);
+}
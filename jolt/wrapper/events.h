@@ -0,0 +1,87 @@
+/*
+ * Jolt Physics C Wrapper - Contact and Activation Events
+ *
+ * Records contact and body activation events into a preallocated ring buffer
+ * so they can be read in bulk once per update instead of via per-event callbacks.
+ */
+
+#ifndef JOLT_WRAPPER_EVENTS_H
+#define JOLT_WRAPPER_EVENTS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Opaque pointer types (defined in other headers)
+typedef void* JoltPhysicsSystem;
+typedef unsigned int JoltBodyID;   // Packed index/sequence number, see body.h
+
+// Event type enum
+typedef enum {
+    JoltContactEventAdded = 0,        // Two bodies started touching
+    JoltContactEventPersisted = 1,    // Two bodies are still touching (reported every update, off by default)
+    JoltContactEventRemoved = 2,      // Two bodies stopped touching
+    JoltContactEventActivated = 3,    // A body woke up
+    JoltContactEventDeactivated = 4   // A body went to sleep
+} JoltContactEventType;
+
+// Event mask bits (one per event type), used for JoltPhysicsSystemSettings::eventMask
+#define JOLT_EVENT_MASK(type) (1u << (type))
+#define JOLT_EVENT_MASK_DEFAULT (JOLT_EVENT_MASK(JoltContactEventAdded) | JOLT_EVENT_MASK(JoltContactEventRemoved) | \
+                                 JOLT_EVENT_MASK(JoltContactEventActivated) | JOLT_EVENT_MASK(JoltContactEventDeactivated))
+
+// What to do when the buffer is full
+typedef enum {
+    JoltEventOverflowDropNewest = 0,  // Keep the oldest events, discard new ones until the buffer is drained
+    JoltEventOverflowOverwrite = 1    // Keep the newest events, overwriting the oldest ones
+} JoltEventOverflowPolicy;
+
+// Event structure
+// Contact events are reported per sub shape pair, so compound bodies can produce several events per body pair
+typedef struct {
+    int type;                 // JoltContactEventType
+    JoltBodyID bodyID1;       // First body (the only body for activation events)
+    JoltBodyID bodyID2;       // Second body (JOLT_INVALID_BODY_ID for activation events)
+    float contactPointX;      // First contact point on body 1 in world space (added/persisted only)
+    float contactPointY;
+    float contactPointZ;
+    float normalX;            // Contact normal in world space, pointing from body 1 to body 2 (added/persisted only)
+    float normalY;
+    float normalZ;
+    float penetrationDepth;   // Penetration depth (added/persisted only)
+} JoltContactEvent;
+
+// Copy the events recorded since the last call into outEvents, oldest first
+// Events are recorded only if the system was created with eventCapacity > 0
+// Must not be called concurrently with JoltPhysicsSystemUpdate or with body changes on this system
+// If more than maxEvents events are pending, the rest are returned by the next call
+// outDropped: receives the number of events lost to overflow since the last call (can be NULL)
+// Returns: number of events written to outEvents
+int JoltPhysicsSystemDrainEvents(JoltPhysicsSystem system,
+                                 JoltContactEvent* outEvents, int maxEvents,
+                                 unsigned long long* outDropped);
+
+#ifdef __cplusplus
+}
+
+// C++ only: Event recorder owned by the physics system wrapper (see physics.cpp)
+namespace JPH {
+    class PhysicsSystem;
+}
+
+class EventRecorder;  // Opaque forward declaration
+
+// Create a recorder with room for capacity events and install it as the system's contact and activation listener
+EventRecorder* CreateEventRecorder(JPH::PhysicsSystem* system, unsigned int capacity, unsigned int mask, int overflowPolicy);
+
+// Destroy a recorder (the physics system must be destroyed first, or its listeners cleared)
+void DestroyEventRecorder(EventRecorder* recorder);
+
+struct EventRecorderDeleter
+{
+    void operator()(EventRecorder* recorder) const { DestroyEventRecorder(recorder); }
+};
+
+#endif
+
+#endif // JOLT_WRAPPER_EVENTS_H
@@ -0,0 +1,72 @@
+/*
+ * Jolt Physics C Wrapper - Collision Layer Table Implementation
+ */
+
+#include "layers.h"
+
+using namespace JPH;
+
+bool LayerTable::Init(const JoltPhysicsSystemSettings& settings)
+{
+	if (settings.numObjectLayers == 0)
+	{
+		// Default table: static bodies only collide with moving ones, moving bodies collide with everything
+		m_num_object_layers = 2;
+		m_num_broad_phase_layers = 2;
+		m_collision_masks[JOLT_OBJECT_LAYER_NON_MOVING] = 1u << JOLT_OBJECT_LAYER_MOVING;
+		m_collision_masks[JOLT_OBJECT_LAYER_MOVING] = (1u << JOLT_OBJECT_LAYER_NON_MOVING) | (1u << JOLT_OBJECT_LAYER_MOVING);
+		m_broad_phase_layers[JOLT_OBJECT_LAYER_NON_MOVING] = 0;
+		m_broad_phase_layers[JOLT_OBJECT_LAYER_MOVING] = 1;
+	}
+	else
+	{
+		if (settings.numObjectLayers > JOLT_MAX_OBJECT_LAYERS
+			|| settings.numBroadPhaseLayers == 0 || settings.numBroadPhaseLayers > JOLT_MAX_BROADPHASE_LAYERS)
+		{
+			return false;
+		}
+
+		m_num_object_layers = settings.numObjectLayers;
+		m_num_broad_phase_layers = settings.numBroadPhaseLayers;
+
+		for (uint i = 0; i < m_num_object_layers; i++)
+		{
+			if (settings.objectToBroadPhaseLayer[i] >= m_num_broad_phase_layers)
+			{
+				return false;
+			}
+			m_broad_phase_layers[i] = settings.objectToBroadPhaseLayer[i];
+
+			// A pair collides only if both layers list each other, so the matrix is symmetric
+			// (Jolt may test a pair in either order)
+			uint32 mask = 0;
+			for (uint j = 0; j < m_num_object_layers; j++)
+			{
+				if ((settings.objectLayerMasks[i] & (1u << j)) != 0 && (settings.objectLayerMasks[j] & (1u << i)) != 0)
+				{
+					mask |= 1u << j;
+				}
+			}
+			m_collision_masks[i] = mask;
+		}
+	}
+
+	for (uint i = 0; i < m_num_object_layers; i++)
+	{
+		m_broad_phase_masks[i] = GetBroadPhaseMask(m_collision_masks[i]);
+	}
+	return true;
+}
+
+uint32 LayerTable::GetBroadPhaseMask(uint32 objectLayerMask) const
+{
+	uint32 mask = 0;
+	for (uint i = 0; i < m_num_object_layers; i++)
+	{
+		if ((objectLayerMask & (1u << i)) != 0)
+		{
+			mask |= 1u << m_broad_phase_layers[i];
+		}
+	}
+	return mask;
+}
@@ -0,0 +1,92 @@
+/*
+ * Jolt Physics C Wrapper - Collision Layer Table (C++ only)
+ *
+ * Holds the object layer collision matrix and the object to broadphase layer
+ * mapping of a physics system. The physics system's layer interfaces, query
+ * filters and character filters are all answered from this table.
+ */
+
+#ifndef JOLT_WRAPPER_LAYERS_H
+#define JOLT_WRAPPER_LAYERS_H
+
+#include "physics.h"
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/Collision/ObjectLayer.h>
+#include <Jolt/Physics/Collision/BroadPhase/BroadPhaseLayer.h>
+
+class LayerTable
+{
+public:
+	// Build the table from the settings (numObjectLayers = 0 builds the default table)
+	// Returns false if the settings describe an invalid table
+	bool Init(const JoltPhysicsSystemSettings& settings);
+
+	JPH::uint GetNumObjectLayers() const { return m_num_object_layers; }
+	JPH::uint GetNumBroadPhaseLayers() const { return m_num_broad_phase_layers; }
+
+	bool IsValid(JPH::ObjectLayer inLayer) const { return inLayer < m_num_object_layers; }
+
+	// Layers outside the table collide with nothing
+	bool ShouldCollide(JPH::ObjectLayer inLayer1, JPH::ObjectLayer inLayer2) const
+	{
+		return IsValid(inLayer1) && IsValid(inLayer2) && (m_collision_masks[inLayer1] & (1u << inLayer2)) != 0;
+	}
+
+	bool ShouldCollide(JPH::ObjectLayer inLayer1, JPH::BroadPhaseLayer inLayer2) const
+	{
+		return IsValid(inLayer1) && (m_broad_phase_masks[inLayer1] & (1u << inLayer2.GetValue())) != 0;
+	}
+
+	// Bodies in layers outside the table are kept in broadphase layer 0 (where nothing collides with them)
+	JPH::BroadPhaseLayer GetBroadPhaseLayer(JPH::ObjectLayer inLayer) const
+	{
+		return JPH::BroadPhaseLayer(IsValid(inLayer) ? m_broad_phase_layers[inLayer] : 0);
+	}
+
+	// Broadphase layers that hold at least one of the object layers in objectLayerMask
+	JPH::uint32 GetBroadPhaseMask(JPH::uint32 objectLayerMask) const;
+
+private:
+	JPH::uint m_num_object_layers = 0;
+	JPH::uint m_num_broad_phase_layers = 0;
+	JPH::uint32 m_collision_masks[JOLT_MAX_OBJECT_LAYERS] = {};     // Symmetric object layer matrix
+	JPH::uint32 m_broad_phase_masks[JOLT_MAX_OBJECT_LAYERS] = {};   // Broadphase layers each object layer collides with
+	JPH::uint8 m_broad_phase_layers[JOLT_MAX_OBJECT_LAYERS] = {};
+};
+
+// Query filter: accepts the object layers in a mask
+class ObjectLayerMaskFilter final : public JPH::ObjectLayerFilter
+{
+public:
+	explicit ObjectLayerMaskFilter(JPH::uint32 mask) : m_mask(mask) {}
+
+	virtual bool ShouldCollide(JPH::ObjectLayer inLayer) const override
+	{
+		return inLayer < JOLT_MAX_OBJECT_LAYERS && (m_mask & (1u << inLayer)) != 0;
+	}
+
+private:
+	JPH::uint32 m_mask;
+};
+
+// Query filter: accepts the broadphase layers holding any object layer of a mask, so the trees of
+// layers that can't match are skipped entirely
+class BroadPhaseLayerMaskFilter final : public JPH::BroadPhaseLayerFilter
+{
+public:
+	BroadPhaseLayerMaskFilter(const LayerTable& table, JPH::uint32 objectLayerMask)
+		: m_mask(table.GetBroadPhaseMask(objectLayerMask)) {}
+
+	virtual bool ShouldCollide(JPH::BroadPhaseLayer inLayer) const override
+	{
+		return (m_mask & (1u << inLayer.GetValue())) != 0;
+	}
+
+private:
+	JPH::uint32 m_mask;
+};
+
+// Layer table of a physics system (see physics.cpp)
+const LayerTable& GetLayerTable(PhysicsSystemWrapper* wrapper);
+
+#endif // JOLT_WRAPPER_LAYERS_H
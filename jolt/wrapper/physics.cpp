@@ -8,141 +8,248 @@
 
 #include "physics.h"
 #include "core.h"
+#include "events.h"
+#include "layers.h"
+#include "stats.h"
 #include <Jolt/Jolt.h>
 #include <Jolt/Core/TempAllocator.h>
 #include <Jolt/Core/JobSystemThreadPool.h>
 #include <Jolt/Physics/PhysicsSettings.h>
 #include <Jolt/Physics/PhysicsSystem.h>
+#include <Jolt/Physics/Body/BodyID.h>
 #include <memory>
+#include <mutex>
+#include <algorithm>
+#include <cmath>
+#include <iterator>
 
 using namespace JPH;
 
-// Collision layers: NON_MOVING (static) and MOVING (dynamic)
-namespace Layers
-{
-	static constexpr ObjectLayer NON_MOVING = 0;
-	static constexpr ObjectLayer MOVING = 1;
-
-	static constexpr ObjectLayer NUM_LAYERS = 2;
-};
-
-namespace BroadPhaseLayers
-{
-	static constexpr BroadPhaseLayer NON_MOVING(0);
-	static constexpr BroadPhaseLayer MOVING(1);
-
-	static constexpr uint NUM_LAYERS(2);
-};
+static_assert(JOLT_UPDATE_ERROR_MANIFOLD_CACHE_FULL == static_cast<int>(EPhysicsUpdateError::ManifoldCacheFull), "EPhysicsUpdateError mismatch");
+static_assert(JOLT_UPDATE_ERROR_BODY_PAIR_CACHE_FULL == static_cast<int>(EPhysicsUpdateError::BodyPairCacheFull), "EPhysicsUpdateError mismatch");
+static_assert(JOLT_UPDATE_ERROR_CONTACT_CONSTRAINTS_FULL == static_cast<int>(EPhysicsUpdateError::ContactConstraintsFull), "EPhysicsUpdateError mismatch");
 
 // Maps object layers to broad phase layers
 class BPLayerInterfaceImpl final : public BroadPhaseLayerInterface
 {
 public:
-	BPLayerInterfaceImpl()
-	{
-		mObjectToBroadPhase[Layers::NON_MOVING] = BroadPhaseLayers::NON_MOVING;
-		mObjectToBroadPhase[Layers::MOVING] = BroadPhaseLayers::MOVING;
-	}
+	explicit BPLayerInterfaceImpl(const LayerTable& table) : m_table(table) {}
 
 	virtual uint GetNumBroadPhaseLayers() const override
 	{
-		return BroadPhaseLayers::NUM_LAYERS;
+		return m_table.GetNumBroadPhaseLayers();
 	}
 
 	virtual BroadPhaseLayer GetBroadPhaseLayer(ObjectLayer inLayer) const override
 	{
-		JPH_ASSERT(inLayer < Layers::NUM_LAYERS);
-		return mObjectToBroadPhase[inLayer];
+		JPH_ASSERT(m_table.IsValid(inLayer));
+		return m_table.GetBroadPhaseLayer(inLayer);
 	}
 
 #if defined(JPH_EXTERNAL_PROFILE) || defined(JPH_PROFILE_ENABLED)
 	virtual const char* GetBroadPhaseLayerName(BroadPhaseLayer inLayer) const override
 	{
-		switch ((BroadPhaseLayer::Type)inLayer)
-		{
-		case (BroadPhaseLayer::Type)BroadPhaseLayers::NON_MOVING:	return "NON_MOVING";
-		case (BroadPhaseLayer::Type)BroadPhaseLayers::MOVING:		return "MOVING";
-		default:													return "INVALID";
-		}
+		static const char* names[JOLT_MAX_BROADPHASE_LAYERS] = { "BP0", "BP1", "BP2", "BP3", "BP4", "BP5", "BP6", "BP7" };
+		return (uint)inLayer.GetValue() < m_table.GetNumBroadPhaseLayers() ? names[inLayer.GetValue()] : "INVALID";
 	}
 #endif // JPH_EXTERNAL_PROFILE || JPH_PROFILE_ENABLED
 
 private:
-	BroadPhaseLayer mObjectToBroadPhase[Layers::NUM_LAYERS];
+	const LayerTable& m_table;
 };
 
 // Filters which broad phase layers can collide
 class ObjectVsBroadPhaseLayerFilterImpl : public ObjectVsBroadPhaseLayerFilter
 {
 public:
+	explicit ObjectVsBroadPhaseLayerFilterImpl(const LayerTable& table) : m_table(table) {}
+
 	virtual bool ShouldCollide(ObjectLayer inLayer1, BroadPhaseLayer inLayer2) const override
 	{
-		switch (inLayer1)
-		{
-		case Layers::NON_MOVING:
-			return inLayer2 == BroadPhaseLayers::MOVING;
-		case Layers::MOVING:
-			return true;
-		default:
-			JPH_ASSERT(false);
-			return false;
-		}
+		return m_table.ShouldCollide(inLayer1, inLayer2);
 	}
+
+private:
+	const LayerTable& m_table;
 };
 
 // Filters which object layers can collide with each other
 class ObjectLayerPairFilterImpl : public ObjectLayerPairFilter
 {
 public:
+	explicit ObjectLayerPairFilterImpl(const LayerTable& table) : m_table(table) {}
+
 	virtual bool ShouldCollide(ObjectLayer inObject1, ObjectLayer inObject2) const override
 	{
-		switch (inObject1)
-		{
-		case Layers::NON_MOVING:
-			return inObject2 == Layers::MOVING;
-		case Layers::MOVING:
-			return true;
-		default:
-			JPH_ASSERT(false);
-			return false;
-		}
+		return m_table.ShouldCollide(inObject1, inObject2);
 	}
+
+private:
+	const LayerTable& m_table;
 };
 
 // Wrapper to keep layer interfaces alive (PhysicsSystem stores references to them)
 struct PhysicsSystemWrapper
 {
+	// Declared first so it outlives the system, which calls into it until destroyed
+	std::unique_ptr<EventRecorder, EventRecorderDeleter> events;
+
+	// Step statistics (its contact listener forwards to the event recorder, so it sits between the two)
+	StatsState stats;
+
+	// Referenced by the layer interfaces below
+	LayerTable layers;
+
 	std::unique_ptr<PhysicsSystem> system;
 	std::unique_ptr<BPLayerInterfaceImpl> broad_phase_layer_interface;
 	std::unique_ptr<ObjectVsBroadPhaseLayerFilterImpl> object_vs_broadphase_layer_filter;
 	std::unique_ptr<ObjectLayerPairFilterImpl> object_vs_object_layer_filter;
 
+	// Optional per-world resources (null = use the shared ones from core.cpp)
+	std::unique_ptr<TempAllocatorImpl> temp_allocator;
+	std::unique_ptr<JobSystemThreadPool> job_system;
+
+	// Guards temp_allocator: characters of this world can be updated from several goroutines at once
+	std::mutex temp_allocator_mutex;
+
 	~PhysicsSystemWrapper() = default;
 };
 
-JoltPhysicsSystem JoltCreatePhysicsSystem()
+// Default cap on the steps one JoltPhysicsSystemStepFixed call runs
+static constexpr int cDefaultMaxFixedSteps = 8;
+
+// Default settings used by JoltCreatePhysicsSystem
+static JoltPhysicsSystemSettings DefaultPhysicsSystemSettings()
 {
 	// ref: https://github.com/godotengine/godot/blob/e47fb8b8989fd5589c65c4b0ac980de2e936c041/modules/jolt_physics/jolt_project_settings.cpp#L71
-	const uint cMaxBodies = 10240;
-	const uint cNumBodyMutexes = 0;
-	const uint cMaxBodyPairs = 65536;
-	const uint cMaxContactConstraints = 20480;
+	JoltPhysicsSystemSettings settings;
+	settings.maxBodies = 10240;
+	settings.numBodyMutexes = 0;
+	settings.maxBodyPairs = 65536;
+	settings.maxContactConstraints = 20480;
+
+	Vec3 gravity(0, -9.81f, 0);  // Jolt's default gravity
+	settings.gravityX = gravity.GetX();
+	settings.gravityY = gravity.GetY();
+	settings.gravityZ = gravity.GetZ();
+
+	// Jolt's PhysicsSettings defaults
+	PhysicsSettings defaults;
+	settings.numVelocitySteps = defaults.mNumVelocitySteps;
+	settings.numPositionSteps = defaults.mNumPositionSteps;
+	settings.baumgarte = defaults.mBaumgarte;
+	settings.speculativeContactDistance = defaults.mSpeculativeContactDistance;
+	settings.penetrationSlop = defaults.mPenetrationSlop;
+	settings.linearCastThreshold = defaults.mLinearCastThreshold;
+	settings.linearCastMaxPenetration = defaults.mLinearCastMaxPenetration;
+	settings.maxPenetrationDistance = defaults.mMaxPenetrationDistance;
+	settings.minVelocityForRestitution = defaults.mMinVelocityForRestitution;
+	settings.constraintWarmStart = defaults.mConstraintWarmStart ? 1 : 0;
+	settings.useBodyPairContactCache = defaults.mUseBodyPairContactCache ? 1 : 0;
+	settings.useLargeIslandSplitter = defaults.mUseLargeIslandSplitter ? 1 : 0;
+	settings.deterministicSimulation = defaults.mDeterministicSimulation ? 1 : 0;
+	settings.allowSleeping = defaults.mAllowSleeping ? 1 : 0;
+	settings.timeBeforeSleep = defaults.mTimeBeforeSleep;
+	settings.pointVelocitySleepThreshold = defaults.mPointVelocitySleepThreshold;
+
+	settings.tempAllocatorSize = 0;
+	settings.jobThreads = 0;
+
+	settings.eventCapacity = 0;
+	settings.eventMask = JOLT_EVENT_MASK_DEFAULT;
+	settings.eventOverflowPolicy = JoltEventOverflowDropNewest;
+
+	// Default NON_MOVING/MOVING layer table
+	settings.numObjectLayers = 0;
+	settings.numBroadPhaseLayers = 0;
+	std::fill(std::begin(settings.objectLayerMasks), std::end(settings.objectLayerMasks), 0u);
+	std::fill(std::begin(settings.objectToBroadPhaseLayer), std::end(settings.objectToBroadPhaseLayer), 0);
+	return settings;
+}
+
+JoltPhysicsSystem JoltCreatePhysicsSystem()
+{
+	JoltPhysicsSystemSettings settings = DefaultPhysicsSystemSettings();
+	return JoltCreatePhysicsSystemWithSettings(&settings);
+}
+
+void JoltPhysicsSystemDefaultSettings(JoltPhysicsSystemSettings* outSettings)
+{
+	*outSettings = DefaultPhysicsSystemSettings();
+}
+
+JoltPhysicsSystem JoltCreatePhysicsSystemWithSettings(const JoltPhysicsSystemSettings* settings)
+{
+	// Reject capacities Jolt would assert on
+	if (settings->maxBodies == 0 || settings->maxBodies > BodyID::cMaxBodyIndex + 1
+		|| settings->maxBodyPairs == 0 || settings->maxContactConstraints == 0)
+	{
+		return nullptr;
+	}
 
 	// Create wrapper to hold PhysicsSystem and layer interfaces
 	auto wrapper = std::make_unique<PhysicsSystemWrapper>();
+	if (!wrapper->layers.Init(*settings))
+	{
+		return nullptr;
+	}
 
 	// Create layer interfaces using smart pointers
-	wrapper->broad_phase_layer_interface = std::make_unique<BPLayerInterfaceImpl>();
-	wrapper->object_vs_broadphase_layer_filter = std::make_unique<ObjectVsBroadPhaseLayerFilterImpl>();
-	wrapper->object_vs_object_layer_filter = std::make_unique<ObjectLayerPairFilterImpl>();
+	wrapper->broad_phase_layer_interface = std::make_unique<BPLayerInterfaceImpl>(wrapper->layers);
+	wrapper->object_vs_broadphase_layer_filter = std::make_unique<ObjectVsBroadPhaseLayerFilterImpl>(wrapper->layers);
+	wrapper->object_vs_object_layer_filter = std::make_unique<ObjectLayerPairFilterImpl>(wrapper->layers);
 
 	// Create physics system
 	wrapper->system = std::make_unique<PhysicsSystem>();
-	wrapper->system->Init(cMaxBodies, cNumBodyMutexes, cMaxBodyPairs, cMaxContactConstraints,
+	wrapper->system->Init(settings->maxBodies, settings->numBodyMutexes,
+						  settings->maxBodyPairs, settings->maxContactConstraints,
 						  *wrapper->broad_phase_layer_interface,
 						  *wrapper->object_vs_broadphase_layer_filter,
 						  *wrapper->object_vs_object_layer_filter);
 
+	wrapper->stats.maxBodyPairs = static_cast<int>(settings->maxBodyPairs);
+	wrapper->stats.maxContactConstraints = static_cast<int>(settings->maxContactConstraints);
+
+	wrapper->system->SetGravity(Vec3(settings->gravityX, settings->gravityY, settings->gravityZ));
+
+	// Solver and sleep settings (everything not exposed keeps Jolt's default)
+	PhysicsSettings physicsSettings;
+	physicsSettings.mNumVelocitySteps = settings->numVelocitySteps;
+	physicsSettings.mNumPositionSteps = settings->numPositionSteps;
+	physicsSettings.mBaumgarte = settings->baumgarte;
+	physicsSettings.mSpeculativeContactDistance = settings->speculativeContactDistance;
+	physicsSettings.mPenetrationSlop = settings->penetrationSlop;
+	physicsSettings.mLinearCastThreshold = settings->linearCastThreshold;
+	physicsSettings.mLinearCastMaxPenetration = settings->linearCastMaxPenetration;
+	physicsSettings.mMaxPenetrationDistance = settings->maxPenetrationDistance;
+	physicsSettings.mMinVelocityForRestitution = settings->minVelocityForRestitution;
+	physicsSettings.mConstraintWarmStart = settings->constraintWarmStart != 0;
+	physicsSettings.mUseBodyPairContactCache = settings->useBodyPairContactCache != 0;
+	physicsSettings.mUseLargeIslandSplitter = settings->useLargeIslandSplitter != 0;
+	physicsSettings.mDeterministicSimulation = settings->deterministicSimulation != 0;
+	physicsSettings.mAllowSleeping = settings->allowSleeping != 0;
+	physicsSettings.mTimeBeforeSleep = settings->timeBeforeSleep;
+	physicsSettings.mPointVelocitySleepThreshold = settings->pointVelocitySleepThreshold;
+	wrapper->system->SetPhysicsSettings(physicsSettings);
+
+	// Dedicated resources let this world be stepped independently of the others
+	if (settings->tempAllocatorSize > 0)
+	{
+		wrapper->temp_allocator = std::make_unique<TempAllocatorImpl>(settings->tempAllocatorSize);
+	}
+	if (settings->jobThreads > 0)
+	{
+		wrapper->job_system = std::make_unique<JobSystemThreadPool>(cMaxPhysicsJobs, cMaxPhysicsBarriers,
+																	static_cast<int>(settings->jobThreads));
+	}
+
+	// Record contact and activation events for bulk draining
+	if (settings->eventCapacity > 0)
+	{
+		wrapper->events.reset(CreateEventRecorder(wrapper->system.get(), settings->eventCapacity,
+												  settings->eventMask, settings->eventOverflowPolicy));
+	}
+
 	// Release ownership to caller (Go will manage lifetime via JoltDestroyPhysicsSystem)
 	return static_cast<JoltPhysicsSystem>(wrapper.release());
 }
@@ -154,9 +261,69 @@ void JoltDestroyPhysicsSystem(JoltPhysicsSystem system)
 }
 
 void JoltPhysicsSystemUpdate(JoltPhysicsSystem system, float deltaTime)
+{
+	JoltPhysicsSystemUpdateWithCollisionSteps(system, deltaTime, 1);
+}
+
+int JoltPhysicsSystemUpdateWithCollisionSteps(JoltPhysicsSystem system, float deltaTime, int collisionSteps)
+{
+	PhysicsSystemWrapper *wrapper = static_cast<PhysicsSystemWrapper *>(system);
+	auto allocatorLock = LockTempAllocator(wrapper);
+	EPhysicsUpdateError errors = UpdateWithStats(wrapper, deltaTime, std::max(collisionSteps, 1));
+	return static_cast<int>(errors);
+}
+
+int JoltPhysicsSystemStepFixed(JoltPhysicsSystem system,
+							   double elapsed, float fixedDeltaTime, int collisionSteps, int maxSteps,
+							   double* ioAccumulator, float* outAlpha, int* outErrors)
 {
 	PhysicsSystemWrapper *wrapper = static_cast<PhysicsSystemWrapper *>(system);
-	wrapper->system->Update(deltaTime, 1, gTempAllocator.get(), gJobSystem.get());
+
+	int numSteps = 0;
+	int errors = 0;
+	double accumulator = *ioAccumulator + std::max(elapsed, 0.0);
+
+	// An unset cap means the default, not "never step"
+	if (maxSteps <= 0)
+	{
+		maxSteps = cDefaultMaxFixedSteps;
+	}
+
+	if (fixedDeltaTime > 0.0f)
+	{
+		// Take the allocator lock once for all steps
+		auto allocatorLock = LockTempAllocator(wrapper);
+		while (accumulator >= fixedDeltaTime && numSteps < maxSteps)
+		{
+			EPhysicsUpdateError stepErrors = UpdateWithStats(wrapper, fixedDeltaTime, std::max(collisionSteps, 1));
+			errors |= static_cast<int>(stepErrors);
+			accumulator -= fixedDeltaTime;
+			numSteps++;
+		}
+
+		// Fell too far behind: drop the whole steps we didn't run but keep the phase
+		if (accumulator >= fixedDeltaTime)
+		{
+			accumulator = std::fmod(accumulator, static_cast<double>(fixedDeltaTime));
+		}
+	}
+
+	*ioAccumulator = accumulator;
+	if (outAlpha)
+	{
+		*outAlpha = fixedDeltaTime > 0.0f ? static_cast<float>(accumulator / fixedDeltaTime) : 0.0f;
+	}
+	if (outErrors)
+	{
+		*outErrors = errors;
+	}
+	return numSteps;
+}
+
+void JoltPhysicsSystemOptimizeBroadPhase(JoltPhysicsSystem system)
+{
+	PhysicsSystemWrapper *wrapper = static_cast<PhysicsSystemWrapper *>(system);
+	wrapper->system->OptimizeBroadPhase();
 }
 
 // C++ only: Accessor functions for wrapper internals
@@ -174,3 +341,45 @@ const ObjectLayerPairFilter* GetObjectLayerPairFilter(PhysicsSystemWrapper* wrap
 {
 	return wrapper->object_vs_object_layer_filter.get();
 }
+
+const LayerTable& GetLayerTable(PhysicsSystemWrapper* wrapper)
+{
+	return wrapper->layers;
+}
+
+TempAllocator* GetTempAllocator(PhysicsSystemWrapper* wrapper)
+{
+	if (wrapper->temp_allocator)
+	{
+		return wrapper->temp_allocator.get();
+	}
+	return gTempAllocator.get();
+}
+
+JobSystem* GetJobSystem(PhysicsSystemWrapper* wrapper)
+{
+	if (wrapper->job_system)
+	{
+		return wrapper->job_system.get();
+	}
+	return gJobSystem.get();
+}
+
+std::unique_lock<std::mutex> LockTempAllocator(PhysicsSystemWrapper* wrapper)
+{
+	if (wrapper->temp_allocator)
+	{
+		return std::unique_lock<std::mutex>(wrapper->temp_allocator_mutex);
+	}
+	return std::unique_lock<std::mutex>(gTempAllocatorMutex);
+}
+
+EventRecorder* GetEventRecorder(PhysicsSystemWrapper* wrapper)
+{
+	return wrapper->events.get();
+}
+
+StatsState& GetStatsState(PhysicsSystemWrapper* wrapper)
+{
+	return wrapper->stats;
+}
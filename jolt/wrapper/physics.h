@@ -14,32 +14,144 @@ extern "C" {
 // Opaque pointer types
 typedef void* JoltPhysicsSystem;
 
-// Create a new physics world
+// Collision layers
+// Every body lives in one object layer; each object layer is assigned to a broadphase layer (one broadphase
+// tree per broadphase layer), so queries and bodies that can't collide with a layer skip its whole tree
+#define JOLT_MAX_OBJECT_LAYERS 32
+#define JOLT_MAX_BROADPHASE_LAYERS 8
+#define JOLT_ALL_OBJECT_LAYERS 0xffffffffu
+
+// Object layers of the default layer table (static bodies and everything that moves)
+#define JOLT_OBJECT_LAYER_NON_MOVING 0
+#define JOLT_OBJECT_LAYER_MOVING 1
+
+// Physics system settings structure (capacity limits plus a subset of Jolt's PhysicsSettings)
+typedef struct {
+    // Capacity (fixed for the lifetime of the system)
+    unsigned int maxBodies;              // Max number of bodies in the system
+    unsigned int numBodyMutexes;         // Number of body mutexes (0 = pick a default based on CPU count)
+    unsigned int maxBodyPairs;           // Max number of body pairs processed by the broadphase per update
+    unsigned int maxContactConstraints;  // Max number of contact constraints per update
+
+    float gravityX, gravityY, gravityZ;
+
+    // Solver
+    unsigned int numVelocitySteps;       // Velocity solver iterations
+    unsigned int numPositionSteps;       // Position solver iterations
+    float baumgarte;                     // Fraction of position error fixed per step [0, 1]
+    float speculativeContactDistance;    // Radius around objects inside which speculative contacts are detected
+    float penetrationSlop;               // How much bodies are allowed to sink into each other
+    float linearCastThreshold;           // Fraction of inner radius a body must move per step to enable CCD
+    float linearCastMaxPenetration;      // Fraction of inner radius a body may penetrate when using CCD
+    float maxPenetrationDistance;        // Max distance the position solver corrects for per step
+    float minVelocityForRestitution;     // Min velocity needed before restitution is applied
+    int constraintWarmStart;             // bool as int: warm start constraints with the previous frame's impulses
+    int useBodyPairContactCache;         // bool as int: reuse contacts of body pairs that barely moved
+    int useLargeIslandSplitter;          // bool as int: split large islands so they solve in parallel
+    int deterministicSimulation;         // bool as int: keep the simulation deterministic (costs some performance)
+
+    // Sleeping
+    int allowSleeping;                   // bool as int
+    float timeBeforeSleep;               // Seconds a body must be nearly motionless before it goes to sleep
+    float pointVelocitySleepThreshold;   // Velocity of body points below which a body may go to sleep
+
+    // Per-world resources
+    unsigned int tempAllocatorSize;      // Bytes of scratch memory owned by this world (0 = use the shared allocator)
+    unsigned int jobThreads;             // Worker threads owned by this world (0 = use the shared thread pool)
+
+    // Contact and activation events (see events.h)
+    unsigned int eventCapacity;          // Size of the event ring buffer (0 = don't record events)
+    unsigned int eventMask;              // JOLT_EVENT_MASK bits of the event types to record
+    int eventOverflowPolicy;             // JoltEventOverflowPolicy
+
+    // Collision layers (numObjectLayers = 0 uses the default table: NON_MOVING collides with MOVING only,
+    // MOVING collides with everything, each in its own broadphase layer)
+    unsigned int numObjectLayers;                                   // Number of object layers [1, JOLT_MAX_OBJECT_LAYERS]
+    unsigned int numBroadPhaseLayers;                               // Number of broadphase layers [1, JOLT_MAX_BROADPHASE_LAYERS]
+    unsigned int objectLayerMasks[JOLT_MAX_OBJECT_LAYERS];          // Bit j of entry i: layer i may collide with layer j (both layers must agree)
+    unsigned char objectToBroadPhaseLayer[JOLT_MAX_OBJECT_LAYERS];  // Broadphase layer of each object layer
+} JoltPhysicsSystemSettings;
+
+// Fill settings with the defaults used by JoltCreatePhysicsSystem: the wrapper's default capacity and
+// Jolt's PhysicsSettings defaults for the solver
+void JoltPhysicsSystemDefaultSettings(JoltPhysicsSystemSettings* outSettings);
+
+// Create a new physics world with default settings
 JoltPhysicsSystem JoltCreatePhysicsSystem();
 
+// Create a new physics world with the given settings
+// Returns NULL if the settings are invalid (e.g. maxBodies is 0 or exceeds Jolt's limit, or an object layer
+// maps to a broadphase layer that doesn't exist)
+JoltPhysicsSystem JoltCreatePhysicsSystemWithSettings(const JoltPhysicsSystemSettings* settings);
+
 // Destroy a physics world
 void JoltDestroyPhysicsSystem(JoltPhysicsSystem system);
 
 // Step the physics simulation by deltaTime seconds
+// Worlds that own their temp allocator (tempAllocatorSize > 0) can be updated concurrently from
+// different threads; worlds using the shared allocator are updated one at a time.
 void JoltPhysicsSystemUpdate(JoltPhysicsSystem system, float deltaTime);
 
+// Update error flags (matches Jolt's EPhysicsUpdateError)
+#define JOLT_UPDATE_ERROR_MANIFOLD_CACHE_FULL       (1 << 0)  // Contact manifolds were dropped, increase maxContactConstraints
+#define JOLT_UPDATE_ERROR_BODY_PAIR_CACHE_FULL      (1 << 1)  // Body pairs were dropped, increase maxBodyPairs
+#define JOLT_UPDATE_ERROR_CONTACT_CONSTRAINTS_FULL  (1 << 2)  // Contact constraints were dropped, increase maxContactConstraints
+
+// Step the physics simulation by deltaTime seconds, split into collisionSteps collision steps
+// Use more collision steps for fast moving objects at low update rates (each step costs roughly a full update)
+// Returns: bitmask of JOLT_UPDATE_ERROR_* flags (0 if the update succeeded without dropping anything)
+int JoltPhysicsSystemUpdateWithCollisionSteps(JoltPhysicsSystem system, float deltaTime, int collisionSteps);
+
+// Advance a fixed timestep accumulator by elapsed seconds and run the whole steps that fit, in one call
+// fixedDeltaTime: duration of one step
+// collisionSteps: collision steps per step (see JoltPhysicsSystemUpdateWithCollisionSteps)
+// maxSteps: cap on the number of steps run; leftover whole steps are dropped so slow frames can't snowball
+//           (<= 0 uses the default of 8)
+// ioAccumulator: time not yet simulated, carried between calls (start at 0)
+// outAlpha: fraction of a step left in the accumulator [0, 1), for interpolating rendered state (can be NULL)
+// outErrors: combined JOLT_UPDATE_ERROR_* flags of the steps that were run (can be NULL)
+// Returns: number of steps run
+int JoltPhysicsSystemStepFixed(JoltPhysicsSystem system,
+                               double elapsed, float fixedDeltaTime, int collisionSteps, int maxSteps,
+                               double* ioAccumulator, float* outAlpha, int* outErrors);
+
+// Rebuild the broadphase trees for optimal query performance
+// Call after adding many bodies (e.g. after loading a level); this is an expensive operation
+void JoltPhysicsSystemOptimizeBroadPhase(JoltPhysicsSystem system);
+
 #ifdef __cplusplus
 }
 
 // C++ only: Accessor functions for wrapper internals (used by character.cpp)
+#include <mutex>
+
 namespace JPH {
     class PhysicsSystem;
     class ObjectVsBroadPhaseLayerFilter;
     class ObjectLayerPairFilter;
+    class TempAllocator;
+    class JobSystem;
 }
 
 struct PhysicsSystemWrapper;  // Opaque forward declaration
+class EventRecorder;          // See events.h
 
 // Accessor functions
 JPH::PhysicsSystem* GetPhysicsSystem(PhysicsSystemWrapper* wrapper);
 const JPH::ObjectVsBroadPhaseLayerFilter* GetObjectVsBroadPhaseLayerFilter(PhysicsSystemWrapper* wrapper);
 const JPH::ObjectLayerPairFilter* GetObjectLayerPairFilter(PhysicsSystemWrapper* wrapper);
 
+// Temp allocator and job system for work on this world (its own if configured, otherwise the shared ones)
+// The allocator may only be used while holding the lock returned by LockTempAllocator
+JPH::TempAllocator* GetTempAllocator(PhysicsSystemWrapper* wrapper);
+JPH::JobSystem* GetJobSystem(PhysicsSystemWrapper* wrapper);
+
+// Lock the temp allocator of this world (the world's own one, or the shared one)
+std::unique_lock<std::mutex> LockTempAllocator(PhysicsSystemWrapper* wrapper);
+
+// Contact and activation event recorder (null if the world doesn't record events)
+EventRecorder* GetEventRecorder(PhysicsSystemWrapper* wrapper);
+
 #endif
 
 #endif // JOLT_WRAPPER_PHYSICS_H
@@ -3,60 +3,105 @@
  */
 
 #include "query.h"
+#include "body.h"
 #include "physics.h"
+#include "core.h"
+#include "layers.h"
 #include <Jolt/Jolt.h>
 #include <Jolt/Physics/PhysicsSystem.h>
 #include <Jolt/Physics/Collision/CollideShape.h>
 #include <Jolt/Physics/Collision/CollisionCollectorImpl.h>
 #include <Jolt/Physics/Collision/NarrowPhaseQuery.h>
 #include <Jolt/Physics/Collision/RayCast.h>
+#include <Jolt/Physics/Collision/ShapeCast.h>
 #include <Jolt/Physics/Collision/CastResult.h>
+#include <Jolt/Physics/Collision/BroadPhase/BroadPhaseQuery.h>
+#include <Jolt/Geometry/AABox.h>
+#include <Jolt/Physics/Body/Body.h>
+#include <Jolt/Physics/Body/BodyFilter.h>
 #include <Jolt/Physics/Body/BodyID.h>
 #include <Jolt/Physics/Body/BodyLockInterface.h>
 #include <vector>
 #include <algorithm>
+#include <atomic>
 
 using namespace JPH;
 
-// Collision layers (defined in physics.cpp)
-namespace Layers
-{
-	static constexpr ObjectLayer MOVING = 1;
-};
+// Smallest number of rays handed to a single job when a batch is split across worker threads
+static constexpr int cMinRaysPerBatch = 64;
+
+// Smallest number of shape casts handed to a single job (each cast costs far more than a ray)
+static constexpr int cMinShapeCastsPerBatch = 8;
 
-// Adapter: converts ObjectVsBroadPhaseLayerFilter to BroadPhaseLayerFilter for queries
-class BroadPhaseLayerFilterAdapter : public BroadPhaseLayerFilter
+// Smallest number of broadphase regions handed to a single job
+static constexpr int cMinRegionsPerBatch = 16;
+
+// Body filter for query options: skips the ignored bodies and, optionally, sensors
+class QueryBodyFilter final : public BodyFilter
 {
 public:
-	BroadPhaseLayerFilterAdapter(const ObjectVsBroadPhaseLayerFilter* filter, ObjectLayer layer)
-		: m_filter(filter), m_object_layer(layer) {}
+	explicit QueryBodyFilter(const JoltQueryOptions* options)
+	{
+		if (options != nullptr)
+		{
+			m_ignored = reinterpret_cast<const BodyID*>(options->ignoredBodies);
+			m_num_ignored = m_ignored != nullptr ? std::max(options->numIgnoredBodies, 0) : 0;
+			m_ignore_sensors = options->ignoreSensors != 0;
+		}
+	}
+
+	// Called before the body is locked, so ignored bodies are rejected without touching them
+	virtual bool ShouldCollide(const BodyID& inBodyID) const override
+	{
+		return std::find(m_ignored, m_ignored + m_num_ignored, inBodyID) == m_ignored + m_num_ignored;
+	}
 
-	virtual bool ShouldCollide(BroadPhaseLayer inLayer) const override
+	virtual bool ShouldCollideLocked(const Body& inBody) const override
 	{
-		return m_filter->ShouldCollide(m_object_layer, inLayer);
+		return !(m_ignore_sensors && inBody.IsSensor());
 	}
 
+	// ShouldCollideLocked only needs to be called when sensors are filtered
+	bool NeedsLockedTest() const { return m_ignore_sensors; }
+
 private:
-	const ObjectVsBroadPhaseLayerFilter* m_filter;
-	ObjectLayer m_object_layer;
+	const BodyID* m_ignored = nullptr;
+	int m_num_ignored = 0;
+	bool m_ignore_sensors = false;
 };
 
-// Adapter: converts ObjectLayerPairFilter to ObjectLayerFilter for queries
-class ObjectLayerFilterAdapter : public ObjectLayerFilter
+// All filters of a query, built from its options (NULL options hit every body)
+// The filters are stateless, so one set can be shared by every worker thread of a batch
+struct QueryFilters
 {
-public:
-	ObjectLayerFilterAdapter(const ObjectLayerPairFilter* filter, ObjectLayer layer)
-		: m_filter(filter), m_object_layer(layer) {}
+	QueryFilters(PhysicsSystemWrapper* wrapper, const JoltQueryOptions* options)
+		: layerMask(options != nullptr && options->objectLayerMask != 0 ? options->objectLayerMask : JOLT_ALL_OBJECT_LAYERS),
+		  broadPhase(GetLayerTable(wrapper), layerMask),
+		  objectLayer(layerMask),
+		  body(options),
+		  anyHit(options != nullptr && options->anyHit != 0),
+		  noLock(options != nullptr && options->noLock != 0) {}
+
+	uint32 layerMask;
+	BroadPhaseLayerMaskFilter broadPhase;  // Skips broadphase trees without any of the requested layers
+	ObjectLayerMaskFilter objectLayer;
+	QueryBodyFilter body;
+	bool anyHit;
+	bool noLock;
+};
 
-	virtual bool ShouldCollide(ObjectLayer inLayer) const override
-	{
-		return m_filter->ShouldCollide(m_object_layer, inLayer);
-	}
+// Narrow phase query and body lock interfaces for a query: the locking ones, or with noLock the ones that
+// read bodies without taking their locks (the caller guarantees that nothing modifies or updates the world)
+static const NarrowPhaseQuery& GetNarrowPhaseQuery(const PhysicsSystem* ps, const QueryFilters& filters)
+{
+	return filters.noLock ? ps->GetNarrowPhaseQueryNoLock() : ps->GetNarrowPhaseQuery();
+}
 
-private:
-	const ObjectLayerPairFilter* m_filter;
-	ObjectLayer m_object_layer;
-};
+static const BodyLockInterface& GetBodyLockInterface(const PhysicsSystem* ps, const QueryFilters& filters)
+{
+	return filters.noLock ? static_cast<const BodyLockInterface&>(ps->GetBodyLockInterfaceNoLock())
+						  : static_cast<const BodyLockInterface&>(ps->GetBodyLockInterface());
+}
 
 // Collector that just checks if any collision occurred
 class AnyHitCollector : public CollideShapeCollector
@@ -67,6 +112,9 @@ public:
 	virtual void AddHit(const CollideShapeResult& inResult) override
 	{
 		m_hasHit = true;
+
+		// The answer is known, stop the traversal
+		ForceEarlyOut();
 	}
 
 	bool HasHit() const { return m_hasHit; }
@@ -76,56 +124,62 @@ private:
 };
 
 // Collector that stores all collision hits
+// Contact points are relative to the base offset of the query, which is added back when storing them
+template <class Hit>
 class AllHitsCollector : public CollideShapeCollector
 {
 public:
-	AllHitsCollector(JoltCollisionHit* outHits, int maxHits)
-		: m_outHits(outHits), m_maxHits(maxHits), m_numHits(0) {}
+	AllHitsCollector(RVec3Arg baseOffset, Hit* outHits, int maxHits)
+		: m_baseOffset(baseOffset), m_outHits(outHits), m_maxHits(maxHits), m_numHits(0) {}
 
 	virtual void AddHit(const CollideShapeResult& inResult) override
 	{
 		if (m_numHits < m_maxHits)
 		{
-			JoltCollisionHit& hit = m_outHits[m_numHits];
+			Hit& hit = m_outHits[m_numHits];
 
 			// Store body ID
-			BodyID* bodyIDCopy = new BodyID(inResult.mBodyID2);
-			hit.bodyID = static_cast<JoltBodyID>(bodyIDCopy);
+			hit.bodyID = inResult.mBodyID2.GetIndexAndSequenceNumber();
 
 			// Store contact point (using contact point on second shape)
-			Vec3 contactPoint = inResult.mContactPointOn2;
-			hit.contactPointX = contactPoint.GetX();
-			hit.contactPointY = contactPoint.GetY();
-			hit.contactPointZ = contactPoint.GetZ();
+			RVec3 contactPoint = m_baseOffset + inResult.mContactPointOn2;
+			hit.contactPointX = static_cast<decltype(hit.contactPointX)>(contactPoint.GetX());
+			hit.contactPointY = static_cast<decltype(hit.contactPointY)>(contactPoint.GetY());
+			hit.contactPointZ = static_cast<decltype(hit.contactPointZ)>(contactPoint.GetZ());
 
 			// Store penetration depth
 			hit.penetrationDepth = inResult.mPenetrationDepth;
 
 			m_numHits++;
 		}
+
+		// Output buffer is full, no point in looking for more hits
+		if (m_numHits >= m_maxHits)
+		{
+			ForceEarlyOut();
+		}
 	}
 
 	int GetNumHits() const { return m_numHits; }
 
 private:
-	JoltCollisionHit* m_outHits;
+	RVec3 m_baseOffset;
+	Hit* m_outHits;
 	int m_maxHits;
 	int m_numHits;
 };
 
 int JoltCollideShape(JoltPhysicsSystem system, JoltShape shape,
-                     float posX, float posY, float posZ, float penetrationTolerance)
+                     double posX, double posY, double posZ, float penetrationTolerance,
+                     const JoltQueryOptions* options)
 {
 	PhysicsSystemWrapper* wrapper = static_cast<PhysicsSystemWrapper*>(system);
 	PhysicsSystem* ps = GetPhysicsSystem(wrapper);
 	const Shape* s = static_cast<const Shape*>(shape);
 
-	// Get narrow phase query interface
-	const NarrowPhaseQuery& query = ps->GetNarrowPhaseQuery();
-
-	// Create filter adapters (query shape acts as MOVING layer)
-	BroadPhaseLayerFilterAdapter bpFilter(GetObjectVsBroadPhaseLayerFilter(wrapper), Layers::MOVING);
-	ObjectLayerFilterAdapter objFilter(GetObjectLayerPairFilter(wrapper), Layers::MOVING);
+	// Filters from the query options (applied during the traversal)
+	QueryFilters filters(wrapper, options);
+	const NarrowPhaseQuery& query = GetNarrowPhaseQuery(ps, filters);
 
 	// Create collector to check for any hit
 	AnyHitCollector collector;
@@ -138,34 +192,40 @@ int JoltCollideShape(JoltPhysicsSystem system, JoltShape shape,
 	query.CollideShape(
 		s,
 		Vec3::sReplicate(1.0f),  // Scale
-		RMat44::sTranslation(RVec3(posX, posY, posZ)),  // Transform (position, no rotation)
+		RMat44::sTranslation(RVec3(Real(posX), Real(posY), Real(posZ))),  // Transform (position, no rotation)
 		settings,
 		RVec3::sZero(),  // Base offset
 		collector,
-		bpFilter,
-		objFilter
+		filters.broadPhase,
+		filters.objectLayer,
+		filters.body
 	);
 
 	return collector.HasHit() ? 1 : 0;
 }
 
-int JoltCollideShapeGetHits(JoltPhysicsSystem system, JoltShape shape,
-                            float posX, float posY, float posZ,
-                            JoltCollisionHit* outHits, int maxHits, float penetrationTolerance)
+// Collide a shape at a position and store its hits in a JoltCollisionHit or JoltCollisionHit64 buffer
+template <class Hit>
+static int CollideShapeGetHits(JoltPhysicsSystem system, JoltShape shape, RVec3Arg position,
+							   Hit* outHits, int maxHits, float penetrationTolerance,
+							   const JoltQueryOptions* options)
 {
 	PhysicsSystemWrapper* wrapper = static_cast<PhysicsSystemWrapper*>(system);
 	PhysicsSystem* ps = GetPhysicsSystem(wrapper);
 	const Shape* s = static_cast<const Shape*>(shape);
 
-	// Get narrow phase query interface
-	const NarrowPhaseQuery& query = ps->GetNarrowPhaseQuery();
+	// Filters from the query options (applied during the traversal)
+	QueryFilters filters(wrapper, options);
+	const NarrowPhaseQuery& query = GetNarrowPhaseQuery(ps, filters);
 
-	// Create filter adapters (query shape acts as MOVING layer)
-	BroadPhaseLayerFilterAdapter bpFilter(GetObjectVsBroadPhaseLayerFilter(wrapper), Layers::MOVING);
-	ObjectLayerFilterAdapter objFilter(GetObjectLayerPairFilter(wrapper), Layers::MOVING);
+	if (maxHits <= 0)
+	{
+		return 0;
+	}
 
 	// Create collector to gather all hits
-	AllHitsCollector collector(outHits, maxHits);
+	// The query position is the base offset, so contact points keep their precision far from the origin
+	AllHitsCollector<Hit> collector(position, outHits, maxHits);
 
 	// Setup collision settings
 	CollideShapeSettings settings;
@@ -175,78 +235,85 @@ int JoltCollideShapeGetHits(JoltPhysicsSystem system, JoltShape shape,
 	query.CollideShape(
 		s,
 		Vec3::sReplicate(1.0f),  // Scale
-		RMat44::sTranslation(RVec3(posX, posY, posZ)),  // Transform (position, no rotation)
+		RMat44::sTranslation(position),  // Transform (position, no rotation)
 		settings,
-		RVec3::sZero(),  // Base offset
+		position,  // Base offset
 		collector,
-		bpFilter,
-		objFilter
+		filters.broadPhase,
+		filters.objectLayer,
+		filters.body
 	);
 
 	return collector.GetNumHits();
 }
 
-// Raycast: Closest hit collector
-class ClosestRayHitCollector : public CastRayCollector
+int JoltCollideShapeGetHits(JoltPhysicsSystem system, JoltShape shape,
+                            double posX, double posY, double posZ,
+                            JoltCollisionHit* outHits, int maxHits, float penetrationTolerance,
+                            const JoltQueryOptions* options)
 {
-public:
-	ClosestRayHitCollector() : m_hasHit(false), m_closestFraction(1.0f) {}
-
-	virtual void AddHit(const RayCastResult& inResult) override
-	{
-		if (inResult.mFraction < m_closestFraction)
-		{
-			m_hasHit = true;
-			m_closestFraction = inResult.mFraction;
-			m_closestHit = inResult;
-		}
-	}
-
-	bool HasHit() const { return m_hasHit; }
-	const RayCastResult& GetClosestHit() const { return m_closestHit; }
+	return CollideShapeGetHits(system, shape, RVec3(Real(posX), Real(posY), Real(posZ)),
+							   outHits, maxHits, penetrationTolerance, options);
+}
 
-private:
-	bool m_hasHit;
-	float m_closestFraction;
-	RayCastResult m_closestHit;
-};
+int JoltCollideShapeGetHits64(JoltPhysicsSystem system, JoltShape shape,
+                              double posX, double posY, double posZ,
+                              JoltCollisionHit64* outHits, int maxHits, float penetrationTolerance,
+                              const JoltQueryOptions* options)
+{
+	return CollideShapeGetHits(system, shape, RVec3(Real(posX), Real(posY), Real(posZ)),
+							   outHits, maxHits, penetrationTolerance, options);
+}
 
 // Raycast: All hits collector
+// Keeps the closest maxHits results in a max-heap on fraction so that, once full, the traversal
+// can be pruned beyond the furthest hit kept. Results are gathered in a caller-provided buffer
+// that is reused between queries to avoid a heap allocation per raycast.
 class AllRayHitsCollector : public CastRayCollector
 {
 public:
-	AllRayHitsCollector(JoltRaycastHit* outHits, int maxHits)
-		: m_outHits(outHits), m_maxHits(maxHits), m_numHits(0) {}
+	AllRayHitsCollector(std::vector<RayCastResult>& hitBuffer, JoltRaycastHit* outHits, int maxHits)
+		: m_hits(hitBuffer), m_outHits(outHits), m_maxHits(maxHits), m_numHits(0)
+	{
+		m_hits.clear();
+	}
 
 	virtual void AddHit(const RayCastResult& inResult) override
 	{
-		if (m_numHits < m_maxHits)
+		if (static_cast<int>(m_hits.size()) < m_maxHits)
 		{
 			m_hits.push_back(inResult);
+			std::push_heap(m_hits.begin(), m_hits.end(), sCompareFraction);
+		}
+		else if (inResult.mFraction < m_hits.front().mFraction)
+		{
+			// Replace the furthest hit kept
+			std::pop_heap(m_hits.begin(), m_hits.end(), sCompareFraction);
+			m_hits.back() = inResult;
+			std::push_heap(m_hits.begin(), m_hits.end(), sCompareFraction);
+		}
+
+		// Once full, anything further than the furthest hit kept can be skipped
+		if (static_cast<int>(m_hits.size()) == m_maxHits)
+		{
+			UpdateEarlyOutFraction(m_hits.front().mFraction);
 		}
 	}
 
-	void Finalize(const RRayCast& ray, PhysicsSystem* ps)
+	void Finalize(const RRayCast& ray, const BodyLockInterface& bodyLock)
 	{
 		// Sort hits by distance (fraction)
-		std::sort(m_hits.begin(), m_hits.end(),
-			[](const RayCastResult& a, const RayCastResult& b) {
-				return a.mFraction < b.mFraction;
-			});
-
-		// Get body lock interface for reading body data
-		const BodyLockInterface& bodyLock = ps->GetBodyLockInterface();
+		std::sort_heap(m_hits.begin(), m_hits.end(), sCompareFraction);
 
 		// Convert to output format
-		int numToReturn = std::min(static_cast<int>(m_hits.size()), m_maxHits);
+		int numToReturn = static_cast<int>(m_hits.size());
 		for (int i = 0; i < numToReturn; i++)
 		{
 			const RayCastResult& result = m_hits[i];
 			JoltRaycastHit& hit = m_outHits[i];
 
 			// Store body ID
-			BodyID* bodyIDCopy = new BodyID(result.mBodyID);
-			hit.bodyID = static_cast<JoltBodyID>(bodyIDCopy);
+			hit.bodyID = result.mBodyID.GetIndexAndSequenceNumber();
 
 			// Calculate hit point
 			RVec3 hitPoint = ray.GetPointOnRay(result.mFraction);
@@ -261,7 +328,7 @@ public:
 				if (lock.Succeeded())
 				{
 					const Body& body = lock.GetBody();
-					normal = body.GetWorldSpaceSurfaceNormal(result.mSubShapeID2, Vec3(ray.GetPointOnRay(result.mFraction)));
+					normal = body.GetWorldSpaceSurfaceNormal(result.mSubShapeID2, hitPoint);
 				}
 			}
 			hit.normalX = normal.GetX();
@@ -277,71 +344,68 @@ public:
 	int GetNumHits() const { return m_numHits; }
 
 private:
+	static bool sCompareFraction(const RayCastResult& a, const RayCastResult& b)
+	{
+		return a.mFraction < b.mFraction;
+	}
+
+	std::vector<RayCastResult>& m_hits;
 	JoltRaycastHit* m_outHits;
 	int m_maxHits;
 	int m_numHits;
-	std::vector<RayCastResult> m_hits;
 };
 
-int JoltCastRay(JoltPhysicsSystem system,
-                float originX, float originY, float originZ,
-                float directionX, float directionY, float directionZ,
-                JoltRaycastHit* outHit)
+// Cast a single ray and store its closest hit (or with anyHit, the first hit found) in outHit
+// (outHit is left untouched on a miss); Hit is JoltRaycastHit or JoltRaycastHit64
+template <class Hit>
+static bool CastSingleRay(PhysicsSystem* ps, const RRayCast& ray, const QueryFilters& filters, Hit* outHit)
 {
-	PhysicsSystemWrapper* wrapper = static_cast<PhysicsSystemWrapper*>(system);
-	PhysicsSystem* ps = GetPhysicsSystem(wrapper);
-
-	// Get narrow phase query interface
-	const NarrowPhaseQuery& query = ps->GetNarrowPhaseQuery();
-
-	// Create the ray
-	RRayCast ray;
-	ray.mOrigin = RVec3(originX, originY, originZ);
-	ray.mDirection = Vec3(directionX, directionY, directionZ);
-
-	// Create filter adapters (ray acts as MOVING layer)
-	BroadPhaseLayerFilterAdapter bpFilter(GetObjectVsBroadPhaseLayerFilter(wrapper), Layers::MOVING);
-	ObjectLayerFilterAdapter objFilter(GetObjectLayerPairFilter(wrapper), Layers::MOVING);
-
-	// Create collector for closest hit
-	ClosestRayHitCollector collector;
-
-	// Create raycast settings
+	const NarrowPhaseQuery& query = GetNarrowPhaseQuery(ps, filters);
 	RayCastSettings settings;
+	RayCastResult result;
 
-	// Perform raycast
-	query.CastRay(
-		ray,
-		settings,
-		collector,
-		bpFilter,
-		objFilter
-	);
-
-	// Store result if hit and outHit is provided
-	if (collector.HasHit() && outHit != nullptr)
+	if (filters.anyHit)
+	{
+		// Any hit collector stops the traversal at the first hit
+		AnyHitCollisionCollector<CastRayCollector> collector;
+		query.CastRay(ray, settings, collector, filters.broadPhase, filters.objectLayer, filters.body);
+		if (!collector.HadHit())
+		{
+			return false;
+		}
+		result = collector.mHit;
+	}
+	else
 	{
-		const RayCastResult& result = collector.GetClosestHit();
+		// Closest hit collector shrinks the early out fraction as hits come in, pruning the traversal
+		ClosestHitCollisionCollector<CastRayCollector> collector;
+		query.CastRay(ray, settings, collector, filters.broadPhase, filters.objectLayer, filters.body);
+		if (!collector.HadHit())
+		{
+			return false;
+		}
+		result = collector.mHit;
+	}
 
+	if (outHit != nullptr)
+	{
 		// Store body ID
-		BodyID* bodyIDCopy = new BodyID(result.mBodyID);
-		outHit->bodyID = static_cast<JoltBodyID>(bodyIDCopy);
+		outHit->bodyID = result.mBodyID.GetIndexAndSequenceNumber();
 
 		// Calculate hit point
 		RVec3 hitPoint = ray.GetPointOnRay(result.mFraction);
-		outHit->hitPointX = static_cast<float>(hitPoint.GetX());
-		outHit->hitPointY = static_cast<float>(hitPoint.GetY());
-		outHit->hitPointZ = static_cast<float>(hitPoint.GetZ());
+		outHit->hitPointX = static_cast<decltype(outHit->hitPointX)>(hitPoint.GetX());
+		outHit->hitPointY = static_cast<decltype(outHit->hitPointY)>(hitPoint.GetY());
+		outHit->hitPointZ = static_cast<decltype(outHit->hitPointZ)>(hitPoint.GetZ());
 
 		// Get surface normal from the body
 		Vec3 normal = Vec3::sZero();
 		{
-			const BodyLockInterface& bodyLock = ps->GetBodyLockInterface();
-			BodyLockRead lock(bodyLock, result.mBodyID);
+			BodyLockRead lock(GetBodyLockInterface(ps, filters), result.mBodyID);
 			if (lock.Succeeded())
 			{
 				const Body& body = lock.GetBody();
-				normal = body.GetWorldSpaceSurfaceNormal(result.mSubShapeID2, Vec3(ray.GetPointOnRay(result.mFraction)));
+				normal = body.GetWorldSpaceSurfaceNormal(result.mSubShapeID2, hitPoint);
 			}
 		}
 		outHit->normalX = normal.GetX();
@@ -352,31 +416,118 @@ int JoltCastRay(JoltPhysicsSystem system,
 		outHit->fraction = result.mFraction;
 	}
 
-	return collector.HasHit() ? 1 : 0;
+	return true;
+}
+
+int JoltCastRay(JoltPhysicsSystem system,
+                double originX, double originY, double originZ,
+                float directionX, float directionY, float directionZ,
+                JoltRaycastHit* outHit, const JoltQueryOptions* options)
+{
+	PhysicsSystemWrapper* wrapper = static_cast<PhysicsSystemWrapper*>(system);
+	PhysicsSystem* ps = GetPhysicsSystem(wrapper);
+
+	// Create the ray
+	RRayCast ray;
+	ray.mOrigin = RVec3(Real(originX), Real(originY), Real(originZ));
+	ray.mDirection = Vec3(directionX, directionY, directionZ);
+
+	// Filters from the query options (applied during the traversal)
+	QueryFilters filters(wrapper, options);
+
+	return CastSingleRay(ps, ray, filters, outHit) ? 1 : 0;
+}
+
+int JoltCastRay64(JoltPhysicsSystem system,
+                  double originX, double originY, double originZ,
+                  float directionX, float directionY, float directionZ,
+                  JoltRaycastHit64* outHit, const JoltQueryOptions* options)
+{
+	PhysicsSystemWrapper* wrapper = static_cast<PhysicsSystemWrapper*>(system);
+	PhysicsSystem* ps = GetPhysicsSystem(wrapper);
+
+	RRayCast ray;
+	ray.mOrigin = RVec3(Real(originX), Real(originY), Real(originZ));
+	ray.mDirection = Vec3(directionX, directionY, directionZ);
+
+	QueryFilters filters(wrapper, options);
+
+	return CastSingleRay(ps, ray, filters, outHit) ? 1 : 0;
+}
+
+int JoltCastRayBatch(JoltPhysicsSystem system,
+                     const float* origins, const float* directions, int numRays,
+                     JoltRaycastHit* outHits, int multithreaded,
+                     const JoltQueryOptions* options)
+{
+	PhysicsSystemWrapper* wrapper = static_cast<PhysicsSystemWrapper*>(system);
+	PhysicsSystem* ps = GetPhysicsSystem(wrapper);
+
+	// One set of filters is shared by every ray (and every worker thread)
+	QueryFilters filters(wrapper, options);
+
+	std::atomic<int> numHits(0);
+
+	auto castRange = [&](int begin, int end)
+	{
+		int rangeHits = 0;
+		for (int i = begin; i < end; i++)
+		{
+			RRayCast ray;
+			ray.mOrigin = RVec3(origins[i * 3], origins[i * 3 + 1], origins[i * 3 + 2]);
+			ray.mDirection = Vec3(directions[i * 3], directions[i * 3 + 1], directions[i * 3 + 2]);
+
+			if (CastSingleRay(ps, ray, filters, &outHits[i]))
+			{
+				rangeHits++;
+			}
+			else
+			{
+				outHits[i] = JoltRaycastHit{};
+				outHits[i].bodyID = BodyID::cInvalidBodyID;
+			}
+		}
+		numHits += rangeHits;
+	};
+
+	if (multithreaded != 0)
+	{
+		RunParallelBatches(GetJobSystem(wrapper), numRays, cMinRaysPerBatch, castRange);
+	}
+	else
+	{
+		castRange(0, numRays);
+	}
+
+	return numHits.load();
 }
 
 int JoltCastRayGetHits(JoltPhysicsSystem system,
-                       float originX, float originY, float originZ,
+                       double originX, double originY, double originZ,
                        float directionX, float directionY, float directionZ,
-                       JoltRaycastHit* outHits, int maxHits)
+                       JoltRaycastHit* outHits, int maxHits,
+                       const JoltQueryOptions* options)
 {
 	PhysicsSystemWrapper* wrapper = static_cast<PhysicsSystemWrapper*>(system);
 	PhysicsSystem* ps = GetPhysicsSystem(wrapper);
 
-	// Get narrow phase query interface
-	const NarrowPhaseQuery& query = ps->GetNarrowPhaseQuery();
-
 	// Create the ray
 	RRayCast ray;
-	ray.mOrigin = RVec3(originX, originY, originZ);
+	ray.mOrigin = RVec3(Real(originX), Real(originY), Real(originZ));
 	ray.mDirection = Vec3(directionX, directionY, directionZ);
 
-	// Create filter adapters (ray acts as MOVING layer)
-	BroadPhaseLayerFilterAdapter bpFilter(GetObjectVsBroadPhaseLayerFilter(wrapper), Layers::MOVING);
-	ObjectLayerFilterAdapter objFilter(GetObjectLayerPairFilter(wrapper), Layers::MOVING);
+	// Filters from the query options (applied during the traversal)
+	QueryFilters filters(wrapper, options);
+	const NarrowPhaseQuery& query = GetNarrowPhaseQuery(ps, filters);
 
-	// Create collector for all hits
-	AllRayHitsCollector collector(outHits, maxHits);
+	if (maxHits <= 0)
+	{
+		return 0;
+	}
+
+	// Create collector for all hits (the hit buffer keeps its capacity between calls on this thread)
+	static thread_local std::vector<RayCastResult> hitBuffer;
+	AllRayHitsCollector collector(hitBuffer, outHits, maxHits);
 
 	// Create raycast settings
 	RayCastSettings settings;
@@ -386,12 +537,403 @@ int JoltCastRayGetHits(JoltPhysicsSystem system,
 		ray,
 		settings,
 		collector,
-		bpFilter,
-		objFilter
+		filters.broadPhase,
+		filters.objectLayer,
+		filters.body
 	);
 
 	// Finalize results (sorts and converts)
-	collector.Finalize(ray, ps);
+	collector.Finalize(ray, GetBodyLockInterface(ps, filters));
 
 	return collector.GetNumHits();
 }
+
+// Convert wrapper shape cast settings to Jolt's
+static ShapeCastSettings ToShapeCastSettings(const JoltShapeCastSettings& in)
+{
+	ShapeCastSettings settings;
+	settings.mCollisionTolerance = in.collisionTolerance;
+	settings.mPenetrationTolerance = in.penetrationTolerance;
+	settings.mBackFaceModeTriangles = in.backFaceModeTriangles != 0 ? EBackFaceMode::CollideWithBackFaces : EBackFaceMode::IgnoreBackFaces;
+	settings.mBackFaceModeConvex = in.backFaceModeConvex != 0 ? EBackFaceMode::CollideWithBackFaces : EBackFaceMode::IgnoreBackFaces;
+	settings.mUseShrunkenShapeAndConvexRadius = in.useShrunkenShapeAndConvexRadius != 0;
+	settings.mReturnDeepestPoint = in.returnDeepestPoint != 0;
+	return settings;
+}
+
+// Build a shape cast from a start transform (Jolt casts from the shape's center of mass)
+static RShapeCast MakeShapeCast(const Shape* shape, RVec3Arg position, QuatArg rotation, Vec3Arg direction)
+{
+	return RShapeCast::sFromWorldTransform(shape, Vec3::sReplicate(1.0f), RMat44::sRotationTranslation(rotation, position), direction);
+}
+
+// Convert a shape cast result (relative to baseOffset) to the output format
+static void ToShapeCastHit(const ShapeCastResult& result, RVec3Arg baseOffset, JoltShapeCastHit& outHit)
+{
+	// Store body ID
+	outHit.bodyID = result.mBodyID2.GetIndexAndSequenceNumber();
+
+	// Contact point on the hit body
+	RVec3 contactPoint = baseOffset + result.mContactPointOn2;
+	outHit.contactPointX = static_cast<float>(contactPoint.GetX());
+	outHit.contactPointY = static_cast<float>(contactPoint.GetY());
+	outHit.contactPointZ = static_cast<float>(contactPoint.GetZ());
+
+	// The penetration axis points from the cast shape into the hit body
+	Vec3 normal = -result.mPenetrationAxis.NormalizedOr(Vec3::sZero());
+	outHit.normalX = normal.GetX();
+	outHit.normalY = normal.GetY();
+	outHit.normalZ = normal.GetZ();
+
+	outHit.fraction = result.mFraction;
+	outHit.penetrationDepth = result.mPenetrationDepth;
+}
+
+// Sweep a single shape and store its closest hit (or with anyHit, the first hit found) in outHit
+// (outHit is left untouched on a miss)
+static bool CastSingleShape(PhysicsSystem* ps, const RShapeCast& cast, const ShapeCastSettings& settings,
+                            RVec3Arg baseOffset, const QueryFilters& filters, JoltShapeCastHit* outHit)
+{
+	const NarrowPhaseQuery& query = GetNarrowPhaseQuery(ps, filters);
+	ShapeCastResult result;
+
+	if (filters.anyHit)
+	{
+		AnyHitCollisionCollector<CastShapeCollector> collector;
+		query.CastShape(cast, settings, baseOffset, collector, filters.broadPhase, filters.objectLayer, filters.body);
+		if (!collector.HadHit())
+		{
+			return false;
+		}
+		result = collector.mHit;
+	}
+	else
+	{
+		// Closest hit collector shrinks the early out fraction as hits come in, pruning the traversal
+		ClosestHitCollisionCollector<CastShapeCollector> collector;
+		query.CastShape(cast, settings, baseOffset, collector, filters.broadPhase, filters.objectLayer, filters.body);
+		if (!collector.HadHit())
+		{
+			return false;
+		}
+		result = collector.mHit;
+	}
+
+	if (outHit != nullptr)
+	{
+		ToShapeCastHit(result, baseOffset, *outHit);
+	}
+	return true;
+}
+
+int JoltCastShape(JoltPhysicsSystem system, JoltShape shape,
+                  double posX, double posY, double posZ,
+                  float rotX, float rotY, float rotZ, float rotW,
+                  float directionX, float directionY, float directionZ,
+                  JoltShapeCastSettings settings,
+                  JoltShapeCastHit* outHit, const JoltQueryOptions* options)
+{
+	PhysicsSystemWrapper* wrapper = static_cast<PhysicsSystemWrapper*>(system);
+	PhysicsSystem* ps = GetPhysicsSystem(wrapper);
+
+	// Results are computed relative to the start position to keep them precise far from the origin
+	RVec3 position(Real(posX), Real(posY), Real(posZ));
+	RShapeCast cast = MakeShapeCast(static_cast<const Shape*>(shape), position,
+									ToRotation(rotX, rotY, rotZ, rotW), Vec3(directionX, directionY, directionZ));
+
+	// Filters from the query options (applied during the traversal)
+	QueryFilters filters(wrapper, options);
+
+	return CastSingleShape(ps, cast, ToShapeCastSettings(settings), position, filters, outHit) ? 1 : 0;
+}
+
+// Shape cast: All hits collector
+// Keeps the closest maxHits results in a max-heap on fraction, like AllRayHitsCollector
+class AllShapeCastHitsCollector : public CastShapeCollector
+{
+public:
+	AllShapeCastHitsCollector(std::vector<ShapeCastResult>& hitBuffer, int maxHits)
+		: m_hits(hitBuffer), m_maxHits(maxHits)
+	{
+		m_hits.clear();
+	}
+
+	virtual void AddHit(const ShapeCastResult& inResult) override
+	{
+		if (static_cast<int>(m_hits.size()) < m_maxHits)
+		{
+			m_hits.push_back(inResult);
+			std::push_heap(m_hits.begin(), m_hits.end(), sCompareFraction);
+		}
+		else if (inResult.mFraction < m_hits.front().mFraction)
+		{
+			// Replace the furthest hit kept
+			std::pop_heap(m_hits.begin(), m_hits.end(), sCompareFraction);
+			m_hits.back() = inResult;
+			std::push_heap(m_hits.begin(), m_hits.end(), sCompareFraction);
+		}
+
+		// Once full, anything further than the furthest hit kept can be skipped
+		if (static_cast<int>(m_hits.size()) == m_maxHits)
+		{
+			UpdateEarlyOutFraction(m_hits.front().mFraction);
+		}
+	}
+
+	// Sort the hits by fraction and convert them, returns the number of hits written
+	int Finalize(RVec3Arg baseOffset, JoltShapeCastHit* outHits)
+	{
+		std::sort_heap(m_hits.begin(), m_hits.end(), sCompareFraction);
+
+		int numHits = static_cast<int>(m_hits.size());
+		for (int i = 0; i < numHits; i++)
+		{
+			ToShapeCastHit(m_hits[i], baseOffset, outHits[i]);
+		}
+		return numHits;
+	}
+
+private:
+	static bool sCompareFraction(const ShapeCastResult& a, const ShapeCastResult& b)
+	{
+		return a.mFraction < b.mFraction;
+	}
+
+	std::vector<ShapeCastResult>& m_hits;
+	int m_maxHits;
+};
+
+int JoltCastShapeGetHits(JoltPhysicsSystem system, JoltShape shape,
+                         double posX, double posY, double posZ,
+                         float rotX, float rotY, float rotZ, float rotW,
+                         float directionX, float directionY, float directionZ,
+                         JoltShapeCastSettings settings,
+                         JoltShapeCastHit* outHits, int maxHits,
+                         const JoltQueryOptions* options)
+{
+	PhysicsSystemWrapper* wrapper = static_cast<PhysicsSystemWrapper*>(system);
+	PhysicsSystem* ps = GetPhysicsSystem(wrapper);
+
+	if (maxHits <= 0)
+	{
+		return 0;
+	}
+
+	RVec3 position(Real(posX), Real(posY), Real(posZ));
+	RShapeCast cast = MakeShapeCast(static_cast<const Shape*>(shape), position,
+									ToRotation(rotX, rotY, rotZ, rotW), Vec3(directionX, directionY, directionZ));
+
+	// Filters from the query options (applied during the traversal)
+	QueryFilters filters(wrapper, options);
+
+	// Create collector for all hits (the hit buffer keeps its capacity between calls on this thread)
+	static thread_local std::vector<ShapeCastResult> hitBuffer;
+	AllShapeCastHitsCollector collector(hitBuffer, maxHits);
+
+	GetNarrowPhaseQuery(ps, filters).CastShape(cast, ToShapeCastSettings(settings), position, collector,
+											filters.broadPhase, filters.objectLayer, filters.body);
+
+	return collector.Finalize(position, outHits);
+}
+
+int JoltCastShapeBatch(JoltPhysicsSystem system,
+                       const JoltShapeCast* casts, int numCasts,
+                       JoltShapeCastSettings settings,
+                       JoltShapeCastHit* outHits, int multithreaded,
+                       const JoltQueryOptions* options)
+{
+	PhysicsSystemWrapper* wrapper = static_cast<PhysicsSystemWrapper*>(system);
+	PhysicsSystem* ps = GetPhysicsSystem(wrapper);
+
+	// Settings and filters are shared by every sweep (and every worker thread)
+	ShapeCastSettings castSettings = ToShapeCastSettings(settings);
+	QueryFilters filters(wrapper, options);
+
+	std::atomic<int> numHits(0);
+
+	auto castRange = [&](int begin, int end)
+	{
+		int rangeHits = 0;
+		for (int i = begin; i < end; i++)
+		{
+			const JoltShapeCast& in = casts[i];
+			RVec3 position(in.positionX, in.positionY, in.positionZ);
+			RShapeCast cast = MakeShapeCast(static_cast<const Shape*>(in.shape), position,
+											ToRotation(in.rotationX, in.rotationY, in.rotationZ, in.rotationW),
+											Vec3(in.directionX, in.directionY, in.directionZ));
+
+			if (CastSingleShape(ps, cast, castSettings, position, filters, &outHits[i]))
+			{
+				rangeHits++;
+			}
+			else
+			{
+				outHits[i] = JoltShapeCastHit{};
+				outHits[i].bodyID = BodyID::cInvalidBodyID;
+			}
+		}
+		numHits += rangeHits;
+	};
+
+	if (multithreaded != 0)
+	{
+		RunParallelBatches(GetJobSystem(wrapper), numCasts, cMinShapeCastsPerBatch, castRange);
+	}
+	else
+	{
+		castRange(0, numCasts);
+	}
+
+	return numHits.load();
+}
+
+// Collector for broadphase queries: applies the body filter and writes the IDs of the accepted bodies
+class BroadPhaseBodyCollector final : public CollideShapeBodyCollector
+{
+public:
+	BroadPhaseBodyCollector(const BodyLockInterface& bodyLock, const QueryBodyFilter& filter, JoltBodyID* outBodies, int maxBodies)
+		: m_bodyLock(bodyLock), m_filter(filter), m_outBodies(outBodies), m_maxBodies(maxBodies), m_numBodies(0) {}
+
+	virtual void AddHit(const BodyID& inBodyID) override
+	{
+		if (!m_filter.ShouldCollide(inBodyID))
+		{
+			return;
+		}
+
+		// Only lock the body when the filter has to look at it
+		if (m_filter.NeedsLockedTest())
+		{
+			BodyLockRead lock(m_bodyLock, inBodyID);
+			if (!lock.Succeeded() || !m_filter.ShouldCollideLocked(lock.GetBody()))
+			{
+				return;
+			}
+		}
+
+		m_outBodies[m_numBodies++] = inBodyID.GetIndexAndSequenceNumber();
+
+		// Output buffer is full, no point in looking for more bodies
+		if (m_numBodies >= m_maxBodies)
+		{
+			ForceEarlyOut();
+		}
+	}
+
+	int GetNumBodies() const { return m_numBodies; }
+
+private:
+	const BodyLockInterface& m_bodyLock;
+	const QueryBodyFilter& m_filter;
+	JoltBodyID* m_outBodies;
+	int m_maxBodies;
+	int m_numBodies;
+};
+
+// Query one broadphase region (box or sphere)
+static int CollideRegion(PhysicsSystem* ps, const JoltBroadPhaseRegion& region, const QueryFilters& filters,
+						 JoltBodyID* outBodies, int maxBodies)
+{
+	if (maxBodies <= 0)
+	{
+		return 0;
+	}
+
+	BroadPhaseBodyCollector collector(GetBodyLockInterface(ps, filters), filters.body, outBodies, maxBodies);
+	Vec3 center(region.centerX, region.centerY, region.centerZ);
+
+	if (region.radius > 0.0f)
+	{
+		ps->GetBroadPhaseQuery().CollideSphere(center, region.radius, collector, filters.broadPhase, filters.objectLayer);
+	}
+	else
+	{
+		Vec3 halfExtent(region.halfExtentX, region.halfExtentY, region.halfExtentZ);
+		ps->GetBroadPhaseQuery().CollideAABox(AABox(center - halfExtent, center + halfExtent), collector,
+											  filters.broadPhase, filters.objectLayer);
+	}
+
+	return collector.GetNumBodies();
+}
+
+int JoltBroadPhaseCollideAABox(JoltPhysicsSystem system,
+                               float minX, float minY, float minZ,
+                               float maxX, float maxY, float maxZ,
+                               JoltBodyID* outBodies, int maxBodies,
+                               const JoltQueryOptions* options)
+{
+	PhysicsSystemWrapper* wrapper = static_cast<PhysicsSystemWrapper*>(system);
+	PhysicsSystem* ps = GetPhysicsSystem(wrapper);
+
+	if (maxBodies <= 0)
+	{
+		return 0;
+	}
+
+	QueryFilters filters(wrapper, options);
+	BroadPhaseBodyCollector collector(GetBodyLockInterface(ps, filters), filters.body, outBodies, maxBodies);
+
+	ps->GetBroadPhaseQuery().CollideAABox(AABox(Vec3(minX, minY, minZ), Vec3(maxX, maxY, maxZ)), collector,
+										  filters.broadPhase, filters.objectLayer);
+
+	return collector.GetNumBodies();
+}
+
+int JoltBroadPhaseCollideSphere(JoltPhysicsSystem system,
+                                float centerX, float centerY, float centerZ, float radius,
+                                JoltBodyID* outBodies, int maxBodies,
+                                const JoltQueryOptions* options)
+{
+	PhysicsSystemWrapper* wrapper = static_cast<PhysicsSystemWrapper*>(system);
+	PhysicsSystem* ps = GetPhysicsSystem(wrapper);
+
+	if (maxBodies <= 0)
+	{
+		return 0;
+	}
+
+	QueryFilters filters(wrapper, options);
+	BroadPhaseBodyCollector collector(GetBodyLockInterface(ps, filters), filters.body, outBodies, maxBodies);
+
+	ps->GetBroadPhaseQuery().CollideSphere(Vec3(centerX, centerY, centerZ), radius, collector,
+										   filters.broadPhase, filters.objectLayer);
+
+	return collector.GetNumBodies();
+}
+
+int JoltBroadPhaseCollideRegions(JoltPhysicsSystem system,
+                                 const JoltBroadPhaseRegion* regions, int numRegions,
+                                 JoltBodyID* outBodies, int maxBodiesPerRegion, int* outCounts,
+                                 int multithreaded, const JoltQueryOptions* options)
+{
+	PhysicsSystemWrapper* wrapper = static_cast<PhysicsSystemWrapper*>(system);
+	PhysicsSystem* ps = GetPhysicsSystem(wrapper);
+
+	// Filters are shared by every region (and every worker thread)
+	QueryFilters filters(wrapper, options);
+
+	std::atomic<int> numBodies(0);
+
+	// Every region owns a fixed slice of the output, so the workers never share a write position
+	auto collideRange = [&](int begin, int end)
+	{
+		int rangeBodies = 0;
+		for (int i = begin; i < end; i++)
+		{
+			outCounts[i] = CollideRegion(ps, regions[i], filters, outBodies + (size_t)i * maxBodiesPerRegion, maxBodiesPerRegion);
+			rangeBodies += outCounts[i];
+		}
+		numBodies += rangeBodies;
+	};
+
+	if (multithreaded != 0)
+	{
+		RunParallelBatches(GetJobSystem(wrapper), numRegions, cMinRegionsPerBatch, collideRange);
+	}
+	else
+	{
+		collideRange(0, numRegions);
+	}
+
+	return numBodies.load();
+}
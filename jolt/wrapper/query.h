@@ -2,6 +2,12 @@
  * Jolt Physics C Wrapper - Collision Queries
  *
  * Handles shape overlap tests and collision detection queries.
+ *
+ * Queries only read the physics system, so any number of threads can run them
+ * at the same time between updates (not during JoltPhysicsSystemUpdate). By
+ * default bodies are read under their body locks, which also makes queries
+ * safe while other threads add, remove or move bodies; JoltQueryOptions.noLock
+ * skips the locks when the caller guarantees that nothing modifies the world.
  */
 
 #ifndef JOLT_WRAPPER_QUERY_H
@@ -14,7 +20,7 @@ extern "C" {
 // Opaque pointer types (defined in other headers)
 typedef void* JoltPhysicsSystem;
 typedef void* JoltShape;
-typedef void* JoltBodyID;
+typedef unsigned int JoltBodyID;   // Packed index/sequence number, see body.h
 
 // Result structure for collision hits
 typedef struct {
@@ -27,7 +33,7 @@ typedef struct {
 
 // Result structure for raycast hits
 typedef struct {
-    JoltBodyID bodyID;      // The body that was hit (NULL if no hit)
+    JoltBodyID bodyID;      // The body that was hit (JOLT_INVALID_BODY_ID if no hit)
     float hitPointX;        // Hit position in world space
     float hitPointY;
     float hitPointZ;
@@ -37,11 +43,85 @@ typedef struct {
     float fraction;         // Fraction along the ray where hit occurred [0, 1]
 } JoltRaycastHit;
 
+// Double-precision variants of the hit structures for worlds far from the origin
+// (JPH_DOUBLE_PRECISION builds keep the full precision, float builds widen their float results)
+typedef struct {
+    JoltBodyID bodyID;
+    float penetrationDepth; // Before the doubles so the struct has no padding
+    double contactPointX;
+    double contactPointY;
+    double contactPointZ;
+} JoltCollisionHit64;
+
+typedef struct {
+    JoltBodyID bodyID;
+    double hitPointX;
+    double hitPointY;
+    double hitPointZ;
+    float normalX;
+    float normalY;
+    float normalZ;
+    float fraction;
+} JoltRaycastHit64;
+
+// Result structure for shape cast hits
+typedef struct {
+    JoltBodyID bodyID;      // The body that was hit
+    float contactPointX;    // Deepest contact point on the hit body in world space
+    float contactPointY;
+    float contactPointZ;
+    float normalX;          // Surface normal of the hit body at the contact point, pointing towards the cast shape
+    float normalY;
+    float normalZ;
+    float fraction;         // Fraction along the cast direction where the shapes first touch [0, 1]
+    float penetrationDepth; // Penetration depth at that point (> 0 if the shape started out overlapping)
+} JoltShapeCastHit;
+
+// A shape swept from a start transform along a direction
+typedef struct {
+    JoltShape shape;
+    float positionX, positionY, positionZ;              // Start position in world space
+    float rotationX, rotationY, rotationZ, rotationW;   // Start rotation (zero quaternion = identity)
+    float directionX, directionY, directionZ;           // Direction and length of the sweep
+} JoltShapeCast;
+
+// Region of a broadphase query: an axis aligned box (radius = 0) or a sphere (radius > 0)
+typedef struct {
+    float centerX, centerY, centerZ;
+    float halfExtentX, halfExtentY, halfExtentZ;  // Box half extents (ignored for spheres)
+    float radius;                                 // Sphere radius, 0 for a box
+} JoltBroadPhaseRegion;
+
+// Shape cast settings (subset of Jolt's ShapeCastSettings, passed by value)
+typedef struct {
+    float collisionTolerance;            // Distance at which shapes are considered touching
+    float penetrationTolerance;          // Penetration depth accuracy of the EPA algorithm
+    int backFaceModeTriangles;           // JoltBackFaceMode (see character.h): hit the back faces of triangles
+    int backFaceModeConvex;              // JoltBackFaceMode (see character.h): hit convex shapes the cast starts inside of
+    int useShrunkenShapeAndConvexRadius; // bool as int: sweep the shrunken shape plus its convex radius (faster, less accurate corners)
+    int returnDeepestPoint;              // bool as int: for casts that start out overlapping, return the deepest point
+} JoltShapeCastSettings;
+
+// Query options (every query takes an optional pointer; NULL hits every body)
+// All filtering happens during Jolt's traversal, so filtered bodies never reach the narrow phase
+typedef struct {
+    unsigned int objectLayerMask;     // Bit i set: bodies in object layer i can be hit (0 or JOLT_ALL_OBJECT_LAYERS for all)
+                                      // Broadphase trees holding none of these layers are skipped entirely
+    const JoltBodyID* ignoredBodies;  // Bodies that can't be hit, e.g. the caster's own body (can be NULL)
+    int numIgnoredBodies;             // Number of entries in ignoredBodies (searched linearly, keep it short)
+    int ignoreSensors;                // bool as int: sensor bodies can't be hit
+    int anyHit;                       // bool as int: JoltCastRay/JoltCastShape and their batches return the first hit
+                                      // found instead of the closest one (JoltCollideShape always stops at the first hit)
+    int noLock;                       // bool as int: read bodies without taking their locks. Only valid while no other
+                                      // thread updates the system or adds, removes or modifies bodies
+} JoltQueryOptions;
+
 // Check if a shape at a position collides with anything in the physics system
 // Returns 1 if collision detected, 0 if no collision
 // penetrationTolerance: distance threshold for collision detection (use 0 for default)
 int JoltCollideShape(JoltPhysicsSystem system, JoltShape shape,
-                     float posX, float posY, float posZ, float penetrationTolerance);
+                     double posX, double posY, double posZ, float penetrationTolerance,
+                     const JoltQueryOptions* options);
 
 // Get all collision hits for a shape at a position
 // outHits: array to store results (allocated by caller)
@@ -49,25 +129,111 @@ int JoltCollideShape(JoltPhysicsSystem system, JoltShape shape,
 // penetrationTolerance: distance threshold for collision detection (use 0 for default)
 // Returns: actual number of hits found (may be less than maxHits)
 int JoltCollideShapeGetHits(JoltPhysicsSystem system, JoltShape shape,
-                            float posX, float posY, float posZ,
-                            JoltCollisionHit* outHits, int maxHits, float penetrationTolerance);
+                            double posX, double posY, double posZ,
+                            JoltCollisionHit* outHits, int maxHits, float penetrationTolerance,
+                            const JoltQueryOptions* options);
+
+// Same as JoltCollideShapeGetHits with double-precision contact points
+int JoltCollideShapeGetHits64(JoltPhysicsSystem system, JoltShape shape,
+                              double posX, double posY, double posZ,
+                              JoltCollisionHit64* outHits, int maxHits, float penetrationTolerance,
+                              const JoltQueryOptions* options);
 
 // Cast a ray and check if it hits anything
 // Returns 1 if hit detected, 0 if no hit
 // outHit: pointer to store the closest hit result (can be NULL if you only need hit/no-hit)
 int JoltCastRay(JoltPhysicsSystem system,
-                float originX, float originY, float originZ,
+                double originX, double originY, double originZ,
                 float directionX, float directionY, float directionZ,
-                JoltRaycastHit* outHit);
+                JoltRaycastHit* outHit, const JoltQueryOptions* options);
+
+// Same as JoltCastRay with a double-precision hit point
+int JoltCastRay64(JoltPhysicsSystem system,
+                  double originX, double originY, double originZ,
+                  float directionX, float directionY, float directionZ,
+                  JoltRaycastHit64* outHit, const JoltQueryOptions* options);
+
+// Cast a batch of rays and get the closest hit of each ray in a single call
+// origins, directions: numRays packed (x, y, z) triples
+// outHits: array of numRays results (allocated by caller); bodyID is JOLT_INVALID_BODY_ID for rays that missed
+// multithreaded: if non-zero, the rays are split across the job system worker threads
+// Returns: number of rays that hit something
+int JoltCastRayBatch(JoltPhysicsSystem system,
+                     const float* origins, const float* directions, int numRays,
+                     JoltRaycastHit* outHits, int multithreaded,
+                     const JoltQueryOptions* options);
 
 // Cast a ray and get all hits along the ray (sorted by distance)
 // outHits: array to store results (allocated by caller)
 // maxHits: maximum number of hits to return
 // Returns: actual number of hits found (may be less than maxHits)
 int JoltCastRayGetHits(JoltPhysicsSystem system,
-                       float originX, float originY, float originZ,
+                       double originX, double originY, double originZ,
                        float directionX, float directionY, float directionZ,
-                       JoltRaycastHit* outHits, int maxHits);
+                       JoltRaycastHit* outHits, int maxHits,
+                       const JoltQueryOptions* options);
+
+// Sweep a shape and get its closest hit (or with options->anyHit, the first hit found)
+// Returns 1 if hit detected, 0 if no hit
+// outHit: pointer to store the hit result (can be NULL if you only need hit/no-hit)
+int JoltCastShape(JoltPhysicsSystem system, JoltShape shape,
+                  double posX, double posY, double posZ,
+                  float rotX, float rotY, float rotZ, float rotW,
+                  float directionX, float directionY, float directionZ,
+                  JoltShapeCastSettings settings,
+                  JoltShapeCastHit* outHit, const JoltQueryOptions* options);
+
+// Sweep a shape and get all hits along the sweep (sorted by fraction)
+// outHits: array to store results (allocated by caller), the closest maxHits hits are kept
+// Returns: actual number of hits found (may be less than maxHits)
+int JoltCastShapeGetHits(JoltPhysicsSystem system, JoltShape shape,
+                         double posX, double posY, double posZ,
+                         float rotX, float rotY, float rotZ, float rotW,
+                         float directionX, float directionY, float directionZ,
+                         JoltShapeCastSettings settings,
+                         JoltShapeCastHit* outHits, int maxHits,
+                         const JoltQueryOptions* options);
+
+// Sweep a batch of shapes and get the closest hit of each sweep in a single call
+// outHits: array of numCasts results (allocated by caller); bodyID is JOLT_INVALID_BODY_ID for sweeps that missed
+// multithreaded: if non-zero, the sweeps are split across the job system worker threads
+// Returns: number of sweeps that hit something
+int JoltCastShapeBatch(JoltPhysicsSystem system,
+                       const JoltShapeCast* casts, int numCasts,
+                       JoltShapeCastSettings settings,
+                       JoltShapeCastHit* outHits, int multithreaded,
+                       const JoltQueryOptions* options);
+
+// Broadphase-only queries: find the bodies whose bounding boxes overlap a region, without any
+// narrow phase test against their shapes. Much cheaper than JoltCollideShapeGetHits when only the
+// set of nearby bodies is needed (e.g. interest management).
+// options->anyHit is ignored; the other options apply.
+
+// Get the bodies whose bounding boxes overlap an axis aligned box
+// outBodies: array to store results (allocated by caller), filled in traversal order
+// Returns: number of bodies written (maxBodies if the buffer filled up, in which case more may overlap)
+int JoltBroadPhaseCollideAABox(JoltPhysicsSystem system,
+                               float minX, float minY, float minZ,
+                               float maxX, float maxY, float maxZ,
+                               JoltBodyID* outBodies, int maxBodies,
+                               const JoltQueryOptions* options);
+
+// Get the bodies whose bounding boxes overlap a sphere
+// Returns: number of bodies written (maxBodies if the buffer filled up, in which case more may overlap)
+int JoltBroadPhaseCollideSphere(JoltPhysicsSystem system,
+                                float centerX, float centerY, float centerZ, float radius,
+                                JoltBodyID* outBodies, int maxBodies,
+                                const JoltQueryOptions* options);
+
+// Query many regions (e.g. one per player) in a single call
+// outBodies: numRegions * maxBodiesPerRegion entries; region i writes to outBodies[i * maxBodiesPerRegion]
+// outCounts: numRegions entries receiving the number of bodies written for each region
+// multithreaded: if non-zero, the regions are split across the job system worker threads
+// Returns: total number of bodies written
+int JoltBroadPhaseCollideRegions(JoltPhysicsSystem system,
+                                 const JoltBroadPhaseRegion* regions, int numRegions,
+                                 JoltBodyID* outBodies, int maxBodiesPerRegion, int* outCounts,
+                                 int multithreaded, const JoltQueryOptions* options);
 
 #ifdef __cplusplus
 }
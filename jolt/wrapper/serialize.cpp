@@ -0,0 +1,246 @@
+/*
+ * Jolt Physics C Wrapper - Binary Serialization Implementation
+ */
+
+#include "serialize.h"
+#include "body.h"
+#include "physics.h"
+#include "shape.h"
+#include <Jolt/Jolt.h>
+#include <Jolt/Core/StreamIn.h>
+#include <Jolt/Core/StreamOut.h>
+#include <Jolt/Physics/PhysicsSystem.h>
+#include <Jolt/Physics/PhysicsScene.h>
+#include <Jolt/Physics/Body/Body.h>
+#include <Jolt/Physics/Body/BodyCreationSettings.h>
+#include <Jolt/Physics/Body/BodyInterface.h>
+#include <Jolt/Physics/Body/BodyLock.h>
+#include <Jolt/Physics/Collision/Shape/Shape.h>
+#include <cstring>
+#include <vector>
+
+using namespace JPH;
+
+// Blob header: identifies the content and the build that wrote it
+struct BlobHeader
+{
+	uint32 magic;
+	uint32 version;
+	uint32 config;
+};
+
+static constexpr uint32 cShapeMagic = 0x4853544a;   // "JTSH"
+static constexpr uint32 cSceneMagic = 0x4353544a;   // "JTSC"
+static constexpr uint32 cVersion = (JPH_VERSION_MAJOR << 16) | (JPH_VERSION_MINOR << 8) | JPH_VERSION_PATCH;
+
+// Build options that change the binary layout
+static constexpr uint32 cConfig =
+#ifdef JPH_DOUBLE_PRECISION
+	(1u << 8) |
+#endif
+	JPH_OBJECT_LAYER_BITS;
+
+// Output stream appending to a byte vector (doubles as the JoltBuffer)
+class BufferStreamOut final : public StreamOut
+{
+public:
+	virtual void WriteBytes(const void* inData, size_t inNumBytes) override
+	{
+		const uint8* bytes = static_cast<const uint8*>(inData);
+		m_data.insert(m_data.end(), bytes, bytes + inNumBytes);
+	}
+
+	virtual bool IsFailed() const override { return false; }
+
+	std::vector<uint8> m_data;
+};
+
+// Input stream reading caller-owned memory in place
+class MemoryStreamIn final : public StreamIn
+{
+public:
+	MemoryStreamIn(const void* data, size_t size) : m_data(static_cast<const uint8*>(data)), m_size(size) {}
+
+	virtual void ReadBytes(void* outData, size_t inNumBytes) override
+	{
+		if (m_failed || inNumBytes > m_size - m_pos)
+		{
+			// Reading past the end fails the stream (and yields zeros, like a failed std::istream)
+			m_failed = true;
+			std::memset(outData, 0, inNumBytes);
+			return;
+		}
+		std::memcpy(outData, m_data + m_pos, inNumBytes);
+		m_pos += inNumBytes;
+	}
+
+	virtual bool IsEOF() const override { return m_pos >= m_size; }
+	virtual bool IsFailed() const override { return m_failed; }
+
+private:
+	const uint8* m_data;
+	size_t m_size;
+	size_t m_pos = 0;
+	bool m_failed = false;
+};
+
+static void WriteHeader(StreamOut& stream, uint32 magic)
+{
+	BlobHeader header = { magic, cVersion, cConfig };
+	stream.Write(header);
+}
+
+static bool ReadHeader(StreamIn& stream, uint32 magic)
+{
+	BlobHeader header;
+	stream.Read(header);
+	return !stream.IsFailed() && header.magic == magic && header.version == cVersion && header.config == cConfig;
+}
+
+const void* JoltBufferData(JoltBuffer buffer)
+{
+	return static_cast<BufferStreamOut *>(buffer)->m_data.data();
+}
+
+size_t JoltBufferSize(JoltBuffer buffer)
+{
+	return static_cast<BufferStreamOut *>(buffer)->m_data.size();
+}
+
+void JoltDestroyBuffer(JoltBuffer buffer)
+{
+	delete static_cast<BufferStreamOut *>(buffer);
+}
+
+JoltBuffer JoltShapeSaveBinary(JoltShape shape)
+{
+	const Shape *s = static_cast<const Shape *>(shape);
+	if (s == nullptr)
+	{
+		return nullptr;
+	}
+
+	BufferStreamOut *stream = new BufferStreamOut();
+	WriteHeader(*stream, cShapeMagic);
+
+	Shape::ShapeToIDMap shapeMap;
+	Shape::MaterialToIDMap materialMap;
+	s->SaveWithChildren(*stream, shapeMap, materialMap);
+	return stream;
+}
+
+JoltShape JoltShapeRestoreBinary(const void* data, size_t size)
+{
+	if (data == nullptr)
+	{
+		return nullptr;
+	}
+
+	MemoryStreamIn stream(data, size);
+	if (!ReadHeader(stream, cShapeMagic))
+	{
+		return nullptr;
+	}
+
+	Shape::IDToShapeMap shapeMap;
+	Shape::IDToMaterialMap materialMap;
+	Shape::ShapeResult result = Shape::sRestoreWithChildren(stream, shapeMap, materialMap);
+	if (stream.IsFailed())
+	{
+		return nullptr;
+	}
+	return ToJoltShape(result);
+}
+
+JoltBuffer JoltPhysicsSystemSaveScene(JoltPhysicsSystem system)
+{
+	PhysicsSystemWrapper *wrapper = static_cast<PhysicsSystemWrapper *>(system);
+	PhysicsSystem *physics = GetPhysicsSystem(wrapper);
+
+	BodyIDVector ids;
+	physics->GetBodies(ids);
+
+	Ref<PhysicsScene> scene = new PhysicsScene();
+	const BodyLockInterface &lockInterface = physics->GetBodyLockInterface();
+	for (const BodyID &id : ids)
+	{
+		BodyLockRead lock(lockInterface, id);
+		if (lock.Succeeded() && lock.GetBody().IsRigidBody())
+		{
+			scene->AddBody(lock.GetBody().GetBodyCreationSettings());
+		}
+	}
+
+	BufferStreamOut *stream = new BufferStreamOut();
+	WriteHeader(*stream, cSceneMagic);
+	scene->SaveBinaryState(*stream, true, true);
+	return stream;
+}
+
+JoltScene JoltSceneRestoreBinary(const void* data, size_t size)
+{
+	if (data == nullptr)
+	{
+		return nullptr;
+	}
+
+	MemoryStreamIn stream(data, size);
+	if (!ReadHeader(stream, cSceneMagic))
+	{
+		return nullptr;
+	}
+
+	PhysicsScene::PhysicsSceneResult result = PhysicsScene::sRestoreFromBinaryState(stream);
+	if (stream.IsFailed() || result.HasError())
+	{
+		return nullptr;
+	}
+
+	// The handle owns one reference, released by JoltDestroyScene
+	PhysicsScene *scene = result.Get();
+	scene->AddRef();
+	return scene;
+}
+
+void JoltDestroyScene(JoltScene scene)
+{
+	if (scene != nullptr)
+	{
+		static_cast<PhysicsScene *>(scene)->Release();
+	}
+}
+
+int JoltSceneGetNumBodies(JoltScene scene)
+{
+	return static_cast<int>(static_cast<const PhysicsScene *>(scene)->GetBodies().size());
+}
+
+int JoltSceneCreateBodies(JoltScene scene, JoltPhysicsSystem system, JoltBodyID* outIDs, int activate)
+{
+	const PhysicsScene *s = static_cast<const PhysicsScene *>(scene);
+	PhysicsSystemWrapper *wrapper = static_cast<PhysicsSystemWrapper *>(system);
+	BodyInterface &bi = GetPhysicsSystem(wrapper)->GetBodyInterface();
+
+	// Static and moving bodies are added as separate batches so only the moving ones get activated
+	std::vector<BodyID> staticIDs;
+	std::vector<BodyID> movingIDs;
+
+	const Array<BodyCreationSettings> &bodies = s->GetBodies();
+	for (size_t i = 0; i < bodies.size(); i++)
+	{
+		Body *body = bi.CreateBody(bodies[i]);
+		if (!body)
+		{
+			outIDs[i] = JOLT_INVALID_BODY_ID;
+			continue;
+		}
+
+		outIDs[i] = body->GetID().GetIndexAndSequenceNumber();
+		(body->IsStatic() ? staticIDs : movingIDs).push_back(body->GetID());
+	}
+
+	AddBodiesBatch(&bi, staticIDs, EActivation::DontActivate);
+	AddBodiesBatch(&bi, movingIDs, activate != 0 ? EActivation::Activate : EActivation::DontActivate);
+
+	return static_cast<int>(staticIDs.size() + movingIDs.size());
+}
@@ -0,0 +1,69 @@
+/*
+ * Jolt Physics C Wrapper - Binary Serialization
+ *
+ * Saves cooked shapes (including a mesh's BVH) and the bodies of a physics
+ * system to Jolt's binary state format, and restores them without rebuilding
+ * anything. Restoring reads straight from the caller's memory, so baked data
+ * can be memory-mapped.
+ *
+ * Every blob starts with a small header holding the Jolt version and precision
+ * it was saved with: Jolt's binary state is not portable between versions, so
+ * data from another build is rejected instead of misread.
+ */
+
+#ifndef JOLT_WRAPPER_SERIALIZE_H
+#define JOLT_WRAPPER_SERIALIZE_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Opaque pointer types (JoltShape, JoltPhysicsSystem defined in other headers)
+typedef void* JoltShape;
+typedef void* JoltPhysicsSystem;
+typedef void* JoltBuffer;
+typedef void* JoltScene;
+typedef unsigned int JoltBodyID;   // Packed index/sequence number, see body.h
+
+// Bytes produced by a save function, owned by the wrapper until JoltDestroyBuffer
+const void* JoltBufferData(JoltBuffer buffer);
+size_t JoltBufferSize(JoltBuffer buffer);
+void JoltDestroyBuffer(JoltBuffer buffer);
+
+// Save a shape with its sub shapes and materials (shared sub shapes are stored once)
+// Returns NULL on failure
+JoltBuffer JoltShapeSaveBinary(JoltShape shape);
+
+// Restore a shape saved with JoltShapeSaveBinary
+// The data is only read during the call
+// Returns a shape to release with JoltDestroyShape, or NULL if the data is invalid or from another Jolt build
+JoltShape JoltShapeRestoreBinary(const void* data, size_t size);
+
+// Save the creation settings of every body in the system (shape, transform, motion type, layer,
+// sensor flag, ...), storing each shared shape once. Velocities and constraints are not saved.
+// Must not be called while the physics system is updating.
+// Returns NULL on failure
+JoltBuffer JoltPhysicsSystemSaveScene(JoltPhysicsSystem system);
+
+// Restore a scene saved with JoltPhysicsSystemSaveScene (the data is only read during the call)
+// The scene can be instantiated in any number of physics systems and must be freed with JoltDestroyScene
+// Returns NULL if the data is invalid or from another Jolt build
+JoltScene JoltSceneRestoreBinary(const void* data, size_t size);
+void JoltDestroyScene(JoltScene scene);
+
+// Number of bodies in a scene
+int JoltSceneGetNumBodies(JoltScene scene);
+
+// Create the bodies of a scene in a physics system and add them as one broadphase batch
+// outIDs: receives JoltSceneGetNumBodies IDs in scene order (JOLT_INVALID_BODY_ID for bodies that could not be created)
+// activate: if non-zero, the kinematic and dynamic bodies start active
+// Returns: number of bodies created
+int JoltSceneCreateBodies(JoltScene scene, JoltPhysicsSystem system, JoltBodyID* outIDs, int activate);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // JOLT_WRAPPER_SERIALIZE_H
@@ -13,91 +13,143 @@
 #include <Jolt/Physics/Collision/CastResult.h>
 #include <Jolt/Physics/Collision/Shape/SubShapeID.h>
 #include <Jolt/Physics/Collision/TransformedShape.h>
+#include <cstring>
 
 using namespace JPH;
 
-JoltShape JoltCreateSphere(float radius)
+ShapeSettings::ShapeResult BuildSphereShape(float radius)
 {
-	SphereShapeSettings sphere_settings(radius);
-	ShapeSettings::ShapeResult sphere_result = sphere_settings.Create();
-
-	// Shapes are ref-counted, AddRef to keep it alive
-	ShapeRefC shape = sphere_result.Get();
-	shape->AddRef();
+	return SphereShapeSettings(radius).Create();
+}
 
-	return static_cast<JoltShape>(const_cast<Shape*>(shape.GetPtr()));
+ShapeSettings::ShapeResult BuildBoxShape(float halfExtentX, float halfExtentY, float halfExtentZ)
+{
+	return BoxShapeSettings(Vec3(halfExtentX, halfExtentY, halfExtentZ)).Create();
 }
 
-JoltShape JoltCreateBox(float halfExtentX, float halfExtentY, float halfExtentZ)
+ShapeSettings::ShapeResult BuildCapsuleShape(float halfHeight, float radius)
 {
-	BoxShapeSettings box_settings(Vec3(halfExtentX, halfExtentY, halfExtentZ));
-	ShapeSettings::ShapeResult box_result = box_settings.Create();
+	return CapsuleShapeSettings(halfHeight, radius).Create();
+}
 
-	// Shapes are ref-counted, AddRef to keep it alive
-	ShapeRefC shape = box_result.Get();
-	shape->AddRef();
+ShapeSettings::ShapeResult BuildConvexHullShape(const float* points, int numPoints)
+{
+	// Fill the settings' point array directly (Vec3 is padded, so the packed input must be converted once)
+	ConvexHullShapeSettings hull_settings;
+	hull_settings.mPoints.reserve(numPoints);
+	for (int i = 0; i < numPoints; ++i) {
+		hull_settings.mPoints.push_back(Vec3(points[i * 3], points[i * 3 + 1], points[i * 3 + 2]));
+	}
 
-	return static_cast<JoltShape>(const_cast<Shape*>(shape.GetPtr()));
+	return hull_settings.Create();
 }
 
-JoltShape JoltCreateCapsule(float halfHeight, float radius)
+ShapeSettings::ShapeResult BuildMeshShape(const float* vertices, int numVertices,
+										  const uint32* indices, int numIndices)
 {
-	CapsuleShapeSettings capsule_settings(halfHeight, radius);
-	ShapeSettings::ShapeResult capsule_result = capsule_settings.Create();
+	ShapeSettings::ShapeResult result;
+	if (numVertices <= 0 || numIndices <= 0 || numIndices % 3 != 0)
+	{
+		result.SetError("Mesh needs vertices and a multiple of 3 indices");
+		return result;
+	}
 
-	// Shapes are ref-counted, AddRef to keep it alive
-	ShapeRefC shape = capsule_result.Get();
-	shape->AddRef();
+	// Float3 has the same packed layout as the input, so the vertices are copied in one go
+	static_assert(sizeof(Float3) == 3 * sizeof(float), "Float3 must be three packed floats");
+	VertexList vertex_list;
+	vertex_list.resize(numVertices);
+	std::memcpy(vertex_list.data(), vertices, sizeof(Float3) * static_cast<size_t>(numVertices));
 
-	return static_cast<JoltShape>(const_cast<Shape*>(shape.GetPtr()));
+	IndexedTriangleList triangles;
+	triangles.reserve(numIndices / 3);
+	for (int i = 0; i < numIndices; i += 3) {
+		uint32 i0 = indices[i];
+		uint32 i1 = indices[i + 1];
+		uint32 i2 = indices[i + 2];
+		if (i0 >= uint32(numVertices) || i1 >= uint32(numVertices) || i2 >= uint32(numVertices))
+		{
+			result.SetError("Mesh index out of range");
+			return result;
+		}
+		triangles.push_back(IndexedTriangle(i0, i1, i2));
+	}
+
+	// The settings take ownership of both lists, so the indexed data is never expanded per triangle
+	MeshShapeSettings mesh_settings(std::move(vertex_list), std::move(triangles));
+	return mesh_settings.Create();
 }
 
-JoltShape JoltCreateConvexHull(const float* points, int numPoints)
+// Copy the error of a failed shape into a caller buffer (always NUL terminated)
+static void CopyShapeError(const ShapeSettings::ShapeResult& result, char* outError, int errorSize)
 {
-	// Convert float array to Vec3 array
-	Array<Vec3> vertices;
-	vertices.reserve(numPoints);
-	for (int i = 0; i < numPoints; ++i) {
-		vertices.push_back(Vec3(points[i * 3], points[i * 3 + 1], points[i * 3 + 2]));
+	if (outError == nullptr || errorSize <= 0)
+	{
+		return;
 	}
 
-	ConvexHullShapeSettings hull_settings(vertices);
-	ShapeSettings::ShapeResult hull_result = hull_settings.Create();
+	const char* message = result.HasError() ? result.GetError().c_str() : "";
+	std::strncpy(outError, message, errorSize - 1);
+	outError[errorSize - 1] = '\0';
+}
+
+JoltShape ToJoltShape(const Shape* shape)
+{
+	if (shape == nullptr)
+	{
+		return nullptr;
+	}
 
-	// Shapes are ref-counted, AddRef to keep it alive
-	ShapeRefC shape = hull_result.Get();
+	// Shapes are ref-counted, AddRef to keep it alive until JoltDestroyShape
 	shape->AddRef();
+	return static_cast<JoltShape>(const_cast<Shape*>(shape));
+}
+
+JoltShape ToJoltShape(const ShapeSettings::ShapeResult& result)
+{
+	return result.IsValid() ? ToJoltShape(result.Get().GetPtr()) : nullptr;
+}
 
-	return static_cast<JoltShape>(const_cast<Shape*>(shape.GetPtr()));
+JoltShape JoltCreateSphere(float radius)
+{
+	return ToJoltShape(BuildSphereShape(radius));
 }
 
-JoltShape JoltCreateMesh(const float* vertices, int numVertices,
-							   const int* indices, int numIndices)
+JoltShape JoltCreateBox(float halfExtentX, float halfExtentY, float halfExtentZ)
 {
-	// Create mesh shape with vertices and indices
-	TriangleList triangles;
-	triangles.reserve(numIndices / 3);
+	return ToJoltShape(BuildBoxShape(halfExtentX, halfExtentY, halfExtentZ));
+}
 
-	for (int i = 0; i < numIndices; i += 3) {
-		int i0 = indices[i];
-		int i1 = indices[i + 1];
-		int i2 = indices[i + 2];
-
-		Triangle tri;
-		tri.mV[0] = Float3(vertices[i0 * 3], vertices[i0 * 3 + 1], vertices[i0 * 3 + 2]);
-		tri.mV[1] = Float3(vertices[i1 * 3], vertices[i1 * 3 + 1], vertices[i1 * 3 + 2]);
-		tri.mV[2] = Float3(vertices[i2 * 3], vertices[i2 * 3 + 1], vertices[i2 * 3 + 2]);
-		triangles.push_back(tri);
-	}
+JoltShape JoltCreateCapsule(float halfHeight, float radius)
+{
+	return ToJoltShape(BuildCapsuleShape(halfHeight, radius));
+}
 
-	MeshShapeSettings mesh_settings(triangles);
-	ShapeSettings::ShapeResult mesh_result = mesh_settings.Create();
+JoltShape JoltCreateConvexHull(const float* points, int numPoints)
+{
+	return ToJoltShape(BuildConvexHullShape(points, numPoints));
+}
 
-	// Shapes are ref-counted, AddRef to keep it alive
-	ShapeRefC shape = mesh_result.Get();
-	shape->AddRef();
+JoltShape JoltCreateMesh(const float* vertices, int numVertices,
+							   const int* indices, int numIndices)
+{
+	// Negative indices become out of range unsigned ones and are rejected
+	return ToJoltShape(BuildMeshShape(vertices, numVertices, reinterpret_cast<const uint32*>(indices), numIndices));
+}
+
+JoltShape JoltCreateConvexHullWithError(const float* points, int numPoints, char* outError, int errorSize)
+{
+	ShapeSettings::ShapeResult result = BuildConvexHullShape(points, numPoints);
+	CopyShapeError(result, outError, errorSize);
+	return ToJoltShape(result);
+}
 
-	return static_cast<JoltShape>(const_cast<Shape*>(shape.GetPtr()));
+JoltShape JoltCreateIndexedMesh(const float* vertices, int numVertices,
+								const unsigned int* indices, int numIndices,
+								char* outError, int errorSize)
+{
+	ShapeSettings::ShapeResult result = BuildMeshShape(vertices, numVertices, indices, numIndices);
+	CopyShapeError(result, outError, errorSize);
+	return ToJoltShape(result);
 }
 
 void JoltDestroyShape(JoltShape shape)
@@ -31,6 +31,19 @@ JoltShape JoltCreateConvexHull(const float* points, int numPoints);
 JoltShape JoltCreateMesh(const float* vertices, int numVertices,
                                const int* indices, int numIndices);
 
+// Create a convex hull shape like JoltCreateConvexHull, reporting why it failed
+// outError: receives the error message if NULL is returned (truncated to errorSize, may be NULL)
+JoltShape JoltCreateConvexHullWithError(const float* points, int numPoints, char* outError, int errorSize);
+
+// Create a mesh shape from an indexed triangle list, consumed directly without expanding it per triangle
+// vertices: numVertices packed xyz triples
+// indices: numIndices vertex indices, three per triangle (numIndices must be a multiple of 3)
+// outError: receives the error message if NULL is returned (truncated to errorSize, may be NULL)
+// Returns NULL for out of range indices or if Jolt rejects the mesh
+JoltShape JoltCreateIndexedMesh(const float* vertices, int numVertices,
+                                const unsigned int* indices, int numIndices,
+                                char* outError, int errorSize);
+
 // Destroy a shape
 void JoltDestroyShape(JoltShape shape);
 
@@ -63,6 +76,21 @@ int JoltTransformedShapeCastRay(JoltTransformedShape transformedShape,
 
 #ifdef __cplusplus
 }
+
+// C++ only: shape construction shared by the JoltCreate* functions and the shape cache (see shape_cache.h)
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/Collision/Shape/Shape.h>
+
+JPH::ShapeSettings::ShapeResult BuildSphereShape(float radius);
+JPH::ShapeSettings::ShapeResult BuildBoxShape(float halfExtentX, float halfExtentY, float halfExtentZ);
+JPH::ShapeSettings::ShapeResult BuildCapsuleShape(float halfHeight, float radius);
+JPH::ShapeSettings::ShapeResult BuildConvexHullShape(const float* points, int numPoints);
+JPH::ShapeSettings::ShapeResult BuildMeshShape(const float* vertices, int numVertices, const JPH::uint32* indices, int numIndices);
+
+// Hand a shape to C: adds the reference the caller releases with JoltDestroyShape (NULL for errors)
+JoltShape ToJoltShape(const JPH::Shape* shape);
+JoltShape ToJoltShape(const JPH::ShapeSettings::ShapeResult& result);
+
 #endif
 
 #endif // JOLT_WRAPPER_SHAPE_H
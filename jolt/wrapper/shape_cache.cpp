@@ -0,0 +1,255 @@
+/*
+ * Jolt Physics C Wrapper - Shape Cache Implementation
+ */
+
+#include "shape_cache.h"
+#include <Jolt/Jolt.h>
+#include <Jolt/Core/HashCombine.h>
+#include <Jolt/Physics/Collision/Shape/Shape.h>
+#include <unordered_map>
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <cstring>
+
+using namespace JPH;
+
+enum class CachedShapeType : uint32
+{
+	Sphere,
+	Box,
+	Capsule,
+	ConvexHull,
+	Mesh,
+};
+
+// Primitives are keyed by the bit patterns of their parameters, hulls and meshes by their element
+// counts plus a hash of their input data (their entries also keep the input to rule out hash collisions)
+struct ShapeKey
+{
+	CachedShapeType type;
+	uint32 params[3] = {};
+	uint64 contentHash = 0;
+
+	bool operator==(const ShapeKey& other) const
+	{
+		return type == other.type && std::memcmp(params, other.params, sizeof(params)) == 0
+			&& contentHash == other.contentHash;
+	}
+};
+
+struct ShapeKeyHash
+{
+	size_t operator()(const ShapeKey& key) const
+	{
+		uint64 hash = HashBytes(&key.type, sizeof(key.type));
+		hash = HashBytes(key.params, sizeof(key.params), hash);
+		return static_cast<size_t>(HashBytes(&key.contentHash, sizeof(key.contentHash), hash));
+	}
+};
+
+static uint32 FloatBits(float value)
+{
+	uint32 bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+// Input data of a hull or mesh, as up to two byte ranges (mesh vertices and indices); empty for primitives
+struct ShapeContent
+{
+	const void* data[2] = {};
+	size_t size[2] = {};
+
+	bool Matches(const std::vector<uint8>& stored) const
+	{
+		if (stored.size() != size[0] + size[1])
+		{
+			return false;
+		}
+		return (size[0] == 0 || std::memcmp(stored.data(), data[0], size[0]) == 0)
+			&& (size[1] == 0 || std::memcmp(stored.data() + size[0], data[1], size[1]) == 0);
+	}
+
+	std::vector<uint8> Copy() const
+	{
+		std::vector<uint8> out(size[0] + size[1]);
+		if (size[0] > 0)
+		{
+			std::memcpy(out.data(), data[0], size[0]);
+		}
+		if (size[1] > 0)
+		{
+			std::memcpy(out.data() + size[0], data[1], size[1]);
+		}
+		return out;
+	}
+};
+
+struct CachedShape
+{
+	ShapeRefC shape;
+	std::vector<uint8> content;  // Copy of the hull or mesh input the shape was built from
+};
+
+struct ShapeCacheWrapper
+{
+	std::mutex mutex;
+
+	// Shapes whose content hashes collide share a key, so a key can map to several shapes
+	std::unordered_multimap<ShapeKey, CachedShape, ShapeKeyHash> shapes;
+
+	// Return the cached shape for key and content, or build and cache it (building happens outside the lock,
+	// so a slow mesh doesn't block other lookups; if two threads race, the first one cached wins)
+	template <class Build>
+	JoltShape Get(const ShapeKey& key, const ShapeContent& content, const Build& build)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (const CachedShape* cached = Find(key, content))
+			{
+				return ToJoltShape(cached->shape.GetPtr());
+			}
+		}
+
+		ShapeSettings::ShapeResult result = build();
+		if (!result.IsValid())
+		{
+			return nullptr;
+		}
+
+		std::lock_guard<std::mutex> lock(mutex);
+		if (const CachedShape* cached = Find(key, content))
+		{
+			return ToJoltShape(cached->shape.GetPtr());
+		}
+		auto inserted = shapes.emplace(key, CachedShape{ result.Get(), content.Copy() });
+		return ToJoltShape(inserted->second.shape.GetPtr());
+	}
+
+	template <class Build>
+	JoltShape Get(const ShapeKey& key, const Build& build)
+	{
+		return Get(key, ShapeContent(), build);
+	}
+
+private:
+	// Entry for key whose stored input equals content (call with the mutex held)
+	const CachedShape* Find(const ShapeKey& key, const ShapeContent& content) const
+	{
+		auto range = shapes.equal_range(key);
+		for (auto it = range.first; it != range.second; ++it)
+		{
+			if (content.Matches(it->second.content))
+			{
+				return &it->second;
+			}
+		}
+		return nullptr;
+	}
+};
+
+JoltShapeCache JoltCreateShapeCache()
+{
+	return static_cast<JoltShapeCache>(new ShapeCacheWrapper());
+}
+
+void JoltDestroyShapeCache(JoltShapeCache cache)
+{
+	delete static_cast<ShapeCacheWrapper*>(cache);
+}
+
+JoltShape JoltShapeCacheGetSphere(JoltShapeCache cache, float radius)
+{
+	ShapeKey key;
+	key.type = CachedShapeType::Sphere;
+	key.params[0] = FloatBits(radius);
+	return static_cast<ShapeCacheWrapper*>(cache)->Get(key, [&]() { return BuildSphereShape(radius); });
+}
+
+JoltShape JoltShapeCacheGetBox(JoltShapeCache cache, float halfExtentX, float halfExtentY, float halfExtentZ)
+{
+	ShapeKey key;
+	key.type = CachedShapeType::Box;
+	key.params[0] = FloatBits(halfExtentX);
+	key.params[1] = FloatBits(halfExtentY);
+	key.params[2] = FloatBits(halfExtentZ);
+	return static_cast<ShapeCacheWrapper*>(cache)->Get(key, [&]() { return BuildBoxShape(halfExtentX, halfExtentY, halfExtentZ); });
+}
+
+JoltShape JoltShapeCacheGetCapsule(JoltShapeCache cache, float halfHeight, float radius)
+{
+	ShapeKey key;
+	key.type = CachedShapeType::Capsule;
+	key.params[0] = FloatBits(halfHeight);
+	key.params[1] = FloatBits(radius);
+	return static_cast<ShapeCacheWrapper*>(cache)->Get(key, [&]() { return BuildCapsuleShape(halfHeight, radius); });
+}
+
+JoltShape JoltShapeCacheGetConvexHull(JoltShapeCache cache, const float* points, int numPoints)
+{
+	if (numPoints <= 0)
+	{
+		return nullptr;
+	}
+
+	ShapeKey key;
+	key.type = CachedShapeType::ConvexHull;
+	key.params[0] = static_cast<uint32>(numPoints);
+	ShapeContent content;
+	content.data[0] = points;
+	content.size[0] = sizeof(float) * 3 * static_cast<size_t>(numPoints);
+	key.contentHash = HashBytes(content.data[0], content.size[0]);
+	return static_cast<ShapeCacheWrapper*>(cache)->Get(key, content, [&]() { return BuildConvexHullShape(points, numPoints); });
+}
+
+JoltShape JoltShapeCacheGetMesh(JoltShapeCache cache, const float* vertices, int numVertices,
+                                const int* indices, int numIndices)
+{
+	if (numVertices <= 0 || numIndices <= 0)
+	{
+		return nullptr;
+	}
+
+	ShapeKey key;
+	key.type = CachedShapeType::Mesh;
+	key.params[0] = static_cast<uint32>(numVertices);
+	key.params[1] = static_cast<uint32>(numIndices);
+	ShapeContent content;
+	content.data[0] = vertices;
+	content.size[0] = sizeof(float) * 3 * static_cast<size_t>(numVertices);
+	content.data[1] = indices;
+	content.size[1] = sizeof(int) * static_cast<size_t>(numIndices);
+	key.contentHash = HashBytes(content.data[0], content.size[0]);
+	key.contentHash = HashBytes(content.data[1], content.size[1], key.contentHash);
+	return static_cast<ShapeCacheWrapper*>(cache)->Get(key, content, [&]() { return BuildMeshShape(vertices, numVertices, reinterpret_cast<const uint32*>(indices), numIndices); });
+}
+
+int JoltShapeCacheCount(JoltShapeCache cache)
+{
+	ShapeCacheWrapper* c = static_cast<ShapeCacheWrapper*>(cache);
+	std::lock_guard<std::mutex> lock(c->mutex);
+	return static_cast<int>(c->shapes.size());
+}
+
+int JoltShapeCachePurge(JoltShapeCache cache)
+{
+	ShapeCacheWrapper* c = static_cast<ShapeCacheWrapper*>(cache);
+	std::lock_guard<std::mutex> lock(c->mutex);
+
+	int numPurged = 0;
+	for (auto it = c->shapes.begin(); it != c->shapes.end();)
+	{
+		// The cache's own reference is the only one left
+		if (it->second.shape->GetRefCount() == 1)
+		{
+			it = c->shapes.erase(it);
+			numPurged++;
+		}
+		else
+		{
+			++it;
+		}
+	}
+	return numPurged;
+}
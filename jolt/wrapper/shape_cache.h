@@ -0,0 +1,49 @@
+/*
+ * Jolt Physics C Wrapper - Shape Cache
+ *
+ * Deduplicates shapes: requesting a shape with the same parameters (or the
+ * same hull/mesh input data) returns the shape that was created first.
+ */
+
+#ifndef JOLT_WRAPPER_SHAPE_CACHE_H
+#define JOLT_WRAPPER_SHAPE_CACHE_H
+
+#include "shape.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Opaque pointer type
+typedef void* JoltShapeCache;
+
+// Create an empty shape cache (safe to use from multiple threads)
+JoltShapeCache JoltCreateShapeCache();
+
+// Destroy a shape cache, releasing its references (shapes handed out stay valid until destroyed by their users)
+void JoltDestroyShapeCache(JoltShapeCache cache);
+
+// Get a shape from the cache, creating it on first use
+// Every returned shape holds a reference that must be released with JoltDestroyShape, like JoltCreate*
+// Hulls and meshes are keyed by a 64-bit hash of their input data; the cache keeps a copy of the input and
+// compares it on every hit, so inputs whose hashes collide still get their own shapes
+// Returns NULL if the shape could not be created
+JoltShape JoltShapeCacheGetSphere(JoltShapeCache cache, float radius);
+JoltShape JoltShapeCacheGetBox(JoltShapeCache cache, float halfExtentX, float halfExtentY, float halfExtentZ);
+JoltShape JoltShapeCacheGetCapsule(JoltShapeCache cache, float halfHeight, float radius);
+JoltShape JoltShapeCacheGetConvexHull(JoltShapeCache cache, const float* points, int numPoints);
+JoltShape JoltShapeCacheGetMesh(JoltShapeCache cache, const float* vertices, int numVertices,
+                                const int* indices, int numIndices);
+
+// Number of shapes in the cache
+int JoltShapeCacheCount(JoltShapeCache cache);
+
+// Drop the shapes nobody but the cache references anymore
+// Returns: number of shapes dropped
+int JoltShapeCachePurge(JoltShapeCache cache);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // JOLT_WRAPPER_SHAPE_CACHE_H
@@ -0,0 +1,137 @@
+/*
+ * Jolt Physics C Wrapper - Simulation State Snapshot Implementation
+ */
+
+#include "state.h"
+#include "physics.h"
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/PhysicsSystem.h>
+#include <Jolt/Physics/StateRecorder.h>
+#include <Jolt/Physics/Body/Body.h>
+#include <Jolt/Physics/Body/BodyLockInterface.h>
+#include <Jolt/Physics/Character/CharacterVirtual.h>
+#include <algorithm>
+#include <cstring>
+
+using namespace JPH;
+
+// State recorder writing into or reading from caller-owned memory
+//
+// Jolt's StateRecorderImpl records into a std::stringstream, which allocates on every snapshot.
+// When writing, bytes beyond the capacity are only counted, so the caller learns the size it needs.
+class MemoryStateRecorder final : public StateRecorder
+{
+public:
+	// Recorder for saving into data
+	MemoryStateRecorder(void* data, size_t capacity) : m_out(static_cast<uint8*>(data)), m_size(capacity) {}
+
+	// Recorder for restoring from data
+	MemoryStateRecorder(const void* data, size_t size) : m_in(static_cast<const uint8*>(data)), m_size(size) {}
+
+	virtual void WriteBytes(const void* inData, size_t inNumBytes) override
+	{
+		if (m_pos < m_size)
+		{
+			std::memcpy(m_out + m_pos, inData, std::min(inNumBytes, m_size - m_pos));
+		}
+		m_pos += inNumBytes;
+	}
+
+	virtual void ReadBytes(void* outData, size_t inNumBytes) override
+	{
+		if (m_failed || inNumBytes > m_size - m_pos)
+		{
+			// Reading past the end fails the recorder (and yields zeros)
+			m_failed = true;
+			std::memset(outData, 0, inNumBytes);
+			return;
+		}
+		std::memcpy(outData, m_in + m_pos, inNumBytes);
+		m_pos += inNumBytes;
+	}
+
+	virtual bool IsEOF() const override { return m_pos >= m_size; }
+	virtual bool IsFailed() const override { return m_failed; }
+
+	// Bytes written (including the ones that didn't fit) or read
+	size_t GetPosition() const { return m_pos; }
+
+private:
+	uint8* m_out = nullptr;
+	const uint8* m_in = nullptr;
+	size_t m_size;
+	size_t m_pos = 0;
+	bool m_failed = false;
+};
+
+// Saves only awake bodies and the contacts they take part in
+class ActiveBodiesFilter final : public StateRecorderFilter
+{
+public:
+	explicit ActiveBodiesFilter(const BodyLockInterface& bodies) : m_bodies(bodies) {}
+
+	virtual bool ShouldSaveBody(const Body& inBody) const override
+	{
+		return inBody.IsActive();
+	}
+
+	virtual bool ShouldSaveContact(const BodyID& inBody1, const BodyID& inBody2) const override
+	{
+		return IsActive(inBody1) || IsActive(inBody2);
+	}
+
+private:
+	bool IsActive(const BodyID& inBodyID) const
+	{
+		const Body* body = m_bodies.TryGetBody(inBodyID);
+		return body != nullptr && body->IsActive();
+	}
+
+	// Saving runs between updates, so no body locks are needed
+	const BodyLockInterface& m_bodies;
+};
+
+size_t JoltPhysicsSystemSaveState(JoltPhysicsSystem system, int state, int activeBodiesOnly,
+								  void* outData, size_t capacity)
+{
+	PhysicsSystem* ps = GetPhysicsSystem(static_cast<PhysicsSystemWrapper*>(system));
+
+	MemoryStateRecorder recorder(outData, capacity);
+	EStateRecorderState what = static_cast<EStateRecorderState>(state & static_cast<int>(EStateRecorderState::All));
+	if (activeBodiesOnly != 0)
+	{
+		ActiveBodiesFilter filter(ps->GetBodyLockInterfaceNoLock());
+		ps->SaveState(recorder, what, &filter);
+	}
+	else
+	{
+		ps->SaveState(recorder, what);
+	}
+	return recorder.GetPosition();
+}
+
+int JoltPhysicsSystemRestoreState(JoltPhysicsSystem system, const void* data, size_t size)
+{
+	PhysicsSystem* ps = GetPhysicsSystem(static_cast<PhysicsSystemWrapper*>(system));
+
+	MemoryStateRecorder recorder(data, size);
+	return ps->RestoreState(recorder) && !recorder.IsFailed() ? 1 : 0;
+}
+
+size_t JoltCharacterVirtualSaveState(JoltCharacterVirtual character, void* outData, size_t capacity)
+{
+	const CharacterVirtual* cv = static_cast<const CharacterVirtual*>(character);
+
+	MemoryStateRecorder recorder(outData, capacity);
+	cv->SaveState(recorder);
+	return recorder.GetPosition();
+}
+
+int JoltCharacterVirtualRestoreState(JoltCharacterVirtual character, const void* data, size_t size)
+{
+	CharacterVirtual* cv = static_cast<CharacterVirtual*>(character);
+
+	MemoryStateRecorder recorder(data, size);
+	cv->RestoreState(recorder);
+	return recorder.IsFailed() ? 0 : 1;
+}
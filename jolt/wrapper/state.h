@@ -0,0 +1,60 @@
+/*
+ * Jolt Physics C Wrapper - Simulation State Snapshots
+ *
+ * Saves the simulation state of a physics system (body transforms and
+ * velocities, sleep state, the contact cache, constraint state and gravity)
+ * into a caller-owned buffer and restores it, for rollback netcode and
+ * client-side prediction. The state is written straight into the buffer, so a
+ * snapshot buffer that is reused between ticks costs no allocations.
+ *
+ * Unlike JoltPhysicsSystemSaveScene, a state snapshot does not describe the
+ * bodies themselves: it can only be restored into the system it was saved
+ * from (or one with the same bodies created in the same order).
+ */
+
+#ifndef JOLT_WRAPPER_STATE_H
+#define JOLT_WRAPPER_STATE_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void* JoltPhysicsSystem;
+typedef void* JoltCharacterVirtual;
+
+// Parts of the state to save (Jolt's EStateRecorderState), combined with |
+#define JOLT_STATE_GLOBAL       0x1     // Gravity
+#define JOLT_STATE_BODIES       0x2     // Body transforms, velocities and sleep state
+#define JOLT_STATE_CONTACTS     0x4     // Contact cache, needed to continue the simulation exactly as before
+#define JOLT_STATE_CONSTRAINTS  0x8     // Constraint state (lambdas, motor state, ...)
+#define JOLT_STATE_ALL          0xf
+
+// Save the state of a physics system into outData (must not be called while the system is updating)
+// state: JOLT_STATE_* flags
+// activeBodiesOnly: if non-zero, only awake bodies and their contacts are saved; restoring such a snapshot
+//                   leaves the bodies that were asleep when it was taken alone
+// Returns the size of the state in bytes. If it is larger than capacity, only capacity bytes were written:
+// retry with a buffer of at least the returned size.
+size_t JoltPhysicsSystemSaveState(JoltPhysicsSystem system, int state, int activeBodiesOnly,
+                                  void* outData, size_t capacity);
+
+// Restore a state saved with JoltPhysicsSystemSaveState (must not be called while the system is updating)
+// The data is only read during the call
+// Returns 1 on success, 0 if the data is truncated or doesn't match the bodies of the system
+int JoltPhysicsSystemRestoreState(JoltPhysicsSystem system, const void* data, size_t size);
+
+// Save the state of a virtual character (position, rotation, velocity, ground and contact state)
+// Returns the size of the state in bytes, like JoltPhysicsSystemSaveState
+size_t JoltCharacterVirtualSaveState(JoltCharacterVirtual character, void* outData, size_t capacity);
+
+// Restore a state saved with JoltCharacterVirtualSaveState
+// Returns 1 on success, 0 if the data is truncated
+int JoltCharacterVirtualRestoreState(JoltCharacterVirtual character, const void* data, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // JOLT_WRAPPER_STATE_H
@@ -0,0 +1,339 @@
+/*
+ * Jolt Physics C Wrapper - Step Statistics and Profiling Implementation
+ */
+
+#include "stats.h"
+#include "physics.h"
+#include <Jolt/Jolt.h>
+#include <Jolt/Core/JobSystem.h>
+#include <Jolt/Core/Profiler.h>
+#include <Jolt/Physics/PhysicsSystem.h>
+#include <Jolt/Physics/Body/Body.h>
+#include <Jolt/Physics/Collision/ContactListener.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+using namespace JPH;
+
+// Collects the per-phase timings and contact counts of one world while stats are enabled
+class StepStats final : public ContactListener
+{
+public:
+	// A job of the step: the function of the wrapped job and the name it is timed under
+	struct TimedJob
+	{
+		StepStats* stats;
+		const char* name;
+		JobSystem::JobFunction function;
+
+		void Run() const
+		{
+			auto start = std::chrono::steady_clock::now();
+			function();
+			std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+			stats->AddJobTime(name, elapsed.count());
+		}
+	};
+
+	explicit StepStats(PhysicsSystem* system) :
+		m_system(system),
+		m_forward(system->GetContactListener()),
+		m_jobs(cMaxPhysicsJobs)
+	{
+		m_system->SetContactListener(this);
+	}
+
+	// Hand the contact callbacks back to the previous listener (e.g. the event recorder)
+	void Detach()
+	{
+		m_system->SetContactListener(m_forward);
+	}
+
+	void BeginStep()
+	{
+		m_num_jobs.store(0, std::memory_order_relaxed);
+		m_num_manifolds = 0;
+		m_pairs.clear();
+		m_phases.clear();
+	}
+
+	void EndStep()
+	{
+		std::sort(m_pairs.begin(), m_pairs.end());
+		m_num_pairs = static_cast<int>(std::unique(m_pairs.begin(), m_pairs.end()) - m_pairs.begin());
+	}
+
+	// Take the context for the next job of the step (null once the step created more than cMaxPhysicsJobs jobs)
+	TimedJob* AllocateJob(const char* name, const JobSystem::JobFunction& function)
+	{
+		size_t index = m_num_jobs.fetch_add(1, std::memory_order_relaxed);
+		if (index >= m_jobs.size())
+		{
+			return nullptr;
+		}
+
+		TimedJob& job = m_jobs[index];
+		job.stats = this;
+		job.name = name;
+		job.function = function;
+		return &job;
+	}
+
+	void AddJobTime(const char* name, double seconds)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		// Job names are string literals, so the pointer almost always identifies the phase
+		auto it = std::find_if(m_phases.begin(), m_phases.end(), [name](const JoltPhaseTiming& p)
+		{
+			return p.name == name || std::strcmp(p.name, name) == 0;
+		});
+		if (it == m_phases.end())
+		{
+			m_phases.push_back({ name, 0.0, 0 });
+			it = m_phases.end() - 1;
+		}
+		it->seconds += seconds;
+		it->numJobs++;
+	}
+
+	void Store(JoltPhysicsStats& out) const
+	{
+		out.numContactManifolds = m_num_manifolds;
+		out.numBodyPairsInContact = m_num_pairs;
+		out.numPhases = static_cast<int>(std::min(m_phases.size(), size_t(JOLT_MAX_STATS_PHASES)));
+		std::copy(m_phases.begin(), m_phases.begin() + out.numPhases, out.phases);
+	}
+
+	// ContactListener
+	virtual ValidateResult OnContactValidate(const Body& inBody1, const Body& inBody2, RVec3Arg inBaseOffset,
+											 const CollideShapeResult& inCollisionResult) override
+	{
+		return m_forward ? m_forward->OnContactValidate(inBody1, inBody2, inBaseOffset, inCollisionResult)
+						 : ValidateResult::AcceptAllContactsForThisBodyPair;
+	}
+
+	virtual void OnContactAdded(const Body& inBody1, const Body& inBody2, const ContactManifold& inManifold,
+								ContactSettings& ioSettings) override
+	{
+		CountManifold(inBody1, inBody2);
+		if (m_forward)
+		{
+			m_forward->OnContactAdded(inBody1, inBody2, inManifold, ioSettings);
+		}
+	}
+
+	virtual void OnContactPersisted(const Body& inBody1, const Body& inBody2, const ContactManifold& inManifold,
+									ContactSettings& ioSettings) override
+	{
+		CountManifold(inBody1, inBody2);
+		if (m_forward)
+		{
+			m_forward->OnContactPersisted(inBody1, inBody2, inManifold, ioSettings);
+		}
+	}
+
+	virtual void OnContactRemoved(const SubShapeIDPair& inSubShapePair) override
+	{
+		if (m_forward)
+		{
+			m_forward->OnContactRemoved(inSubShapePair);
+		}
+	}
+
+private:
+	void CountManifold(const Body& inBody1, const Body& inBody2)
+	{
+		uint32 id1 = inBody1.GetID().GetIndexAndSequenceNumber();
+		uint32 id2 = inBody2.GetID().GetIndexAndSequenceNumber();
+		uint64 key = (uint64(std::min(id1, id2)) << 32) | std::max(id1, id2);
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_num_manifolds++;
+		m_pairs.push_back(key);
+	}
+
+	PhysicsSystem* m_system;
+	ContactListener* m_forward;
+
+	std::mutex m_mutex;                     // Callbacks and jobs run on all worker threads
+	int m_num_manifolds = 0;
+	int m_num_pairs = 0;
+	std::vector<uint64> m_pairs;            // Packed body pair of every manifold of the step
+	std::vector<JoltPhaseTiming> m_phases;  // In order of first appearance
+
+	std::vector<TimedJob> m_jobs;           // Contexts of the jobs of the step, allocated once
+	std::atomic<size_t> m_num_jobs { 0 };
+};
+
+// Job system decorator timing every job of an update by name
+//
+// Jobs are created on the wrapped job system, so they are queued, run and freed there; this class only
+// wraps their functions. The wrapper captures just a pointer to the job's context in StepStats, so it fits
+// the inline storage of JobFunction and creating a job doesn't allocate. Barriers are the wrapped system's as well.
+class TimingJobSystem final : public JobSystem
+{
+public:
+	TimingJobSystem(JobSystem* inner, StepStats& stats) : m_inner(inner), m_stats(stats) {}
+
+	virtual int GetMaxConcurrency() const override { return m_inner->GetMaxConcurrency(); }
+
+	virtual JobHandle CreateJob(const char* inName, ColorArg inColor, const JobFunction& inJobFunction,
+								uint32 inNumDependencies = 0) override
+	{
+		StepStats::TimedJob* job = m_stats.AllocateJob(inName, inJobFunction);
+		if (job == nullptr)
+		{
+			// Out of contexts: run untimed rather than allocating one
+			return m_inner->CreateJob(inName, inColor, inJobFunction, inNumDependencies);
+		}
+
+		return m_inner->CreateJob(inName, inColor, [job]() { job->Run(); }, inNumDependencies);
+	}
+
+	virtual Barrier* CreateBarrier() override { return m_inner->CreateBarrier(); }
+	virtual void DestroyBarrier(Barrier* inBarrier) override { m_inner->DestroyBarrier(inBarrier); }
+	virtual void WaitForJobs(Barrier* inBarrier) override { m_inner->WaitForJobs(inBarrier); }
+
+protected:
+	// Never called: the jobs belong to the wrapped job system
+	virtual void QueueJob(Job*) override { JPH_ASSERT(false); }
+	virtual void QueueJobs(Job**, uint) override { JPH_ASSERT(false); }
+	virtual void FreeJob(Job*) override { JPH_ASSERT(false); }
+
+private:
+	JobSystem* m_inner;
+	StepStats& m_stats;
+};
+
+StatsState::StatsState() = default;
+StatsState::~StatsState() = default;
+
+EPhysicsUpdateError UpdateWithStats(PhysicsSystemWrapper* wrapper, float deltaTime, int collisionSteps)
+{
+	StatsState& state = GetStatsState(wrapper);
+	PhysicsSystem* system = GetPhysicsSystem(wrapper);
+	JobSystem* jobSystem = GetJobSystem(wrapper);
+
+#ifdef JPH_PROFILE_ENABLED
+	bool profile = state.profileNextUpdate && Profiler::sInstance != nullptr;
+	bool threadStarted = false;
+	if (profile)
+	{
+		// Workers are registered at init; also record the thread calling Update, which runs jobs while it waits.
+		// The registration only lasts for this update, so threads that never profile again don't keep a sample buffer.
+		if (ProfileThread::sGetInstance() == nullptr)
+		{
+			JPH_PROFILE_THREAD_START("Update");
+			threadStarted = true;
+		}
+
+		// Drop earlier samples so the dump holds exactly this update
+		Profiler::sInstance->NextFrame();
+	}
+#endif
+
+	// Constructed in place so stepping with stats enabled doesn't allocate a wrapper every update
+	std::optional<TimingJobSystem> timing;
+	if (state.step)
+	{
+		state.step->BeginStep();
+		timing.emplace(jobSystem, *state.step);
+		jobSystem = &*timing;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	EPhysicsUpdateError errors = system->Update(deltaTime, collisionSteps, GetTempAllocator(wrapper), jobSystem);
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	state.stepSeconds = elapsed.count();
+	state.collisionSteps = collisionSteps;
+	state.updateErrors = static_cast<int>(errors);
+	if (state.step)
+	{
+		state.step->EndStep();
+	}
+
+#ifdef JPH_PROFILE_ENABLED
+	if (profile)
+	{
+		// The dump is written by the next NextFrame
+		Profiler::sInstance->Dump(state.profileTag);
+		Profiler::sInstance->NextFrame();
+		state.profileNextUpdate = false;
+
+		if (threadStarted)
+		{
+			JPH_PROFILE_THREAD_END();
+		}
+	}
+#endif
+
+	return errors;
+}
+
+void JoltPhysicsSystemSetStatsEnabled(JoltPhysicsSystem system, int enabled)
+{
+	PhysicsSystemWrapper* wrapper = static_cast<PhysicsSystemWrapper*>(system);
+	StatsState& state = GetStatsState(wrapper);
+
+	if (enabled != 0 && !state.step)
+	{
+		state.step = std::make_unique<StepStats>(GetPhysicsSystem(wrapper));
+	}
+	else if (enabled == 0 && state.step)
+	{
+		state.step->Detach();
+		state.step.reset();
+	}
+}
+
+void JoltPhysicsSystemGetStats(JoltPhysicsSystem system, JoltPhysicsStats* outStats)
+{
+	PhysicsSystemWrapper* wrapper = static_cast<PhysicsSystemWrapper*>(system);
+	const StatsState& state = GetStatsState(wrapper);
+	const PhysicsSystem* ps = GetPhysicsSystem(wrapper);
+
+	JoltPhysicsStats& out = *outStats;
+	out.stepSeconds = state.stepSeconds;
+	out.collisionSteps = state.collisionSteps;
+	out.updateErrors = state.updateErrors;
+
+	out.numBodies = static_cast<int>(ps->GetNumBodies());
+	out.numActiveBodies = static_cast<int>(ps->GetNumActiveBodies(EBodyType::RigidBody));
+	out.maxBodies = static_cast<int>(ps->GetMaxBodies());
+
+	out.numContactManifolds = 0;
+	out.numBodyPairsInContact = 0;
+	out.numPhases = 0;
+	out.maxContactConstraints = state.maxContactConstraints;
+	out.maxBodyPairs = state.maxBodyPairs;
+	if (state.step)
+	{
+		state.step->Store(out);
+	}
+}
+
+int JoltPhysicsSystemProfileNextUpdate(JoltPhysicsSystem system, const char* tag)
+{
+#ifdef JPH_PROFILE_ENABLED
+	if (Profiler::sInstance == nullptr)
+	{
+		return 0;
+	}
+
+	StatsState& state = GetStatsState(static_cast<PhysicsSystemWrapper*>(system));
+	state.profileNextUpdate = true;
+	state.profileTag = tag != nullptr ? tag : "";
+	return 1;
+#else
+	(void)system;
+	(void)tag;
+	return 0;
+#endif
+}
@@ -0,0 +1,102 @@
+/*
+ * Jolt Physics C Wrapper - Step Statistics and Profiling
+ *
+ * Every update records its wall time and error flags. With stats enabled, a
+ * world also times each physics job by name (Jolt's phases: broadphase
+ * update, find collisions, solve velocity constraints, ...) and counts the
+ * contacts of the step, so slow updates and capacity limits can be diagnosed
+ * in production without a profiler build.
+ */
+
+#ifndef JOLT_WRAPPER_STATS_H
+#define JOLT_WRAPPER_STATS_H
+
+#include "physics.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define JOLT_MAX_STATS_PHASES 32
+
+// Time spent in the jobs of one name during the last update (summed over all threads)
+typedef struct {
+    const char* name;       // Jolt's job name (static string)
+    double seconds;
+    int numJobs;
+} JoltPhaseTiming;
+
+// Statistics of the last update
+typedef struct {
+    double stepSeconds;             // Wall time of the last Update call (all collision steps)
+    int collisionSteps;
+    int updateErrors;               // JOLT_UPDATE_ERROR_* flags of the last update
+
+    int numBodies;                  // Bodies in the system (including ones not added to the broadphase)
+    int numActiveBodies;            // Active rigid bodies
+    int maxBodies;
+
+    // Only counted while stats are enabled (0 otherwise)
+    int numContactManifolds;        // Contact manifolds added or persisted, each uses a contact constraint
+    int maxContactConstraints;
+    int numBodyPairsInContact;      // Distinct body pairs with at least one manifold (a lower bound of the body pair cache use)
+    int maxBodyPairs;
+
+    int numPhases;                  // Entries used in phases (0 while stats are disabled)
+    JoltPhaseTiming phases[JOLT_MAX_STATS_PHASES];
+} JoltPhysicsStats;
+
+// Enable or disable per-phase timings and contact counts (update wall time and errors are always recorded)
+// Enabled stats add a little overhead to every update. Call between updates.
+void JoltPhysicsSystemSetStatsEnabled(JoltPhysicsSystem system, int enabled);
+
+// Read the statistics of the last update (call between updates)
+void JoltPhysicsSystemGetStats(JoltPhysicsSystem system, JoltPhysicsStats* outStats);
+
+// Dump Jolt's profiler output for the next update of this system to profile_chart_<tag>.html and
+// profile_list_<tag>.html in the working directory. The profiler is shared, so samples of other worlds
+// updating at the same time end up in the same dump.
+// Returns 1 if the dump was scheduled, 0 if the profiler isn't running (JoltInitSettings.enableProfiler was
+// not set, or the library was built without JPH_PROFILE_ENABLED)
+int JoltPhysicsSystemProfileNextUpdate(JoltPhysicsSystem system, const char* tag);
+
+#ifdef __cplusplus
+}
+
+// C++ only: hooks around PhysicsSystem::Update (see physics.cpp)
+#include <Jolt/Jolt.h>
+#include <Jolt/Core/JobSystem.h>
+#include <Jolt/Physics/PhysicsSystem.h>
+#include <memory>
+#include <string>
+
+class StepStats;
+
+// Per-world statistics state owned by the physics system wrapper
+struct StatsState
+{
+	StatsState();
+	~StatsState();
+
+	double stepSeconds = 0.0;
+	int collisionSteps = 0;
+	int updateErrors = 0;
+
+	// Capacities the system was created with
+	int maxBodyPairs = 0;
+	int maxContactConstraints = 0;
+
+	std::unique_ptr<StepStats> step;      // Set while stats are enabled
+
+	bool profileNextUpdate = false;
+	std::string profileTag;
+};
+
+StatsState& GetStatsState(PhysicsSystemWrapper* wrapper);
+
+// Run one PhysicsSystem::Update, recording its stats (and profile, if requested)
+JPH::EPhysicsUpdateError UpdateWithStats(PhysicsSystemWrapper* wrapper, float deltaTime, int collisionSteps);
+
+#endif
+
+#endif // JOLT_WRAPPER_STATS_H
@@ -9,7 +9,16 @@
 #
 # Usage:
 #   export JOLT_SRC=/path/to/JoltPhysics
-#   ./scripts/build-libs.sh [darwin_arm64|linux_amd64|all]
+#   ./scripts/build-libs.sh [darwin_arm64|linux_amd64|linux_arm64|all] [generic|perf|double|perf_double|all]
+#
+# The second argument selects the library variant (default: all):
+#   generic     - jolt/lib/{platform}/, the default build (profiler and debug renderer compiled in,
+#                 cross-platform deterministic)
+#   perf        - jolt/lib/{platform}_perf/, selected with the jolt_perf build tag: LTO, CPU-tuned,
+#                 no profiler or debug renderer
+#   double      - jolt/lib/{platform}_double/, selected with the jolt_double build tag: generic with
+#                 double-precision positions (JPH_DOUBLE_PRECISION)
+#   perf_double - jolt/lib/{platform}_perf_double/, selected with -tags jolt_perf,jolt_double
 #
 
 set -e
@@ -64,9 +73,35 @@ LIB_DIR="$REPO_ROOT/jolt/lib"
 
 # Determine what to build
 TARGET="${1:-all}"
+VARIANT="${2:-all}"
+
+case "$VARIANT" in
+    generic) VARIANTS=(generic) ;;
+    perf) VARIANTS=(perf) ;;
+    double) VARIANTS=(double) ;;
+    perf_double) VARIANTS=(perf_double) ;;
+    all) VARIANTS=(generic perf double perf_double) ;;
+    *)
+        error "Unknown variant: $VARIANT"
+        echo "Usage: $0 [darwin_arm64|linux_amd64|linux_arm64|all] [generic|perf|double|perf_double|all]"
+        exit 1
+        ;;
+esac
+
+# Output directory name of a platform and variant (e.g. linux_amd64_perf)
+lib_name() {
+    if [ "$2" = "generic" ]; then
+        echo "$1"
+    else
+        echo "$1_$2"
+    fi
+}
 
 build_darwin_arm64() {
-    info "Building darwin/arm64..."
+    local variant="$1"
+    local name
+    name=$(lib_name darwin_arm64 "$variant")
+    info "Building darwin/arm64 ($variant)..."
 
     # Check if we're on macOS ARM64
     if [ "$(uname -s)" != "Darwin" ]; then
@@ -79,7 +114,31 @@ build_darwin_arm64() {
         return
     fi
 
-    BUILD_DIR="$JOLT_SRC/Build/macos_arm64_release"
+    local jolt_options wrapper_flags
+    if [[ "$variant" == perf* ]]; then
+        # Apple M1 and newer
+        local cpu_flags="-mcpu=apple-m1"
+        BUILD_DIR="$JOLT_SRC/Build/macos_arm64_perf"
+        jolt_options=(
+            -DCMAKE_CXX_FLAGS="$cpu_flags"
+            -DINTERPROCEDURAL_OPTIMIZATION=ON
+            -DPROFILER_IN_DEBUG_AND_RELEASE=OFF
+            -DDEBUG_RENDERER_IN_DEBUG_AND_RELEASE=OFF
+        )
+        wrapper_flags=(-O3 -flto $cpu_flags)
+    else
+        # Cross-platform deterministic: no fused multiply-add, identical results on amd64, arm64 and macOS
+        BUILD_DIR="$JOLT_SRC/Build/macos_arm64_release"
+        jolt_options=(-DCROSS_PLATFORM_DETERMINISTIC=ON)
+        wrapper_flags=(-DJPH_PROFILE_ENABLED -DJPH_DEBUG_RENDERER -DJPH_CROSS_PLATFORM_DETERMINISTIC -ffp-contract=off)
+    fi
+
+    if [[ "$variant" == *double ]]; then
+        # Jolt's DOUBLE_PRECISION option defines JPH_DOUBLE_PRECISION for Jolt; the wrapper must match it
+        BUILD_DIR="${BUILD_DIR}_double"
+        jolt_options+=(-DDOUBLE_PRECISION=ON)
+        wrapper_flags+=(-DJPH_DOUBLE_PRECISION)
+    fi
 
     info "  Building Jolt library..."
     mkdir -p "$BUILD_DIR"
@@ -88,6 +147,7 @@ build_darwin_arm64() {
         -DCMAKE_BUILD_TYPE=Release \
         -DCMAKE_OSX_ARCHITECTURES=arm64 \
         -DCMAKE_CXX_COMPILER=clang++ \
+        "${jolt_options[@]}" \
         -DDISABLE_CUSTOM_ALLOCATOR=ON \
         -DTARGET_UNIT_TESTS=OFF \
         -DTARGET_HELLO_WORLD=OFF \
@@ -106,30 +166,45 @@ build_darwin_arm64() {
                 -I"$JOLT_SRC" \
                 -DNDEBUG \
                 -DJPH_DISABLE_CUSTOM_ALLOCATOR \
-                -DJPH_PROFILE_ENABLED \
-                -DJPH_DEBUG_RENDERER \
                 -DJPH_OBJECT_STREAM \
+                "${wrapper_flags[@]}" \
                 -c "$src" \
                 -o "${src%.cpp}.o"
         fi
     done
 
+    info "  Copying to $LIB_DIR/$name..."
+    mkdir -p "$LIB_DIR/$name"
+
+    if [[ "$variant" == perf* ]]; then
+        # Link-time optimize Jolt and the wrapper together here and ship the result as one native
+        # object: users link plain machine code, whatever their compiler version
+        clang++ -r -nostdlib -flto "${wrapper_flags[@]}" \
+            *.o \
+            -Wl,-force_load,"$BUILD_DIR/libJolt.a" \
+            -o jolt_perf.o.tmp
+        rm *.o
+        mv jolt_perf.o.tmp jolt_perf.o
+        rm -f "$LIB_DIR/$name/libJolt.a"
+    else
+        cp "$BUILD_DIR/libJolt.a" "$LIB_DIR/$name/"
+    fi
+
     # Create static library from all object files
     ar rcs libjolt_wrapper.a *.o
     rm *.o
-
-    info "  Copying to $LIB_DIR/darwin_arm64..."
-    mkdir -p "$LIB_DIR/darwin_arm64"
-    cp libjolt_wrapper.a "$LIB_DIR/darwin_arm64/"
-    cp "$BUILD_DIR/libJolt.a" "$LIB_DIR/darwin_arm64/"
+    cp libjolt_wrapper.a "$LIB_DIR/$name/"
     rm libjolt_wrapper.a
 
-    success "darwin/arm64 build complete"
-    ls -lh "$LIB_DIR/darwin_arm64/"
+    success "darwin/arm64 ($variant) build complete"
+    ls -lh "$LIB_DIR/$name/"
 }
 
 build_linux_amd64() {
-    info "Building linux/amd64..."
+    local variant="$1"
+    local name
+    name=$(lib_name linux_amd64 "$variant")
+    info "Building linux/amd64 ($variant)..."
 
     # Check if Docker is available
     if ! command -v docker &> /dev/null; then
@@ -145,7 +220,7 @@ build_linux_amd64() {
         "$SCRIPT_DIR/docker"
 
     info "  Running build in Docker container..."
-    mkdir -p "$LIB_DIR/linux_amd64"
+    mkdir -p "$LIB_DIR/$name"
 
     # Copy wrapper files to a temp directory that we can mount
     TEMP_WRAPPER=$(mktemp -d)
@@ -153,20 +228,24 @@ build_linux_amd64() {
 
     docker run --rm \
         --platform linux/amd64 \
+        -e VARIANT="$variant" \
         -v "$JOLT_SRC:/build/JoltPhysics" \
         -v "$TEMP_WRAPPER:/build/wrapper" \
-        -v "$LIB_DIR/linux_amd64:/build/output" \
+        -v "$LIB_DIR/$name:/build/output" \
         jolt-builder-linux-amd64
 
     # Clean up temp directory
     rm -rf "$TEMP_WRAPPER"
 
-    success "linux/amd64 build complete"
-    ls -lh "$LIB_DIR/linux_amd64/"
+    success "linux/amd64 ($variant) build complete"
+    ls -lh "$LIB_DIR/$name/"
 }
 
 build_linux_arm64() {
-    info "Building linux/arm64..."
+    local variant="$1"
+    local name
+    name=$(lib_name linux_arm64 "$variant")
+    info "Building linux/arm64 ($variant)..."
 
     # Check if Docker is available
     if ! command -v docker &> /dev/null; then
@@ -182,7 +261,7 @@ build_linux_arm64() {
         "$SCRIPT_DIR/docker"
 
     info "  Running build in Docker container..."
-    mkdir -p "$LIB_DIR/linux_arm64"
+    mkdir -p "$LIB_DIR/$name"
 
     # Copy wrapper files to a temp directory that we can mount
     TEMP_WRAPPER=$(mktemp -d)
@@ -190,45 +269,48 @@ build_linux_arm64() {
 
     docker run --rm \
         --platform linux/arm64 \
+        -e VARIANT="$variant" \
         -v "$JOLT_SRC:/build/JoltPhysics" \
         -v "$TEMP_WRAPPER:/build/wrapper" \
-        -v "$LIB_DIR/linux_arm64:/build/output" \
+        -v "$LIB_DIR/$name:/build/output" \
         jolt-builder-linux-arm64
 
     # Clean up temp directory
     rm -rf "$TEMP_WRAPPER"
 
-    success "linux/arm64 build complete"
-    ls -lh "$LIB_DIR/linux_arm64/"
+    success "linux/arm64 ($variant) build complete"
+    ls -lh "$LIB_DIR/$name/"
 }
 
 # Main build logic
-case "$TARGET" in
-    darwin_arm64)
-        build_darwin_arm64
-        ;;
-    linux_amd64)
-        build_linux_amd64
-        ;;
-    linux_arm64)
-        build_linux_arm64
-        ;;
-    all)
-        build_darwin_arm64
-        build_linux_amd64
-        build_linux_arm64
-        ;;
-    *)
-        error "Unknown target: $TARGET"
-        echo "Usage: $0 [darwin_arm64|linux_amd64|linux_arm64|all]"
-        exit 1
-        ;;
-esac
+for variant in "${VARIANTS[@]}"; do
+    case "$TARGET" in
+        darwin_arm64)
+            build_darwin_arm64 "$variant"
+            ;;
+        linux_amd64)
+            build_linux_amd64 "$variant"
+            ;;
+        linux_arm64)
+            build_linux_arm64 "$variant"
+            ;;
+        all)
+            build_darwin_arm64 "$variant"
+            build_linux_amd64 "$variant"
+            build_linux_arm64 "$variant"
+            ;;
+        *)
+            error "Unknown target: $TARGET"
+            echo "Usage: $0 [darwin_arm64|linux_amd64|linux_arm64|all] [generic|perf|double|perf_double|all]"
+            exit 1
+            ;;
+    esac
+done
 
 echo ""
 success "All builds complete! 🎉"
 echo ""
 info "Next steps:"
-echo "  1. Test the binaries: go run example/main.go"
+echo "  1. Check and test the binaries: ./scripts/check-libs.sh && go run example/main.go && go run -tags jolt_perf example/main.go && go run -tags jolt_double example/main.go"
 echo "  2. Commit to repo: git add jolt/lib/ && git commit -m 'Update binaries for Jolt $JOLT_VERSION'"
 echo ""
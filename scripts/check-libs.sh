@@ -0,0 +1,104 @@
+#!/bin/bash
+#
+# Check that the pre-built libraries export every function declared by the wrapper headers
+#
+# A library built from older wrapper sources still links for the functions it has, so a stale
+# jolt/lib/ only shows up as undefined symbols in users' builds. Run this after build-libs.sh and
+# before committing binaries.
+#
+# Usage:
+#   ./scripts/check-libs.sh [darwin_arm64|linux_amd64|linux_arm64|all] [generic|perf|double|perf_double|all]
+#
+# Set NM to override the symbol lister (default: llvm-nm if installed, which reads every platform's
+# objects, otherwise nm).
+#
+
+set -e
+
+RED='\033[0;31m'
+GREEN='\033[0;32m'
+NC='\033[0m' # No Color
+
+success() {
+    echo -e "${GREEN}✅ ${NC}$1"
+}
+
+error() {
+    echo -e "${RED}❌ ${NC}$1"
+}
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+REPO_ROOT="$(cd "$SCRIPT_DIR/.." && pwd)"
+WRAPPER_DIR="$REPO_ROOT/jolt/wrapper"
+LIB_DIR="$REPO_ROOT/jolt/lib"
+
+NM="${NM:-$(command -v llvm-nm || command -v nm)}"
+
+TARGET="${1:-all}"
+VARIANT="${2:-all}"
+
+case "$TARGET" in
+    darwin_arm64|linux_amd64|linux_arm64) TARGETS=("$TARGET") ;;
+    all) TARGETS=(darwin_arm64 linux_amd64 linux_arm64) ;;
+    *)
+        error "Unknown target: $TARGET"
+        echo "Usage: $0 [darwin_arm64|linux_amd64|linux_arm64|all] [generic|perf|double|perf_double|all]"
+        exit 1
+        ;;
+esac
+
+case "$VARIANT" in
+    generic|perf|double|perf_double) VARIANTS=("$VARIANT") ;;
+    all) VARIANTS=(generic perf double perf_double) ;;
+    *)
+        error "Unknown variant: $VARIANT"
+        echo "Usage: $0 [darwin_arm64|linux_amd64|linux_arm64|all] [generic|perf|double|perf_double|all]"
+        exit 1
+        ;;
+esac
+
+# Output directory name of a platform and variant (e.g. linux_amd64_perf), as in build-libs.sh
+lib_name() {
+    if [ "$2" = "generic" ]; then
+        echo "$1"
+    else
+        echo "$1_$2"
+    fi
+}
+
+# C API of the wrapper: every Jolt* function declared at the start of a line in the headers
+DECLARED=$(mktemp)
+DEFINED=$(mktemp)
+trap 'rm -f "$DECLARED" "$DEFINED"' EXIT
+
+grep -ohE '^[A-Za-z][A-Za-z0-9_ *]*\bJolt[A-Za-z0-9_]+\(' "$WRAPPER_DIR"/*.h \
+    | grep -oE 'Jolt[A-Za-z0-9_]+\($' | tr -d '(' | sort -u > "$DECLARED"
+
+failed=0
+for target in "${TARGETS[@]}"; do
+    for variant in "${VARIANTS[@]}"; do
+        name=$(lib_name "$target" "$variant")
+        lib="$LIB_DIR/$name/libjolt_wrapper.a"
+
+        if [ ! -f "$lib" ]; then
+            error "$name: $lib is missing"
+            failed=1
+            continue
+        fi
+
+        # Mach-O symbols carry a leading underscore
+        "$NM" -g --defined-only "$lib" 2>/dev/null | awk '$2 == "T" { print $3 }' | sed 's/^_//' \
+            | sort -u > "$DEFINED"
+
+        missing=$(comm -23 "$DECLARED" "$DEFINED")
+        if [ -n "$missing" ]; then
+            error "$name: $(echo "$missing" | wc -l) functions of the wrapper headers are not in libjolt_wrapper.a (rebuild with ./scripts/build-libs.sh $target $variant):"
+            echo "$missing" | sed 's/^/    /'
+            failed=1
+        else
+            success "$name: exports all $(wc -l < "$DECLARED") wrapper functions"
+        fi
+    done
+done
+
+exit $failed
@@ -1,17 +1,59 @@
 #!/bin/bash
 set -e
 
-echo 'Building Jolt Physics for linux/amd64...'
+# VARIANT selects the configuration:
+#   generic - default libraries (profiler and debug renderer compiled in, cross-platform deterministic)
+#   perf    - jolt_perf libraries: LTO, CPU-tuned, no profiler or debug renderer
+#   double, perf_double - the jolt_double libraries of both: double-precision positions (JPH_DOUBLE_PRECISION)
+VARIANT="${VARIANT:-generic}"
+
+if [[ "$VARIANT" == perf* ]]; then
+    # AVX2/FMA and the instructions Jolt's USE_AVX2 option enables with it (Haswell and newer)
+    CPU_FLAGS="-mavx2 -mbmi -mpopcnt -mlzcnt -mf16c -mfma"
+    BUILD_NAME=linux_amd64_perf
+    JOLT_OPTIONS=(
+        -DCMAKE_CXX_FLAGS="$CPU_FLAGS"
+        -DINTERPROCEDURAL_OPTIMIZATION=ON
+        -DPROFILER_IN_DEBUG_AND_RELEASE=OFF
+        -DDEBUG_RENDERER_IN_DEBUG_AND_RELEASE=OFF
+        -DUSE_SSE4_1=ON
+        -DUSE_SSE4_2=ON
+        -DUSE_AVX=ON
+        -DUSE_AVX2=ON
+        -DUSE_LZCNT=ON
+        -DUSE_TZCNT=ON
+        -DUSE_F16C=ON
+        -DUSE_FMADD=ON
+    )
+    WRAPPER_FLAGS=(-O3 -flto=auto $CPU_FLAGS)
+else
+    BUILD_NAME=linux_amd64_release
+    # Cross-platform deterministic: no fused multiply-add, identical results on amd64, arm64 and macOS
+    JOLT_OPTIONS=(
+        -DCMAKE_CXX_FLAGS="-fno-lto"
+        -DCMAKE_INTERPROCEDURAL_OPTIMIZATION=OFF
+        -DCROSS_PLATFORM_DETERMINISTIC=ON
+    )
+    WRAPPER_FLAGS=(-DJPH_PROFILE_ENABLED -DJPH_DEBUG_RENDERER -DJPH_CROSS_PLATFORM_DETERMINISTIC -ffp-contract=off -fno-lto)
+fi
+
+if [[ "$VARIANT" == *double ]]; then
+    # Jolt's DOUBLE_PRECISION option defines JPH_DOUBLE_PRECISION for Jolt; the wrapper must match it
+    BUILD_NAME=${BUILD_NAME}_double
+    JOLT_OPTIONS+=(-DDOUBLE_PRECISION=ON)
+    WRAPPER_FLAGS+=(-DJPH_DOUBLE_PRECISION)
+fi
+
+echo "Building Jolt Physics for linux/amd64 ($VARIANT)..."
 
 # Build Jolt Physics
-mkdir -p /build/JoltPhysics/Build/linux_amd64_release
-cd /build/JoltPhysics/Build/linux_amd64_release
+mkdir -p /build/JoltPhysics/Build/$BUILD_NAME
+cd /build/JoltPhysics/Build/$BUILD_NAME
 
 cmake .. \
     -DCMAKE_BUILD_TYPE=Release \
     -DCMAKE_CXX_COMPILER=g++ \
-    -DCMAKE_CXX_FLAGS="-fno-lto" \
-    -DCMAKE_INTERPROCEDURAL_OPTIMIZATION=OFF \
+    "${JOLT_OPTIONS[@]}" \
     -DDISABLE_CUSTOM_ALLOCATOR=ON \
     -DTARGET_UNIT_TESTS=OFF \
     -DTARGET_HELLO_WORLD=OFF \
@@ -21,10 +63,11 @@ cmake .. \
 
 cmake --build . -j$(nproc)
 
-echo 'Building Jolt wrapper for linux/amd64...'
+echo "Building Jolt wrapper for linux/amd64 ($VARIANT)..."
 
 # Build wrapper
 cd /build/wrapper
+rm -f *.o
 
 # Compile all wrapper source files (auto-discover .cpp files)
 for src in *.cpp; do
@@ -33,25 +76,32 @@ for src in *.cpp; do
             -I/build/JoltPhysics \
             -DNDEBUG \
             -DJPH_DISABLE_CUSTOM_ALLOCATOR \
-            -DJPH_PROFILE_ENABLED \
-            -DJPH_DEBUG_RENDERER \
             -DJPH_OBJECT_STREAM \
+            "${WRAPPER_FLAGS[@]}" \
             -fPIC \
-            -fno-lto \
             -c "$src" \
             -o "${src%.cpp}.o"
     fi
 done
 
-# Create static library from all object files
-ar rcs libjolt_wrapper.a *.o
-
 echo 'Copying binaries to output...'
-
-# Copy binaries
 mkdir -p /build/output
-cp libjolt_wrapper.a /build/output/
-cp /build/JoltPhysics/Build/linux_amd64_release/libJolt.a /build/output/
 
-echo '✅ Linux amd64 binaries built successfully!'
+if [[ "$VARIANT" == perf* ]]; then
+    # Link-time optimize Jolt and the wrapper together here and ship the result as one native
+    # object: users link plain machine code, whatever their compiler version
+    g++ -r -nostdlib -flto=auto -flinker-output=nolto-rel "${WRAPPER_FLAGS[@]}" \
+        *.o \
+        -Wl,--whole-archive /build/JoltPhysics/Build/$BUILD_NAME/libJolt.a -Wl,--no-whole-archive \
+        -o /tmp/jolt_perf.o
+    rm -f /build/output/libJolt.a
+    ar rcs /build/output/libjolt_wrapper.a /tmp/jolt_perf.o
+else
+    # Create static library from all object files
+    ar rcs libjolt_wrapper.a *.o
+    cp libjolt_wrapper.a /build/output/
+    cp /build/JoltPhysics/Build/$BUILD_NAME/libJolt.a /build/output/
+fi
+
+echo "✅ Linux amd64 ($VARIANT) binaries built successfully!"
 ls -lh /build/output/